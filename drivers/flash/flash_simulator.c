@@ -158,6 +158,10 @@ static uint8_t mock_flash[FLASH_SIMULATOR_FLASH_SIZE];
 #endif
 #endif /* CONFIG_ARCH_POSIX */
 
+#ifdef CONFIG_FLASH_SIMULATOR_ERASE_CYCLES
+static uint32_t erase_cycles[FLASH_SIMULATOR_PAGE_COUNT];
+#endif
+
 static const struct flash_driver_api flash_sim_api;
 
 static const struct flash_parameters flash_sim_parameters = {
@@ -183,6 +187,24 @@ static int flash_range_is_valid(const struct device *dev, off_t offset,
 	return 1;
 }
 
+#ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
+static uint32_t flash_sim_wait(uint32_t min_time_us, uint64_t time_ns)
+{
+	uint32_t time_us = min_time_us + (uint32_t)(time_ns / NSEC_PER_USEC);
+
+#ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING_SLEEP
+	if (!k_is_in_isr() && !k_is_pre_kernel()) {
+		k_sleep(K_USEC(time_us));
+		return time_us;
+	}
+#endif
+
+	k_busy_wait(time_us);
+
+	return time_us;
+}
+#endif /* CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING */
+
 static int flash_sim_read(const struct device *dev, const off_t offset,
 			  void *data,
 			  const size_t len)
@@ -206,9 +228,10 @@ static int flash_sim_read(const struct device *dev, const off_t offset,
 	FLASH_SIM_STATS_INCN(flash_sim_stats, bytes_read, len);
 
 #ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
-	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US);
-	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_read_time_us,
-		   CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US);
+	uint32_t time_us = flash_sim_wait(CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US,
+		(uint64_t)len * CONFIG_FLASH_SIMULATOR_READ_BYTE_TIME_NS);
+
+	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_read_time_us, time_us);
 #endif
 
 	return 0;
@@ -289,9 +312,11 @@ static int flash_sim_write(const struct device *dev, const off_t offset,
 
 #ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
 	/* wait before returning */
-	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US);
-	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_write_time_us,
-		   CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US);
+	uint32_t time_us = flash_sim_wait(CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US,
+		(uint64_t)(len / FLASH_SIMULATOR_PROG_UNIT) *
+		CONFIG_FLASH_SIMULATOR_WRITE_UNIT_TIME_NS);
+
+	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_write_time_us, time_us);
 #endif
 
 	return 0;
@@ -338,14 +363,19 @@ static int flash_sim_erase(const struct device *dev, const off_t offset,
 	/* erase as many units as necessary and increase their erase counter */
 	for (uint32_t i = 0; i < len / FLASH_SIMULATOR_ERASE_UNIT; i++) {
 		ERASE_CYCLES_INC(unit_start + i);
+#ifdef CONFIG_FLASH_SIMULATOR_ERASE_CYCLES
+		erase_cycles[unit_start + i]++;
+#endif
 		unit_erase(unit_start + i);
 	}
 
 #ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
 	/* wait before returning */
-	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US);
-	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_erase_time_us,
-		   CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US);
+	uint32_t time_us = flash_sim_wait(CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US,
+		(uint64_t)(len / FLASH_SIMULATOR_ERASE_UNIT) *
+		CONFIG_FLASH_SIMULATOR_ERASE_UNIT_TIME_US * NSEC_PER_USEC);
+
+	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_erase_time_us, time_us);
 #endif
 
 	return 0;
@@ -492,6 +522,27 @@ void *z_impl_flash_simulator_get_memory(const struct device *dev,
 	return mock_flash;
 }
 
+int z_impl_flash_simulator_get_erase_cycles(const struct device *dev,
+					    off_t offset, uint32_t *cycles)
+{
+#ifdef CONFIG_FLASH_SIMULATOR_ERASE_CYCLES
+	if (!flash_range_is_valid(dev, offset, 1)) {
+		return -EINVAL;
+	}
+
+	*cycles = erase_cycles[(offset - FLASH_SIMULATOR_BASE_OFFSET) /
+			       FLASH_SIMULATOR_ERASE_UNIT];
+
+	return 0;
+#else
+	ARG_UNUSED(dev);
+	ARG_UNUSED(offset);
+	ARG_UNUSED(cycles);
+
+	return -ENOTSUP;
+#endif
+}
+
 #ifdef CONFIG_USERSPACE
 
 #include <zephyr/internal/syscall_handler.h>
@@ -506,4 +557,15 @@ void *z_vrfy_flash_simulator_get_memory(const struct device *dev,
 
 #include <zephyr/syscalls/flash_simulator_get_memory_mrsh.c>
 
+int z_vrfy_flash_simulator_get_erase_cycles(const struct device *dev,
+					    off_t offset, uint32_t *cycles)
+{
+	K_OOPS(K_SYSCALL_SPECIFIC_DRIVER(dev, K_OBJ_DRIVER_FLASH, &flash_sim_api));
+	K_OOPS(K_SYSCALL_MEMORY_WRITE(cycles, sizeof(*cycles)));
+
+	return z_impl_flash_simulator_get_erase_cycles(dev, offset, cycles);
+}
+
+#include <zephyr/syscalls/flash_simulator_get_erase_cycles_mrsh.c>
+
 #endif /* CONFIG_USERSPACE */
@@ -588,6 +588,30 @@ enum bt_conn_auth_keypress {
  */
 int bt_conn_get_info(const struct bt_conn *conn, struct bt_conn_info *info);
 
+/** Connection TX statistics */
+struct bt_conn_tx_stats {
+	/** Number of bytes sent to the controller, including L2CAP headers */
+	uint32_t bytes;
+	/** Number of ACL fragments sent to the controller */
+	uint32_t frags;
+	/** Time elapsed since the connection was established, in milliseconds */
+	uint32_t elapsed_ms;
+	/** Number of fragments queued in the controller and not yet completed */
+	uint16_t in_ll;
+};
+
+/** @brief Get connection TX statistics
+ *
+ *  Requires @kconfig{CONFIG_BT_CONN_TX_STATS} to be enabled.
+ *
+ *  @param conn Connection object.
+ *  @param stats Connection TX statistics object.
+ *
+ *  @return Zero on success or (negative) error code on failure.
+ *  @return -ENOTCONN The connection is not established.
+ */
+int bt_conn_get_tx_stats(const struct bt_conn *conn, struct bt_conn_tx_stats *stats);
+
 /** @brief Get connection info for the remote device.
  *
  *  @param conn Connection object.
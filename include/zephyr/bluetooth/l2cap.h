@@ -221,6 +221,10 @@ struct bt_l2cap_le_chan {
 	atomic_t			_pdu_ready_lock;
 	/** @internal Holds the length of the current PDU/segment */
 	size_t				_pdu_remaining;
+#if defined(CONFIG_BT_CONN_TX_SCHED_DRR)
+	/** @internal Bytes the channel may still send before yielding */
+	int32_t				_tx_deficit;
+#endif /* CONFIG_BT_CONN_TX_SCHED_DRR */
 };
 
 /**
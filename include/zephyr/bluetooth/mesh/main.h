@@ -838,6 +838,41 @@ struct bt_mesh_beacon_cb {
  */
 int bt_mesh_friend_terminate(uint16_t lpn_addr);
 
+/** Friend Queue statistics of a Friendship. */
+struct bt_mesh_friend_stats {
+	/** Number of PDUs currently stored in the Friend Queue. */
+	uint16_t queue_size;
+	/** Highest number of PDUs stored in the Friend Queue. */
+	uint16_t queue_max;
+	/** Number of PDUs added to the Friend Queue. */
+	uint32_t enqueued;
+	/** Number of PDUs sent from the Friend Queue, not counting
+	 *  retransmissions of the last PDU.
+	 */
+	uint32_t sent;
+	/** Number of PDUs discarded to make room in the Friend Queue, or
+	 *  not stored for lack of space.
+	 */
+	uint32_t dropped;
+	/** Number of PDUs replaced by a newer one before being sent, i.e.
+	 *  Friend Updates and Segment Acknowledgments.
+	 */
+	uint32_t superseded;
+};
+
+/** @brief Get the Friend Queue statistics of a Friendship.
+ *
+ *  The statistics are collected from the establishment of the Friendship,
+ *  and are only available if @kconfig{CONFIG_BT_MESH_FRIEND_STATS} is
+ *  enabled.
+ *
+ *  @param lpn_addr Low Power Node address.
+ *  @param stats    Statistics to fill.
+ *
+ *  @return Zero on success or (negative) error code otherwise.
+ */
+int bt_mesh_friend_stats_get(uint16_t lpn_addr, struct bt_mesh_friend_stats *stats);
+
 /** @brief Store pending RPL entry(ies) in the persistent storage.
  *
  * This API allows the user to store pending RPL entry(ies) in the persistent
@@ -111,6 +111,25 @@ int flash_img_check(struct flash_img_context *ctx,
 		    const struct flash_img_check *fic,
 		    uint8_t area_id);
 
+/**
+ * @brief  Verify the integrity of the image written with a context, using
+ * the hash computed as it was written.
+ *
+ * Unlike flash_img_check(), the image is not read back from flash, so this
+ * should be called once the image has been written, after the final call
+ * to flash_img_buffered_write() with flush set to true.
+ *
+ * The function is enabled via CONFIG_IMG_STREAM_IMAGE_CHECK Kconfig option.
+ *
+ * @param[in] ctx context the image has been written with.
+ * @param[in] fic flash img check data, the content length has to be the
+ * number of bytes written.
+ *
+ * @return  0 on success, negative errno code on fail
+ */
+int flash_img_check_written(struct flash_img_context *ctx,
+			    const struct flash_img_check *fic);
+
 #ifdef __cplusplus
 }
 #endif
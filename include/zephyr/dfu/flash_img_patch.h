@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Flash image patch header file
+ *
+ * This header file declares prototypes for writing firmware images from
+ * patches against another image, used for delta DFU.
+ */
+
+#ifndef ZEPHYR_INCLUDE_DFU_FLASH_IMG_PATCH_H_
+#define ZEPHYR_INCLUDE_DFU_FLASH_IMG_PATCH_H_
+
+#include <zephyr/dfu/flash_img.h>
+
+/**
+ * @brief Abstraction layer to write firmware images from patches to flash
+ *
+ * A patch, as created by scripts/dfu/delta_patch.py, starts with a header
+ * holding the sizes and SHA-256 hashes of the base image and of the image
+ * it results in. It is followed by commands, each starting with an opcode
+ * byte: COPY, followed by a 32-bit offset in the base image and a 32-bit
+ * length, copies data from the base image, and INSERT, followed by a 32-bit
+ * length and the data, inserts new data. All values are little endian.
+ *
+ * @defgroup flash_img_patch_api Flash image patch API
+ * @ingroup os_services
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Magic number at the start of a patch, "ZDLT" */
+#define FLASH_IMG_PATCH_MAGIC 0x544c445aU
+
+/** Patch header */
+struct flash_img_patch_header {
+	uint32_t magic;			/**< FLASH_IMG_PATCH_MAGIC */
+	uint32_t source_size;		/**< Size of the base image */
+	uint32_t target_size;		/**< Size of the resulting image */
+	uint32_t reserved;		/**< Must be 0 */
+	uint8_t source_sha[32];		/**< SHA-256 of the base image */
+	uint8_t target_sha[32];		/**< SHA-256 of the resulting image */
+} __packed;
+
+struct flash_img_patch_context {
+	struct flash_img_context img;	/* Writer of the resulting image */
+	const struct flash_area *source; /* Flash area of the base image */
+	uint8_t target_id;		/* Flash area ID of the resulting image */
+	struct flash_img_patch_header hdr; /* Header of the patch */
+	uint8_t cmd[9];			/* Command being received */
+	size_t parsed;			/* Bytes of header or command received */
+	size_t written;			/* Bytes of the resulting image written */
+	uint32_t remaining;		/* Bytes of inserted or copied data left */
+	uint32_t copy_off;		/* Offset of the copy in the base image */
+	uint8_t state;
+	uint8_t copy_buf[CONFIG_IMG_PATCH_COPY_BUF_SIZE];
+};
+
+/**
+ * @brief Check whether data is the start of a patch.
+ *
+ * @param data data received
+ * @param len Number of bytes received
+ *
+ * @return true if @p data starts with the patch magic number
+ */
+bool flash_img_patch_is_patch(const uint8_t *data, size_t len);
+
+/**
+ * @brief Initialize context needed for writing an image from a patch.
+ *
+ * @param ctx       context to be initialized
+ * @param source_id flash area id of partition holding the base image
+ * @param target_id flash area id of partition where the image should be
+ *                  written
+ *
+ * @return  0 on success, negative errno code on fail
+ */
+int flash_img_patch_init(struct flash_img_patch_context *ctx, uint8_t source_id,
+			 uint8_t target_id);
+
+/**
+ * @brief  Process patch data, writing the resulting image to flash.
+ *
+ * The patch can be given in fragments of any size. The base image is checked
+ * against its hash once the header has been received, and a final call with
+ * @p flush set to true writes out the rest of the image and checks it against
+ * its hash.
+ *
+ * At most CONFIG_IMG_PATCH_COPY_MAX_SIZE bytes are copied from the base image
+ * per call, so that a call does not take long whatever the patch holds. The
+ * processing stops there, and the data not processed must be given again with
+ * the next call. With @p flush set, the image is only written out and checked
+ * once all the data has been processed.
+ *
+ * On failure, the context must be initialized again.
+ *
+ * @param ctx context
+ * @param data patch data
+ * @param len Number of bytes of patch data
+ * @param flush when true the patch is complete, the image is written out and
+ * checked
+ *
+ * @return  Number of bytes of @p data processed on success, -EINVAL if the
+ * patch is malformed, -EILSEQ if an image does not match its hash, other
+ * negative errno code on fail
+ */
+int flash_img_patch_write(struct flash_img_patch_context *ctx, const uint8_t *data,
+			  size_t len, bool flush);
+
+/**
+ * @brief Read number of bytes of the resulting image written to the flash.
+ *
+ * @param ctx context
+ *
+ * @return Number of bytes of the image written.
+ */
+size_t flash_img_patch_bytes_written(struct flash_img_patch_context *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif	/* ZEPHYR_INCLUDE_DFU_FLASH_IMG_PATCH_H_ */
@@ -6,6 +6,9 @@
 #ifndef __ZEPHYR_INCLUDE_DRIVERS__FLASH_SIMULATOR_H__
 #define __ZEPHYR_INCLUDE_DRIVERS__FLASH_SIMULATOR_H__
 
+#include <sys/types.h>
+#include <zephyr/device.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -30,6 +33,22 @@ extern "C" {
  */
 __syscall void *flash_simulator_get_memory(const struct device *dev,
 					   size_t *mock_size);
+
+/**
+ * @brief Obtain the number of erase cycles of an erase block
+ *
+ * Requires CONFIG_FLASH_SIMULATOR_ERASE_CYCLES.
+ *
+ * @param[in]  dev flash simulator device pointer.
+ * @param[in]  offset offset within the erase block.
+ * @param[out] cycles number of times the erase block has been erased.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if @p offset is out of the flash.
+ * @retval -ENOTSUP if erase cycles are not counted.
+ */
+__syscall int flash_simulator_get_erase_cycles(const struct device *dev,
+					       off_t offset, uint32_t *cycles);
 #ifdef __cplusplus
 }
 #endif
@@ -33,6 +33,18 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief Non-volatile Storage lookup index entry
+ */
+struct nvs_lookup_index_entry {
+	/** Address of the most recent data of the id */
+	uint32_t addr;
+	/** Id of the entry, 0xFFFF if unused */
+	uint16_t id;
+	/** Length of the most recent data of the id, 0 if it was deleted */
+	uint16_t len;
+};
+
 /**
  * @brief Non-volatile Storage File system structure
  */
@@ -62,6 +74,24 @@ struct nvs_fs {
 #if CONFIG_NVS_LOOKUP_CACHE
 	uint32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
 #endif
+#if CONFIG_NVS_LOOKUP_INDEX
+	/** Lookup index, a hash table of the most recent data of each id */
+	struct nvs_lookup_index_entry lookup_index[CONFIG_NVS_LOOKUP_INDEX_SIZE];
+	/** Number of ids in the lookup index */
+	uint32_t lookup_index_count;
+	/** Flag indicating that the lookup index holds all the ids */
+	bool lookup_index_complete;
+#endif
+#if CONFIG_NVS_INCREMENTAL_GC
+	/** Address of the next ATE to be collected by nvs_gc_step() */
+	uint32_t gc_step_addr;
+	/** Flag indicating that nvs_gc_step() erased the sector to collect */
+	bool gc_step_done;
+#if CONFIG_NVS_INCREMENTAL_GC_WORK
+	/** Work item running nvs_gc_step() in the system workqueue */
+	struct k_work gc_work;
+#endif
+#endif
 };
 
 /**
@@ -164,6 +194,27 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len, ui
  */
 ssize_t nvs_calc_free_space(struct nvs_fs *fs);
 
+/**
+ * @brief Perform a bounded amount of garbage collection.
+ *
+ * Moves the entries of the sector that will be garbage collected next to the
+ * write sector, and erases it once all its entries have been moved. Each
+ * entry examined, and the erase of the sector, count as one step. When this
+ * is done before the write sector gets full, nvs_write() does not need to
+ * garbage collect a whole sector.
+ *
+ * Available with @kconfig{CONFIG_NVS_INCREMENTAL_GC}. The file system needs
+ * at least 4 sectors, with less nothing is done.
+ *
+ * @param fs Pointer to file system
+ * @param max_steps Maximum number of steps to perform
+ * @retval 0 Nothing left to collect until the write sector is closed, or not
+ * enough space left in the write sector to move the next entry.
+ * @retval 1 More steps are needed.
+ * @retval -ERRNO errno code if error
+ */
+int nvs_gc_step(struct nvs_fs *fs, size_t max_steps);
+
 /**
  * @}
  */
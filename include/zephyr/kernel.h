@@ -2894,6 +2894,7 @@ __syscall int k_stack_pop(struct k_stack *stack, stack_data_t *data,
 
 struct k_work;
 struct k_work_q;
+struct k_work_q_thread;
 struct k_work_queue_config;
 extern struct k_work_q k_sys_work_q;
 
@@ -2923,6 +2924,11 @@ struct k_mutex {
 	/** Original thread priority */
 	int owner_orig_prio;
 
+#ifdef CONFIG_USERSPACE
+	/** Whether the owner, taken from a sys_mutex, keeps its priority */
+	bool owner_no_inherit;
+#endif
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mutex)
 
 #ifdef CONFIG_OBJ_CORE_MUTEX
@@ -3108,6 +3114,136 @@ __syscall int k_condvar_wait(struct k_condvar *condvar, struct k_mutex *mutex,
  * @cond INTERNAL_HIDDEN
  */
 
+struct k_rwlock {
+	_wait_q_t read_wait_q;
+	_wait_q_t write_wait_q;
+	struct k_thread *writer;
+	uint32_t readers;
+	int writer_orig_prio;
+};
+
+#define Z_RWLOCK_INITIALIZER(obj)                                              \
+	{                                                                      \
+		.read_wait_q = Z_WAIT_Q_INIT(&obj.read_wait_q),                \
+		.write_wait_q = Z_WAIT_Q_INIT(&obj.write_wait_q),              \
+		.writer = NULL,                                                \
+		.readers = 0,                                                  \
+		.writer_orig_prio = K_LOWEST_APPLICATION_THREAD_PRIO,          \
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @defgroup rwlock_apis Reader-Writer Lock APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Statically define and initialize a reader-writer lock.
+ *
+ * The reader-writer lock can be accessed outside the module where it is
+ * defined using:
+ *
+ * @code extern struct k_rwlock <name>; @endcode
+ *
+ * @param name Name of the reader-writer lock.
+ */
+#define K_RWLOCK_DEFINE(name)                                                  \
+	STRUCT_SECTION_ITERABLE(k_rwlock, name) =                              \
+		Z_RWLOCK_INITIALIZER(name)
+
+/**
+ * @brief Initialize a reader-writer lock.
+ *
+ * Upon completion, the lock is not held by any reader or writer.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @retval 0 Lock object created
+ */
+__syscall int k_rwlock_init(struct k_rwlock *rwlock);
+
+/**
+ * @brief Lock a reader-writer lock for reading.
+ *
+ * Any number of threads may hold the lock for reading at the same time.
+ * The calling thread waits if the lock is held by a writer, or if a writer
+ * is waiting for it, so that writers are not starved by a steady flow of
+ * readers.
+ *
+ * Read locks are not recursive: a thread that already holds the lock must
+ * not lock it again, as it would deadlock with a waiting writer.
+ *
+ * Only a writer holding the lock has its priority raised to the one of the
+ * waiting threads, readers are not tracked individually and are not
+ * subject to priority inheritance.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ * @param timeout Waiting period to lock the reader-writer lock,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Lock held for reading.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_rwlock_read_lock(struct k_rwlock *rwlock, k_timeout_t timeout);
+
+/**
+ * @brief Release a read lock.
+ *
+ * When the last reader releases the lock, it is handed over to the
+ * highest priority waiting writer, if any.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @retval 0 Read lock released.
+ * @retval -EINVAL The lock is not held for reading.
+ */
+__syscall int k_rwlock_read_unlock(struct k_rwlock *rwlock);
+
+/**
+ * @brief Lock a reader-writer lock for writing.
+ *
+ * The calling thread waits until no other thread holds the lock. Write
+ * locks are not recursive.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ * @param timeout Waiting period to lock the reader-writer lock,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Lock held for writing.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EDEADLK The calling thread already holds the write lock.
+ */
+__syscall int k_rwlock_write_lock(struct k_rwlock *rwlock, k_timeout_t timeout);
+
+/**
+ * @brief Release a write lock.
+ *
+ * All threads waiting to read are granted the lock first, then the highest
+ * priority waiting writer if there are no waiting readers. Readers and
+ * writers thus alternate under contention and neither can be starved.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @retval 0 Write lock released.
+ * @retval -EINVAL The lock is not held for writing.
+ * @retval -EPERM The calling thread does not hold the write lock.
+ */
+__syscall int k_rwlock_write_unlock(struct k_rwlock *rwlock);
+
+/**
+ * @}
+ */
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
 struct k_sem {
 	_wait_q_t wait_q;
 	unsigned int count;
@@ -3480,6 +3616,56 @@ void k_work_queue_start(struct k_work_q *queue,
  */
 static inline k_tid_t k_work_queue_thread_get(struct k_work_q *queue);
 
+/** @brief Check whether the caller runs on a thread of a work queue.
+ *
+ * Unlike comparing the current thread with k_work_queue_thread_get(), this
+ * also covers the threads added to the queue with k_work_queue_thread_add(),
+ * and should be used to tell whether the caller is a work item handler of
+ * the queue.
+ *
+ * @param queue pointer to the queue.
+ *
+ * @return true if the current thread processes items of @p queue.
+ */
+bool k_work_queue_is_current(struct k_work_q *queue);
+
+/** @brief Add a thread to a started work queue.
+ *
+ * The added thread processes work items from the same queue as the thread
+ * started by k_work_queue_start(), so items submitted to the queue may be
+ * processed in parallel on SMP systems.  The guarantees of the work API are
+ * preserved: a work item never runs concurrently with itself on threads of
+ * the same queue, and flush, cancel, delayable and drain operations behave
+ * as on a single-threaded queue.  Items are however no longer guaranteed to
+ * complete in submission order.
+ *
+ * The thread inherits the yield and essential properties of the queue.
+ *
+ * @note Requires CONFIG_WORKQUEUE_POOL.
+ *
+ * @param queue pointer to a started queue.
+ *
+ * @param wthread pointer to the structure holding the additional thread.
+ *
+ * @param stack pointer to the thread stack area.
+ *
+ * @param stack_size size of the thread stack area, in bytes.
+ *
+ * @param prio initial thread priority
+ *
+ * @param cpu CPU to pin the thread to, or a negative value to let the thread
+ *        run on any CPU.  Pinning requires CONFIG_SCHED_CPU_MASK.
+ *
+ * @retval 0 if the thread was added to the queue.
+ * @retval -ENODEV if the queue is not started.
+ * @retval -EINVAL if @p cpu is not a valid CPU index.
+ * @retval -ENOTSUP if @p cpu is given but CPU pinning is not supported.
+ */
+int k_work_queue_thread_add(struct k_work_q *queue,
+			    struct k_work_q_thread *wthread,
+			    k_thread_stack_t *stack, size_t stack_size,
+			    int prio, int cpu);
+
 /** @brief Wait until the work queue has drained, optionally plugging it.
  *
  * This blocks submission to the work queue except when coming from queue
@@ -3954,6 +4140,10 @@ struct k_work_delayable {
 struct z_work_flusher {
 	struct k_work work;
 	struct k_sem sem;
+#ifdef CONFIG_WORKQUEUE_POOL
+	/* The work item being flushed. */
+	struct k_work *target;
+#endif
 };
 
 /* Record used to wait for work to complete a cancellation.
@@ -4045,6 +4235,26 @@ struct k_work_q {
 
 	/* Flags describing queue state. */
 	uint32_t flags;
+
+#ifdef CONFIG_WORKQUEUE_POOL
+	/* Additional threads processing items of this queue. */
+	sys_slist_t threads;
+
+	/* Number of items currently being processed. */
+	uint32_t active;
+#endif
+};
+
+/** @brief A structure holding an additional work queue thread.
+ *
+ * See k_work_queue_thread_add().
+ */
+struct k_work_q_thread {
+	/* The thread that animates the work. */
+	struct k_thread thread;
+
+	/* Node in the list of threads of the queue. */
+	sys_snode_t node;
 };
 
 /* Provide the implementation for inline functions declared above */
@@ -5080,6 +5290,14 @@ struct k_mem_slab_info {
 #endif
 };
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+struct k_mem_slab_cpu_cache {
+	struct k_spinlock lock;
+	uint32_t count;
+	void *blocks[CONFIG_MEM_SLAB_CPU_CACHE_SIZE];
+};
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
@@ -5087,6 +5305,11 @@ struct k_mem_slab {
 	char *free_list;
 	struct k_mem_slab_info info;
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	struct k_mem_slab_cpu_cache *cpu_cache;
+	atomic_t cpu_cache_waiters;
+#endif
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mem_slab)
 
 #ifdef CONFIG_OBJ_CORE_MEM_SLAB
@@ -5228,6 +5451,69 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem,
  */
 void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
 
+/**
+ * @brief Allocate several memory blocks from a memory slab.
+ *
+ * This routine allocates up to @a count memory blocks from a memory slab
+ * with a single acquisition of the slab lock. It never waits: fewer blocks
+ * than requested are allocated if the slab runs out of free blocks.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param slab Address of the memory slab.
+ * @param mem Array of at least @a count block addresses, filled with the
+ *        starting addresses of the allocated memory blocks.
+ * @param count Number of memory blocks to allocate.
+ *
+ * @return Number of memory blocks allocated.
+ */
+uint32_t k_mem_slab_alloc_bulk(struct k_mem_slab *slab, void **mem, uint32_t count);
+
+/**
+ * @brief Free several memory blocks allocated from a memory slab.
+ *
+ * This routine releases @a count previously allocated memory blocks back to
+ * their associated memory slab with a single acquisition of the slab lock.
+ * Threads waiting for a free block are served first.
+ *
+ * @param slab Address of the memory slab.
+ * @param mem Array of the memory blocks to free.
+ * @param count Number of memory blocks to free.
+ */
+void k_mem_slab_free_bulk(struct k_mem_slab *slab, void *const *mem, uint32_t count);
+
+#if defined(CONFIG_MEM_SLAB_CPU_CACHE) || defined(__DOXYGEN__)
+/**
+ * @brief Statically define per-CPU block caches for a memory slab.
+ *
+ * @param name Name of the per-CPU caches, to be passed to
+ *        k_mem_slab_cpu_cache_enable().
+ */
+#define K_MEM_SLAB_CPU_CACHE_DEFINE(name) \
+	static struct k_mem_slab_cpu_cache name[CONFIG_MP_MAX_NUM_CPUS]
+
+/**
+ * @brief Enable per-CPU block caches for a memory slab.
+ *
+ * Once enabled, each CPU keeps up to
+ * @kconfig{CONFIG_MEM_SLAB_CPU_CACHE_SIZE} free blocks of the slab for
+ * itself, so that k_mem_slab_alloc() and k_mem_slab_free() only take the
+ * slab lock to refill or flush the cache in batches. Blocks held by another
+ * CPU are reclaimed before an allocation fails or waits.
+ *
+ * Blocks held in the caches are accounted as used by
+ * k_mem_slab_num_used_get() and k_mem_slab_num_free_get().
+ *
+ * @param slab Address of the memory slab.
+ * @param cache Per-CPU caches, defined with K_MEM_SLAB_CPU_CACHE_DEFINE().
+ *
+ * @retval 0 Caches enabled.
+ * @retval -EALREADY Caches were already enabled for the slab.
+ */
+int k_mem_slab_cpu_cache_enable(struct k_mem_slab *slab,
+				struct k_mem_slab_cpu_cache *cache);
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 /**
  * @brief Get the number of used blocks in a memory slab.
  *
@@ -212,8 +212,14 @@ struct img_mgmt_upload_action {
 	int area_id;
 	/** Whether to process the request; false if offset is wrong. */
 	bool proceed;
+	/** Whether the request is ahead of the offset and can be held until it is reached. */
+	bool ahead;
 	/** Whether to erase the destination flash area. */
 	bool erase;
+#ifdef CONFIG_MCUMGR_GRP_IMG_DELTA
+	/** Size of the image resulting from a patch upload, 0 if the upload is not a patch. */
+	size_t patch_target_size;
+#endif
 #ifdef CONFIG_MCUMGR_GRP_IMG_VERBOSE_ERR
 	/** "rsn" string to be sent as explanation for "rc" code */
 	const char *rc_rsn;
@@ -28,6 +28,10 @@ struct img_mgmt_upload_req;
  * function is used to notify the application about a pending firmware upload packet from a client
  * and authorise or deny it. Upload will be allowed so long as all notification handlers return
  * #MGMT_ERR_EOK, if one returns an error then the upload will be denied.
+ *
+ * With CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW, chunks received ahead of the upload offset are
+ * checked when they are received, with img_mgmt_upload_action::ahead set, and are written later,
+ * once the data before them has been received, without being checked again.
  */
 struct img_mgmt_upload_check {
 	/** Action to take */
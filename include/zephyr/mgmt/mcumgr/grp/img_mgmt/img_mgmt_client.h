@@ -94,6 +94,10 @@ struct img_gr_upload {
 	size_t upload_header_size;
 	/** Image slot num */
 	uint32_t image_num;
+	/** Number of upload requests sent without waiting for their response */
+	unsigned int window;
+	/** Upload window size reported by the server, 0 if it is not supported */
+	uint32_t window_size;
 };
 
 /**
@@ -155,6 +159,21 @@ int img_mgmt_client_upload_init(struct img_mgmt_client *client, size_t image_siz
 int img_mgmt_client_upload(struct img_mgmt_client *client, const uint8_t *data, size_t length,
 			   struct mcumgr_image_upload *res_buf);
 
+/**
+ * @brief Set the number of upload requests sent without waiting for their response.
+ *
+ * Requests are only sent ahead when the server reports that it accepts chunks ahead of
+ * the current offset, until then a single request is in flight. The requests in flight
+ * all carry data passed to the same call of img_mgmt_client_upload(), which should
+ * therefore be given large parts of the image.
+ *
+ * @param client	IMG mgmt client object
+ * @param window	Number of requests, from 1 to CONFIG_MCUMGR_GRP_IMG_CLIENT_UPLOAD_WINDOW.
+ * @return 0 on success.
+ * @return MGMT_ERR_EINVAL if the number of requests is out of range.
+ */
+int img_mgmt_client_upload_window_set(struct img_mgmt_client *client, unsigned int window);
+
 /**
  * @brief Write image state.
  *
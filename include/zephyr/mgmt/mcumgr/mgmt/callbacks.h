@@ -177,7 +177,11 @@ enum img_mgmt_group_events {
 	/** Callback when an image has been confirmed. */
 	MGMT_EVT_OP_IMG_MGMT_DFU_CONFIRMED		= MGMT_DEF_EVT_OP_ID(MGMT_EVT_GRP_IMG, 4),
 
-	/** Callback when an image write command has finished writing to flash. */
+	/**
+	 * Callback when an image write command has finished writing to flash. With
+	 * CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW, it is also sent for each chunk held in the upload
+	 * window once it has been written, and not when the chunk is received.
+	 */
 	MGMT_EVT_OP_IMG_MGMT_DFU_CHUNK_WRITE_COMPLETE	= MGMT_DEF_EVT_OP_ID(MGMT_EVT_GRP_IMG, 5),
 
 	/** Used to enable all img_mgmt_group events. */
@@ -25,6 +25,19 @@
 
 #include <stdbool.h>
 #include <zephyr/drivers/flash.h>
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+#include <zephyr/kernel.h>
+#endif
+#if defined(CONFIG_STREAM_FLASH_HASH_PSA)
+#include <psa/crypto.h>
+#elif defined(CONFIG_STREAM_FLASH_HASH_MBEDTLS)
+#include <mbedtls/sha256.h>
+#endif
+
+#ifdef CONFIG_STREAM_FLASH_HASH
+/** Length of the hash of the written data */
+#define STREAM_FLASH_HASH_LEN 32
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -47,6 +60,25 @@ extern "C" {
  */
 typedef int (*stream_flash_callback_t)(uint8_t *buf, size_t len, size_t offset);
 
+struct stream_flash_ctx;
+
+/**
+ * @typedef stream_flash_progress_callback_t
+ *
+ * @brief Signature for callback invoked after a buffer of an asynchronous
+ * stream has been written.
+ *
+ * @details Functions of this type are invoked from the stream flash work
+ * queue. Once a write has failed, the following buffers are not written
+ * and the callback is not invoked anymore.
+ *
+ * @param ctx context
+ * @param bytes_written Number of bytes written to flash
+ * @param rc 0 on success, negative errno code of the failed write otherwise
+ */
+typedef void (*stream_flash_progress_callback_t)(struct stream_flash_ctx *ctx,
+						 size_t bytes_written, int rc);
+
 /**
  * @brief Structure for stream flash context
  *
@@ -67,6 +99,29 @@ struct stream_flash_ctx {
 #endif
 	uint8_t erase_value;
 	uint8_t write_block_size;	/* Offset/size device write alignment */
+#if defined(CONFIG_STREAM_FLASH_HASH_PSA)
+	psa_hash_operation_t hash; /* SHA-256 of the data written to flash */
+#elif defined(CONFIG_STREAM_FLASH_HASH_MBEDTLS)
+	mbedtls_sha256_context hash; /* SHA-256 of the data written to flash */
+#endif
+#ifdef CONFIG_STREAM_FLASH_HASH
+	void *hash_owner; /* Set to the context itself while the hash is started */
+#endif
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	struct {
+		uint8_t *bufs; /* Write buffers, buf points to the one filled */
+		size_t buf_cnt; /* Number of write buffers, 0 if synchronous */
+		size_t lens[CONFIG_STREAM_FLASH_ASYNC_BUF_COUNT]; /* Bytes to write */
+		size_t fill; /* Index of the buffer being filled */
+		size_t next; /* Index of the next buffer to write */
+		size_t bytes_queued; /* Number of bytes queued for write */
+		atomic_t pending; /* Number of buffers queued for write */
+		struct k_sem free; /* Buffers available for filling */
+		struct k_work work; /* Writes the queued buffers */
+		stream_flash_progress_callback_t progress; /* Invoked after writes */
+		int rc; /* Error of the first failed write */
+	} async;
+#endif
 };
 
 /**
@@ -83,11 +138,54 @@ struct stream_flash_ctx {
  *             of the flash device minus the offset.
  * @param cb Callback to be invoked on completed flash write operations.
  *
+ * With CONFIG_STREAM_FLASH_HASH, the hash of a context initialized before
+ * is released when it is initialized again.
+ *
  * @return non-negative on success, negative errno code on fail
  */
 int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 		      uint8_t *buf, size_t buf_len, size_t offset, size_t size,
 		      stream_flash_callback_t cb);
+/**
+ * @brief Initialize context needed for asynchronous stream writes to flash.
+ *
+ * The context is initialized as by @ref stream_flash_init, with @p buf_cnt
+ * write buffers of @p buf_len bytes each. When a buffer is full, it is
+ * written to flash by the stream flash work queue while
+ * @ref stream_flash_buffered_write fills the next one, and only waits when
+ * all the buffers are queued for write. A flush waits for all the buffers
+ * to be written.
+ *
+ * The @p cb callback is invoked from the stream flash work queue, with the
+ * buffer that has been written.
+ *
+ * A context still used by an asynchronous stream can be initialized again.
+ * The buffers queued for that stream are then dropped, and the call waits
+ * for the buffer being written.
+ *
+ * @param ctx context to be initialized
+ * @param fdev Flash device to operate on
+ * @param buf Write buffers, of @p buf_len times @p buf_cnt bytes
+ * @param buf_len Length of each write buffer. Can not be larger than the
+ *                page size. Must be multiple of the flash device
+ *                write-block-size.
+ * @param buf_cnt Number of write buffers, from 2 to
+ *                CONFIG_STREAM_FLASH_ASYNC_BUF_COUNT
+ * @param offset Offset within flash device to start writing to
+ * @param size Number of bytes available for performing buffered write.
+ *             If this is '0', the size will be set to the total size
+ *             of the flash device minus the offset.
+ * @param cb Callback to be invoked on completed flash write operations.
+ * @param progress_cb Callback to be invoked after each buffer is written,
+ *                    can be NULL.
+ *
+ * @return non-negative on success, negative errno code on fail
+ */
+int stream_flash_init_async(struct stream_flash_ctx *ctx, const struct device *fdev,
+			    uint8_t *buf, size_t buf_len, size_t buf_cnt, size_t offset,
+			    size_t size, stream_flash_callback_t cb,
+			    stream_flash_progress_callback_t progress_cb);
+
 /**
  * @brief Read number of bytes written to the flash.
  *
@@ -99,6 +197,23 @@ int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
  */
 size_t stream_flash_bytes_written(struct stream_flash_ctx *ctx);
 
+/**
+ * @brief Get the SHA-256 hash of the data written to flash.
+ *
+ * The hash is computed as the data is written, without reading it back
+ * from flash, and covers the @ref stream_flash_bytes_written bytes written
+ * so far; data still held in the write buffer is not included until it is
+ * flushed. The stream can be written further after this call.
+ *
+ * The function is enabled via CONFIG_STREAM_FLASH_HASH Kconfig option.
+ *
+ * @param ctx context
+ * @param hash Buffer of STREAM_FLASH_HASH_LEN bytes receiving the hash
+ *
+ * @return non-negative on success, negative errno code on fail
+ */
+int stream_flash_hash_get(struct stream_flash_ctx *ctx, uint8_t *hash);
+
 /**
  * @brief Process input buffers to be written to flash device in single blocks.
  * Will store remainder between calls.
@@ -113,6 +228,11 @@ size_t stream_flash_bytes_written(struct stream_flash_ctx *ctx);
  * Once context has been flushed, it can be re-initialized and re-used for new
  * stream flash session.
  *
+ * For a context initialized with @ref stream_flash_init_async, a failure to
+ * write a buffer is returned by the following calls, and a flush waits for
+ * all the buffers to be written. Calls returning such a failure wait for the
+ * work queue to be done with the stream.
+ *
  * @param ctx context
  * @param data data to write
  * @param len Number of bytes to write
@@ -145,6 +265,9 @@ int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off);
  * load previous stream write progress before writing any data. If the loaded
  * progress has fewer bytes written than @p ctx then it will be ignored.
  *
+ * With CONFIG_STREAM_FLASH_HASH, the data written before is read back into
+ * the write buffer to hash it again, as the hash state is not saved.
+ *
  * @param ctx context
  * @param settings_key key to use with the settings module for loading
  *                     the stream write progress
@@ -157,6 +280,7 @@ int stream_flash_progress_load(struct stream_flash_ctx *ctx,
 /**
  * @brief Save persistent stream write progress using key @p settings_key .
  *
+ *
  * @param ctx context
  * @param settings_key key to use with the settings module for storing
  *                     the stream write progress
@@ -11,9 +11,9 @@
  * sys_mutex behaves almost exactly like k_mutex, with the added advantage
  * that a sys_mutex instance can reside in user memory.
  *
- * Further enhancements will support locking/unlocking uncontended sys_mutexes
- * with simple atomic ops instead of syscalls, similar to Linux's
- * FUTEX_LOCK_PI and FUTEX_UNLOCK_PI
+ * With CONFIG_SYS_MUTEX_FAST_PATH, uncontended sys_mutexes are locked/unlocked
+ * from user mode with simple atomic ops instead of syscalls, similar to
+ * Linux's FUTEX_LOCK_PI and FUTEX_UNLOCK_PI
  */
 
 #ifdef __cplusplus
@@ -24,15 +24,24 @@ extern "C" {
 #include <zephyr/sys/atomic.h>
 #include <zephyr/types.h>
 #include <zephyr/sys_clock.h>
+#include <zephyr/kernel.h>
 
 struct sys_mutex {
-	/* Currently unused, but will be used to store state for fast mutexes
-	 * that can be locked/unlocked with atomic ops if there is no
-	 * contention
+	/* Lock state: 0 if unlocked, otherwise the owner thread. Set with
+	 * atomic ops from user mode while there is no contention, or with
+	 * Z_SYS_MUTEX_KERNEL or'ed in while the kernel mutex is in charge.
 	 */
 	atomic_t val;
 };
 
+/* Set in the state word while the mutex is managed by the kernel, which
+ * makes the atomic fast paths fail and fall back to the syscalls. The
+ * kernel itself relies on the state of the kernel mutex instead.
+ */
+#define Z_SYS_MUTEX_KERNEL BIT(0)
+
+#define Z_SYS_MUTEX_FLAGS Z_SYS_MUTEX_KERNEL
+
 /**
  * @defgroup user_mutex_apis User mode mutex APIs
  * @ingroup kernel_apis
@@ -89,6 +98,10 @@ __syscall int z_sys_mutex_kernel_unlock(struct sys_mutex *mutex);
  * A thread is permitted to lock a mutex it has already locked. The operation
  * completes immediately and the lock count is increased by 1.
  *
+ * With CONFIG_SYS_MUTEX_FAST_PATH, a user thread waiting for the mutex
+ * only raises the priority of the owner if it has permission on the owner
+ * thread object.
+ *
  * @param mutex Address of the mutex, which may reside in user memory
  * @param timeout Waiting period to lock the mutex,
  *                or one of the special values K_NO_WAIT and K_FOREVER.
@@ -101,7 +114,12 @@ __syscall int z_sys_mutex_kernel_unlock(struct sys_mutex *mutex);
  */
 static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 {
-	/* For now, make the syscall unconditionally */
+	/* Supervisor threads call the implementation directly anyway */
+	if (IS_ENABLED(CONFIG_SYS_MUTEX_FAST_PATH) && k_is_user_context() &&
+	    atomic_cas(&mutex->val, 0, (atomic_val_t)k_current_get())) {
+		return 0;
+	}
+
 	return z_sys_mutex_kernel_lock(mutex, timeout);
 }
 
@@ -124,7 +142,11 @@ static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
  */
 static inline int sys_mutex_unlock(struct sys_mutex *mutex)
 {
-	/* For now, make the syscall unconditionally */
+	if (IS_ENABLED(CONFIG_SYS_MUTEX_FAST_PATH) && k_is_user_context() &&
+	    atomic_cas(&mutex->val, (atomic_val_t)k_current_get(), 0)) {
+		return 0;
+	}
+
 	return z_sys_mutex_kernel_unlock(mutex);
 }
 
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_RCU_H_
+#define ZEPHYR_INCLUDE_SYS_RCU_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup sys_rcu_apis Read-mostly data synchronization APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Read-mostly data synchronization object.
+ *
+ * Protects data that is read far more often than it is updated, for
+ * example a table looked up for every packet, in the spirit of RCU. Readers
+ * never block nor wait for writers: they only increment and decrement a
+ * counter. Writers publish a new version of the data with
+ * sys_rcu_assign_pointer(), then call sys_rcu_synchronize() to wait for the
+ * readers that may still use the previous version before freeing or reusing
+ * it. Writers must be serialized with each other, for example with a mutex.
+ *
+ * Readers are tracked in one of two counters, selected by the current
+ * epoch. sys_rcu_synchronize() switches to the other epoch and waits for
+ * the counter of the previous one to drop to zero.
+ */
+struct sys_rcu {
+	atomic_t epoch;
+	atomic_t readers[2];
+};
+
+/**
+ * @brief Statically define and initialize a read-mostly synchronization
+ * object.
+ *
+ * @param name Name of the object.
+ */
+#define SYS_RCU_DEFINE(name) \
+	struct sys_rcu name = { 0 }
+
+/**
+ * @brief Enter a read-side critical section.
+ *
+ * May be called from any context, including ISRs. Read-side critical
+ * sections may be nested, and may block, although blocking delays writers.
+ *
+ * @param rcu Address of the synchronization object.
+ *
+ * @return Token to be passed to sys_rcu_read_unlock().
+ */
+static inline int sys_rcu_read_lock(struct sys_rcu *rcu)
+{
+	int idx;
+
+	do {
+		idx = atomic_get(&rcu->epoch) & 1;
+		(void)atomic_inc(&rcu->readers[idx]);
+
+		/* A writer may have switched epoch and checked the counter
+		 * in between, retry so that it is not missed.
+		 */
+		if ((atomic_get(&rcu->epoch) & 1) == idx) {
+			break;
+		}
+
+		(void)atomic_dec(&rcu->readers[idx]);
+	} while (true);
+
+	return idx;
+}
+
+/**
+ * @brief Leave a read-side critical section.
+ *
+ * @param rcu Address of the synchronization object.
+ * @param idx Token returned by the matching sys_rcu_read_lock().
+ */
+static inline void sys_rcu_read_unlock(struct sys_rcu *rcu, int idx)
+{
+	(void)atomic_dec(&rcu->readers[idx]);
+}
+
+/**
+ * @brief Load a pointer protected by a read-mostly synchronization object.
+ *
+ * Must be called within a read-side critical section, the pointed data
+ * remains valid until sys_rcu_read_unlock() is called.
+ *
+ * @param ptr Address of the protected pointer.
+ *
+ * @return Value of the pointer.
+ */
+static inline void *sys_rcu_dereference(const atomic_ptr_t *ptr)
+{
+	return atomic_ptr_get(ptr);
+}
+
+/**
+ * @brief Publish a new value of a pointer protected by a read-mostly
+ * synchronization object.
+ *
+ * The data pointed to must be fully initialized beforehand. Readers see
+ * either the old or the new value.
+ *
+ * @param ptr Address of the protected pointer.
+ * @param val New value of the pointer.
+ *
+ * @return Previous value of the pointer, which may only be released after
+ *         sys_rcu_synchronize() returns.
+ */
+static inline void *sys_rcu_assign_pointer(atomic_ptr_t *ptr, void *val)
+{
+	return atomic_ptr_set(ptr, val);
+}
+
+/**
+ * @brief Wait for all pre-existing readers.
+ *
+ * Returns once all read-side critical sections entered before the call
+ * have been left. Must not be called from an ISR nor from a read-side
+ * critical section of the same object.
+ *
+ * @param rcu Address of the synchronization object.
+ */
+static inline void sys_rcu_synchronize(struct sys_rcu *rcu)
+{
+	int idx = atomic_get(&rcu->epoch) & 1;
+
+	(void)atomic_inc(&rcu->epoch);
+
+	while (atomic_get(&rcu->readers[idx]) != 0) {
+		k_sleep(K_TICKS(1));
+	}
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_RCU_H_ */
@@ -180,6 +180,13 @@ void z_mem_domain_exit_thread(struct k_thread *thread);
  * not recommended.
  */
 extern struct k_spinlock z_mem_domain_lock;
+
+/* sys_mutex slow paths, operating on the kernel mutex backing a sys_mutex
+ * and keeping its user mode state word in sync.
+ */
+int z_sys_mutex_lock_contended(struct k_mutex *mutex, atomic_t *state,
+			       k_timeout_t timeout);
+int z_sys_mutex_unlock_contended(struct k_mutex *mutex, atomic_t *state);
 #endif /* CONFIG_USERSPACE */
 
 #ifdef CONFIG_GDBSTUB
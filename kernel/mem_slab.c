@@ -179,6 +179,11 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->info.num_used = 0U;
 	slab->lock = (struct k_spinlock) {};
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	slab->cpu_cache = NULL;
+	atomic_set(&slab->cpu_cache_waiters, 0);
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	slab->info.max_used = 0U;
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
@@ -216,28 +221,286 @@ static bool slab_ptr_is_good(struct k_mem_slab *slab, const void *ptr)
 }
 #endif
 
-int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+/* Take up to @a count blocks from the free list, slab lock held */
+static uint32_t slab_take_locked(struct k_mem_slab *slab, void **mem, uint32_t count)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
-	int result;
-
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
+	uint32_t n = 0U;
 
-	if (slab->free_list != NULL) {
-		/* take a free block */
-		*mem = slab->free_list;
+	while ((n < count) && (slab->free_list != NULL)) {
+		mem[n++] = slab->free_list;
 		slab->free_list = *(char **)(slab->free_list);
-		slab->info.num_used++;
-		__ASSERT((slab->free_list == NULL &&
-			  slab->info.num_used == slab->info.num_blocks) ||
-			 slab_ptr_is_good(slab, slab->free_list),
-			 "slab corruption detected");
+	}
+
+	slab->info.num_used += n;
+	__ASSERT((slab->free_list == NULL &&
+		  slab->info.num_used == slab->info.num_blocks) ||
+		 slab_ptr_is_good(slab, slab->free_list),
+		 "slab corruption detected");
 
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
-		slab->info.max_used = MAX(slab->info.num_used,
-					  slab->info.max_used);
+	slab->info.max_used = MAX(slab->info.num_used,
+				  slab->info.max_used);
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
 
+	return n;
+}
+
+/* Give blocks back, handing them over to waiting threads first, slab lock
+ * held. Returns true if a thread was woken up.
+ */
+static bool slab_give_locked(struct k_mem_slab *slab, void *const *mem, uint32_t count)
+{
+	bool resched = false;
+
+	for (uint32_t i = 0U; i < count; i++) {
+		__ASSERT(slab_ptr_is_good(slab, mem[i]), "Invalid memory pointer provided");
+
+		if ((slab->free_list == NULL) && IS_ENABLED(CONFIG_MULTITHREADING)) {
+			struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
+
+			if (pending_thread != NULL) {
+				z_thread_return_value_set_with_data(pending_thread, 0, mem[i]);
+				z_ready_thread(pending_thread);
+				resched = true;
+				continue;
+			}
+		}
+
+		*(char **) mem[i] = slab->free_list;
+		slab->free_list = (char *) mem[i];
+		slab->info.num_used--;
+	}
+
+	return resched;
+}
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+
+/* Number of blocks moved between a cache and the slab at once */
+#define CPU_CACHE_BATCH (CONFIG_MEM_SLAB_CPU_CACHE_SIZE / 2)
+
+/*
+ * The cache of a CPU is only filled by that CPU, with interrupts locked and
+ * the slab lock held, but may be drained by any CPU reclaiming blocks. Its
+ * lock is always taken after the slab lock, never before.
+ */
+
+static bool cpu_cache_alloc(struct k_mem_slab *slab, void **mem)
+{
+	struct k_mem_slab_cpu_cache *cache;
+	void *blocks[CPU_CACHE_BATCH];
+	k_spinlock_key_t ckey, key;
+	unsigned int irq_key;
+	uint32_t n;
+
+	if (slab->cpu_cache == NULL) {
+		return false;
+	}
+
+	irq_key = arch_irq_lock();
+	cache = &slab->cpu_cache[_current_cpu->id];
+
+	ckey = k_spin_lock(&cache->lock);
+	if (cache->count > 0U) {
+		*mem = cache->blocks[--cache->count];
+		k_spin_unlock(&cache->lock, ckey);
+		arch_irq_unlock(irq_key);
+
+		return true;
+	}
+	k_spin_unlock(&cache->lock, ckey);
+
+	/* The cache is filled with the slab lock held, so that a thread
+	 * about to wait for a block, which drains the caches with that lock
+	 * held, either sees the blocks taken or finds them in the cache.
+	 * Only the block allocated is taken while there are such threads.
+	 */
+	key = k_spin_lock(&slab->lock);
+	n = slab_take_locked(slab, blocks,
+			     (atomic_get(&slab->cpu_cache_waiters) != 0) ? 1U : ARRAY_SIZE(blocks));
+	if (n == 0U) {
+		k_spin_unlock(&slab->lock, key);
+		arch_irq_unlock(irq_key);
+
+		return false;
+	}
+
+	*mem = blocks[--n];
+
+	/* Other CPUs may only have drained the cache meanwhile */
+	ckey = k_spin_lock(&cache->lock);
+	for (uint32_t i = 0U; i < n; i++) {
+		cache->blocks[cache->count++] = blocks[i];
+	}
+	k_spin_unlock(&cache->lock, ckey);
+	k_spin_unlock(&slab->lock, key);
+	arch_irq_unlock(irq_key);
+
+	return true;
+}
+
+static bool cpu_cache_free(struct k_mem_slab *slab, void *mem)
+{
+	struct k_mem_slab_cpu_cache *cache;
+	void *blocks[CPU_CACHE_BATCH];
+	k_spinlock_key_t ckey;
+	unsigned int irq_key;
+	uint32_t n = 0U;
+
+	if (slab->cpu_cache == NULL) {
+		return false;
+	}
+
+	__ASSERT(slab_ptr_is_good(slab, mem), "Invalid memory pointer provided");
+
+	irq_key = arch_irq_lock();
+	cache = &slab->cpu_cache[_current_cpu->id];
+
+	ckey = k_spin_lock(&cache->lock);
+
+	/* Threads waiting for a block take precedence. A thread about to
+	 * wait increments the counter before draining the caches, so the
+	 * block is either seen by the drain or given to the slab.
+	 */
+	if (atomic_get(&slab->cpu_cache_waiters) != 0) {
+		k_spin_unlock(&cache->lock, ckey);
+		arch_irq_unlock(irq_key);
+
+		return false;
+	}
+
+	if (cache->count == ARRAY_SIZE(cache->blocks)) {
+		n = ARRAY_SIZE(blocks);
+		cache->count -= n;
+		memcpy(blocks, &cache->blocks[cache->count], sizeof(blocks));
+	}
+
+	cache->blocks[cache->count++] = mem;
+
+	k_spin_unlock(&cache->lock, ckey);
+	arch_irq_unlock(irq_key);
+
+	if (n > 0U) {
+		k_mem_slab_free_bulk(slab, blocks, n);
+	}
+
+	return true;
+}
+
+/* Move the blocks held by all CPUs back to the free list, slab lock held */
+static void cpu_cache_drain_locked(struct k_mem_slab *slab)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (unsigned int i = 0U; i < num_cpus; i++) {
+		struct k_mem_slab_cpu_cache *cache = &slab->cpu_cache[i];
+		k_spinlock_key_t ckey = k_spin_lock(&cache->lock);
+
+		while (cache->count > 0U) {
+			char *block = cache->blocks[--cache->count];
+
+			*(char **)block = slab->free_list;
+			slab->free_list = block;
+			slab->info.num_used--;
+		}
+
+		k_spin_unlock(&cache->lock, ckey);
+	}
+}
+
+/* Reclaim cached blocks when the free list is empty, slab lock held. Returns
+ * true if the caller was registered as a waiter, which it must undo.
+ */
+static bool cpu_cache_reclaim_locked(struct k_mem_slab *slab, k_timeout_t timeout)
+{
+	bool waiter;
+
+	if ((slab->cpu_cache == NULL) || (slab->free_list != NULL)) {
+		return false;
+	}
+
+	waiter = !K_TIMEOUT_EQ(timeout, K_NO_WAIT) && IS_ENABLED(CONFIG_MULTITHREADING);
+	if (waiter) {
+		(void)atomic_inc(&slab->cpu_cache_waiters);
+	}
+
+	cpu_cache_drain_locked(slab);
+
+	return waiter;
+}
+
+int k_mem_slab_cpu_cache_enable(struct k_mem_slab *slab,
+				struct k_mem_slab_cpu_cache *cache)
+{
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+
+	if (slab->cpu_cache != NULL) {
+		k_spin_unlock(&slab->lock, key);
+
+		return -EALREADY;
+	}
+
+	for (unsigned int i = 0U; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		cache[i].lock = (struct k_spinlock) {};
+		cache[i].count = 0U;
+	}
+
+	slab->cpu_cache = cache;
+
+	k_spin_unlock(&slab->lock, key);
+
+	return 0;
+}
+
+#else
+
+static inline bool cpu_cache_alloc(struct k_mem_slab *slab, void **mem)
+{
+	return false;
+}
+
+static inline bool cpu_cache_free(struct k_mem_slab *slab, void *mem)
+{
+	return false;
+}
+
+static inline bool cpu_cache_reclaim_locked(struct k_mem_slab *slab, k_timeout_t timeout)
+{
+	return false;
+}
+
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
+static inline void cpu_cache_waiter_done(struct k_mem_slab *slab, bool waiter)
+{
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (waiter) {
+		(void)atomic_dec(&slab->cpu_cache_waiters);
+	}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+}
+
+int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	bool waiter;
+	int result;
+
+	if (cpu_cache_alloc(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+
+		return 0;
+	}
+
+	key = k_spin_lock(&slab->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
+
+	waiter = cpu_cache_reclaim_locked(slab, timeout);
+
+	if (slab_take_locked(slab, mem, 1U) == 1U) {
+		/* took a free block */
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) ||
 		   !IS_ENABLED(CONFIG_MULTITHREADING)) {
@@ -253,11 +516,15 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 			*mem = _current->base.swap_data;
 		}
 
+		cpu_cache_waiter_done(slab, waiter);
+
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, result);
 
 		return result;
 	}
 
+	cpu_cache_waiter_done(slab, waiter);
+
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, result);
 
 	k_spin_unlock(&slab->lock, key);
@@ -267,30 +534,56 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 
 void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	k_spinlock_key_t key;
+	bool resched;
 
-	__ASSERT(slab_ptr_is_good(slab, mem), "Invalid memory pointer provided");
+	if (cpu_cache_free(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+
+		return;
+	}
+
+	key = k_spin_lock(&slab->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
-	if ((slab->free_list == NULL) && IS_ENABLED(CONFIG_MULTITHREADING)) {
-		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
 
-		if (pending_thread != NULL) {
-			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+	resched = slab_give_locked(slab, &mem, 1U);
 
-			z_thread_return_value_set_with_data(pending_thread, 0, mem);
-			z_ready_thread(pending_thread);
-			z_reschedule(&slab->lock, key);
-			return;
-		}
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+
+	if (resched) {
+		z_reschedule(&slab->lock, key);
+	} else {
+		k_spin_unlock(&slab->lock, key);
 	}
-	*(char **) mem = slab->free_list;
-	slab->free_list = (char *) mem;
-	slab->info.num_used--;
+}
 
-	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+uint32_t k_mem_slab_alloc_bulk(struct k_mem_slab *slab, void **mem, uint32_t count)
+{
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	uint32_t n;
+
+	n = slab_take_locked(slab, mem, count);
+	if (n < count) {
+		(void)cpu_cache_reclaim_locked(slab, K_NO_WAIT);
+		n += slab_take_locked(slab, &mem[n], count - n);
+	}
 
 	k_spin_unlock(&slab->lock, key);
+
+	return n;
+}
+
+void k_mem_slab_free_bulk(struct k_mem_slab *slab, void *const *mem, uint32_t count)
+{
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+
+	if (slab_give_locked(slab, mem, count)) {
+		z_reschedule(&slab->lock, key);
+	} else {
+		k_spin_unlock(&slab->lock, key);
+	}
 }
 
 int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stats *stats)
@@ -37,6 +37,7 @@
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/tracing/tracing.h>
 #include <zephyr/sys/check.h>
+#include <zephyr/sys/mutex.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/llext/symbol.h>
 LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
@@ -56,6 +57,9 @@ int z_impl_k_mutex_init(struct k_mutex *mutex)
 {
 	mutex->owner = NULL;
 	mutex->lock_count = 0U;
+#ifdef CONFIG_USERSPACE
+	mutex->owner_no_inherit = false;
+#endif /* CONFIG_USERSPACE */
 
 	z_waitq_init(&mutex->wait_q);
 
@@ -102,23 +106,18 @@ static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
 	return false;
 }
 
-int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
+static bool mutex_take_locked(struct k_mutex *mutex)
 {
-	int new_prio;
-	k_spinlock_key_t key;
-	bool resched = false;
-
-	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
-
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mutex, lock, mutex, timeout);
-
-	key = k_spin_lock(&lock);
-
 	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
 
 		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
 					_current->base.prio :
 					mutex->owner_orig_prio;
+#ifdef CONFIG_USERSPACE
+		if (mutex->lock_count == 0U) {
+			mutex->owner_no_inherit = false;
+		}
+#endif /* CONFIG_USERSPACE */
 
 		mutex->lock_count++;
 		mutex->owner = _current;
@@ -127,9 +126,97 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 			_current, mutex, mutex->lock_count,
 			mutex->owner_orig_prio);
 
-		k_spin_unlock(&lock, key);
+		return true;
+	}
+
+	return false;
+}
+
+/* Mirror the kernel mutex ownership into the state word of a sys_mutex,
+ * so that user mode only uses atomic ops once the mutex is released.
+ */
+static inline void mutex_state_update(struct k_mutex *mutex, atomic_t *state)
+{
+#ifdef CONFIG_USERSPACE
+	if (state != NULL) {
+		atomic_set(state, (mutex->owner == NULL) ? 0 :
+			   ((atomic_val_t)mutex->owner | Z_SYS_MUTEX_KERNEL));
+	}
+#else
+	ARG_UNUSED(mutex);
+	ARG_UNUSED(state);
+#endif /* CONFIG_USERSPACE */
+}
+
+/* Whether the priority of the mutex owner may be changed for priority
+ * inheritance, which is not the case for an owner taken from the state
+ * word of a sys_mutex that the caller had no permission on.
+ */
+static inline bool mutex_inherit_allowed(struct k_mutex *mutex)
+{
+#ifdef CONFIG_USERSPACE
+	return !mutex->owner_no_inherit;
+#else
+	ARG_UNUSED(mutex);
+
+	return true;
+#endif /* CONFIG_USERSPACE */
+}
+
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+static bool thread_is_running(struct k_thread *thread)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		if (_kernel.cpus[i].current == thread) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*
+ * An owner running on another CPU is likely to release the mutex soon,
+ * so busy-wait for a bounded time before paying for a context switch.
+ * Threads already pended get the mutex handed over directly by
+ * k_mutex_unlock(), spinning only helps when there are no waiters.
+ */
+static bool mutex_spin_locked(struct k_mutex *mutex, k_spinlock_key_t *key)
+{
+	struct k_thread *owner = mutex->owner;
+
+	if ((z_waitq_head(&mutex->wait_q) != NULL) || !thread_is_running(owner)) {
+		return false;
+	}
+
+	k_spin_unlock(&lock, *key);
+
+	for (unsigned int i = 0; i < CONFIG_MUTEX_ADAPTIVE_SPIN_COUNT; i++) {
+		arch_spin_relax();
+
+		if ((*(struct k_thread * volatile *)&mutex->owner != owner) ||
+		    !thread_is_running(owner)) {
+			break;
+		}
+	}
+
+	*key = k_spin_lock(&lock);
 
-		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
+	return mutex_take_locked(mutex);
+}
+#endif /* CONFIG_MUTEX_ADAPTIVE_SPIN */
+
+static int mutex_lock(struct k_mutex *mutex, k_spinlock_key_t key,
+		      k_timeout_t timeout, atomic_t *state)
+{
+	int new_prio;
+	bool resched = false;
+
+	if (mutex_take_locked(mutex)) {
+		mutex_state_update(mutex, state);
+		k_spin_unlock(&lock, key);
 
 		return 0;
 	}
@@ -137,11 +224,18 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 	if (unlikely(K_TIMEOUT_EQ(timeout, K_NO_WAIT))) {
 		k_spin_unlock(&lock, key);
 
-		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, -EBUSY);
-
 		return -EBUSY;
 	}
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+	if (mutex_spin_locked(mutex, &key)) {
+		mutex_state_update(mutex, state);
+		k_spin_unlock(&lock, key);
+
+		return 0;
+	}
+#endif /* CONFIG_MUTEX_ADAPTIVE_SPIN */
+
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_mutex, lock, mutex, timeout);
 
 	new_prio = new_prio_for_inheritance(_current->base.prio,
@@ -149,7 +243,8 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	LOG_DBG("adjusting prio up on mutex %p", mutex);
 
-	if (z_is_prio_higher(new_prio, mutex->owner->base.prio)) {
+	if (z_is_prio_higher(new_prio, mutex->owner->base.prio) &&
+	    mutex_inherit_allowed(mutex)) {
 		resched = adjust_owner_prio(mutex, new_prio);
 	}
 
@@ -161,7 +256,6 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		got_mutex ? 'y' : 'n');
 
 	if (got_mutex == 0) {
-		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
 		return 0;
 	}
 
@@ -175,7 +269,7 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 	 * Check if mutex was unlocked after this thread was unpended.
 	 * If so, skip adjusting owner's priority down.
 	 */
-	if (likely(mutex->owner != NULL)) {
+	if (likely(mutex->owner != NULL) && mutex_inherit_allowed(mutex)) {
 		struct k_thread *waiter = z_waitq_head(&mutex->wait_q);
 
 		new_prio = (waiter != NULL) ?
@@ -193,11 +287,24 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		k_spin_unlock(&lock, key);
 	}
 
-	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, -EAGAIN);
-
 	return -EAGAIN;
 }
 
+int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
+{
+	int ret;
+
+	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mutex, lock, mutex, timeout);
+
+	ret = mutex_lock(mutex, k_spin_lock(&lock), timeout, NULL);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, ret);
+
+	return ret;
+}
+
 #ifdef CONFIG_USERSPACE
 static inline int z_vrfy_k_mutex_lock(struct k_mutex *mutex,
 				      k_timeout_t timeout)
@@ -208,10 +315,46 @@ static inline int z_vrfy_k_mutex_lock(struct k_mutex *mutex,
 #include <zephyr/syscalls/k_mutex_lock_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
-int z_impl_k_mutex_unlock(struct k_mutex *mutex)
+static void mutex_release(struct k_mutex *mutex, k_spinlock_key_t key,
+			  atomic_t *state)
 {
 	struct k_thread *new_owner;
 
+	if (mutex_inherit_allowed(mutex)) {
+		adjust_owner_prio(mutex, mutex->owner_orig_prio);
+	}
+
+	/* Get the new owner, if any */
+	new_owner = z_unpend_first_thread(&mutex->wait_q);
+
+	mutex->owner = new_owner;
+#ifdef CONFIG_USERSPACE
+	mutex->owner_no_inherit = false;
+#endif /* CONFIG_USERSPACE */
+
+	LOG_DBG("new owner of mutex %p: %p (prio: %d)",
+		mutex, new_owner, new_owner ? new_owner->base.prio : -1000);
+
+	if (new_owner != NULL) {
+		/*
+		 * new owner is already of higher or equal prio than first
+		 * waiter since the wait queue is priority-based: no need to
+		 * adjust its priority
+		 */
+		mutex->owner_orig_prio = new_owner->base.prio;
+		arch_thread_return_value_set(new_owner, 0);
+		z_ready_thread(new_owner);
+		mutex_state_update(mutex, state);
+		z_reschedule(&lock, key);
+	} else {
+		mutex->lock_count = 0U;
+		mutex_state_update(mutex, state);
+		k_spin_unlock(&lock, key);
+	}
+}
+
+int z_impl_k_mutex_unlock(struct k_mutex *mutex)
+{
 	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mutex, unlock, mutex);
@@ -249,33 +392,7 @@ int z_impl_k_mutex_unlock(struct k_mutex *mutex)
 		goto k_mutex_unlock_return;
 	}
 
-	k_spinlock_key_t key = k_spin_lock(&lock);
-
-	adjust_owner_prio(mutex, mutex->owner_orig_prio);
-
-	/* Get the new owner, if any */
-	new_owner = z_unpend_first_thread(&mutex->wait_q);
-
-	mutex->owner = new_owner;
-
-	LOG_DBG("new owner of mutex %p: %p (prio: %d)",
-		mutex, new_owner, new_owner ? new_owner->base.prio : -1000);
-
-	if (new_owner != NULL) {
-		/*
-		 * new owner is already of higher or equal prio than first
-		 * waiter since the wait queue is priority-based: no need to
-		 * adjust its priority
-		 */
-		mutex->owner_orig_prio = new_owner->base.prio;
-		arch_thread_return_value_set(new_owner, 0);
-		z_ready_thread(new_owner);
-		z_reschedule(&lock, key);
-	} else {
-		mutex->lock_count = 0U;
-		k_spin_unlock(&lock, key);
-	}
-
+	mutex_release(mutex, k_spin_lock(&lock), NULL);
 
 k_mutex_unlock_return:
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, unlock, mutex, 0);
@@ -292,6 +409,126 @@ static inline int z_vrfy_k_mutex_unlock(struct k_mutex *mutex)
 #include <zephyr/syscalls/k_mutex_unlock_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+#ifdef CONFIG_USERSPACE
+BUILD_ASSERT(__alignof__(struct k_thread) > Z_SYS_MUTEX_FLAGS,
+	     "sys_mutex state flags overlap thread pointers");
+
+static bool sys_mutex_owner_valid(struct k_object *ko)
+{
+	return (ko != NULL) && (ko->type == K_OBJ_THREAD) &&
+	       ((ko->flags & K_OBJ_FLAG_INITIALIZED) != 0U);
+}
+
+/*
+ * The owner is read from memory writable by user mode, so any thread
+ * object could be found there. Supervisor threads are trusted, user
+ * threads must have permission on the owner, as they would need to
+ * change its priority through the thread APIs.
+ */
+static bool sys_mutex_owner_trusted(struct k_object *ko)
+{
+	return ((_current->base.user_options & K_USER) == 0U) ||
+	       (k_object_validate(ko, K_OBJ_THREAD, _OBJ_INIT_TRUE) == 0);
+}
+
+/*
+ * Hand a sys_mutex over to its kernel mutex. An uncontended sys_mutex is
+ * locked from user mode by storing the owner thread in its state word,
+ * without the kernel mutex being aware of it. Once a thread has to wait,
+ * the owner is recorded in the kernel mutex, so that it gets priority
+ * inheritance and wakes up the waiters on release, and the state word is
+ * marked so that further operations go through the kernel until the
+ * mutex is released with no waiters.
+ *
+ * An owner the caller has no permission on is recorded, so that it can
+ * release the mutex, but is not given priority inheritance until the
+ * mutex changes hands through the kernel.
+ *
+ * Whether the kernel mutex is in charge is only decided from its own
+ * state, the state word being writable by user mode.
+ */
+static int sys_mutex_claim_locked(struct k_mutex *mutex, atomic_t *state)
+{
+	atomic_val_t val;
+	struct k_thread *owner;
+	struct k_object *ko = NULL;
+
+	if (mutex->lock_count != 0U) {
+		/* Mark the state word again, in case it was overwritten */
+		mutex_state_update(mutex, state);
+
+		return 0;
+	}
+
+	do {
+		val = atomic_get(state);
+		owner = (struct k_thread *)(val & ~Z_SYS_MUTEX_FLAGS);
+		if (owner != NULL) {
+			ko = k_object_find(owner);
+			if (!sys_mutex_owner_valid(ko)) {
+				return -EINVAL;
+			}
+		}
+	} while (!atomic_cas(state, val, (atomic_val_t)owner | Z_SYS_MUTEX_KERNEL));
+
+	if (owner != NULL) {
+		mutex->owner = owner;
+		mutex->owner_orig_prio = owner->base.prio;
+		mutex->lock_count = 1U;
+		mutex->owner_no_inherit = !sys_mutex_owner_trusted(ko);
+	}
+
+	return 0;
+}
+
+int z_sys_mutex_lock_contended(struct k_mutex *mutex, atomic_t *state,
+			       k_timeout_t timeout)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	int ret;
+
+	ret = sys_mutex_claim_locked(mutex, state);
+	if (ret != 0) {
+		k_spin_unlock(&lock, key);
+
+		return ret;
+	}
+
+	return mutex_lock(mutex, key, timeout, state);
+}
+
+int z_sys_mutex_unlock_contended(struct k_mutex *mutex, atomic_t *state)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	atomic_val_t val;
+	int ret = 0;
+
+	if (mutex->lock_count == 0U) {
+		/* Locked with atomic ops only */
+		val = atomic_get(state);
+		if (val == 0) {
+			ret = -EINVAL;
+		} else if (val != (atomic_val_t)_current) {
+			ret = -EPERM;
+		} else {
+			atomic_set(state, 0);
+		}
+	} else if (mutex->owner != _current) {
+		ret = -EPERM;
+	} else if (mutex->lock_count > 1U) {
+		mutex->lock_count--;
+	} else {
+		mutex_release(mutex, key, state);
+
+		return 0;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return ret;
+}
+#endif /* CONFIG_USERSPACE */
+
 #ifdef CONFIG_OBJ_CORE_MUTEX
 static int init_mutex_obj_core_list(void)
 {
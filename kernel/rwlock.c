@@ -0,0 +1,326 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file @brief reader-writer lock kernel services
+ *
+ * Readers are admitted as long as there is neither a writer holding the lock
+ * nor one waiting for it. When a writer releases the lock, all waiting
+ * readers are admitted at once, before the next writer. Ownership is handed
+ * over to the woken threads directly, so that a thread that did not wait
+ * cannot barge in.
+ *
+ * The writer holding the lock is subject to priority inheritance from all
+ * waiting threads, the same way a mutex owner is. Readers are anonymous and
+ * are not boosted.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
+#include <zephyr/toolchain.h>
+#include <ksched.h>
+#include <wait_q.h>
+#include <errno.h>
+#include <zephyr/init.h>
+#include <zephyr/internal/syscall_handler.h>
+#include <zephyr/sys/check.h>
+
+static struct k_spinlock lock;
+
+int z_impl_k_rwlock_init(struct k_rwlock *rwlock)
+{
+	rwlock->writer = NULL;
+	rwlock->readers = 0U;
+
+	z_waitq_init(&rwlock->read_wait_q);
+	z_waitq_init(&rwlock->write_wait_q);
+
+	k_object_init(rwlock);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_init(struct k_rwlock *rwlock)
+{
+	K_OOPS(K_SYSCALL_OBJ_INIT(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_init(rwlock);
+}
+#include <zephyr/syscalls/k_rwlock_init_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+static bool writer_prio_set(struct k_rwlock *rwlock, int prio)
+{
+	if (rwlock->writer->base.prio != prio) {
+		return z_thread_prio_set(rwlock->writer, prio);
+	}
+
+	return false;
+}
+
+/* Priority the writer holding the lock should run at, given the threads
+ * still waiting for it.
+ */
+static int writer_inherited_prio(struct k_rwlock *rwlock)
+{
+	struct k_thread *waiters[] = {
+		z_waitq_head(&rwlock->read_wait_q),
+		z_waitq_head(&rwlock->write_wait_q),
+	};
+	int prio = rwlock->writer_orig_prio;
+
+	for (size_t i = 0; i < ARRAY_SIZE(waiters); i++) {
+		if (waiters[i] == NULL) {
+			continue;
+		}
+
+		int new_prio = z_get_new_prio_with_ceiling(waiters[i]->base.prio);
+
+		if (z_is_prio_higher(new_prio, prio)) {
+			prio = new_prio;
+		}
+	}
+
+	return prio;
+}
+
+static void grant_writer(struct k_rwlock *rwlock, struct k_thread *thread)
+{
+	rwlock->writer = thread;
+	rwlock->writer_orig_prio = thread->base.prio;
+
+	arch_thread_return_value_set(thread, 0);
+	z_ready_thread(thread);
+}
+
+static unsigned int grant_readers(struct k_rwlock *rwlock)
+{
+	struct k_thread *thread;
+	unsigned int woken = 0U;
+
+	while ((thread = z_unpend_first_thread(&rwlock->read_wait_q)) != NULL) {
+		rwlock->readers++;
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+		woken++;
+	}
+
+	return woken;
+}
+
+/*
+ * Pend the current thread on one of the wait queues, boosting the writer
+ * holding the lock if any. Ownership is set by the thread releasing the
+ * lock, so there is nothing left to do once woken up.
+ */
+static int rwlock_pend(struct k_rwlock *rwlock, k_spinlock_key_t key,
+		       _wait_q_t *wait_q, k_timeout_t timeout)
+{
+	int new_prio = z_get_new_prio_with_ceiling(_current->base.prio);
+	bool resched = false;
+	int ret;
+
+	if ((rwlock->writer != NULL) &&
+	    z_is_prio_higher(new_prio, rwlock->writer->base.prio)) {
+		resched = writer_prio_set(rwlock, new_prio);
+	}
+
+	ret = z_pend_curr(&lock, key, wait_q, timeout);
+	if (ret == 0) {
+		return 0;
+	}
+
+	/* timed out */
+
+	key = k_spin_lock(&lock);
+
+	if (rwlock->writer != NULL) {
+		resched = writer_prio_set(rwlock, writer_inherited_prio(rwlock)) ||
+			  resched;
+	} else if ((rwlock->readers > 0U) &&
+		   (z_waitq_head(&rwlock->write_wait_q) == NULL)) {
+		/* Readers may have been held back by a writer which gave up
+		 * waiting, let them in.
+		 */
+		resched = (grant_readers(rwlock) > 0U) || resched;
+	}
+
+	if (resched) {
+		z_reschedule(&lock, key);
+	} else {
+		k_spin_unlock(&lock, key);
+	}
+
+	return -EAGAIN;
+}
+
+int z_impl_k_rwlock_read_lock(struct k_rwlock *rwlock, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+
+	__ASSERT(!arch_is_in_isr(), "rwlocks cannot be used inside ISRs");
+
+	key = k_spin_lock(&lock);
+
+	if (likely((rwlock->writer == NULL) &&
+		   (z_waitq_head(&rwlock->write_wait_q) == NULL))) {
+		rwlock->readers++;
+		k_spin_unlock(&lock, key);
+
+		return 0;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		k_spin_unlock(&lock, key);
+
+		return -EBUSY;
+	}
+
+	return rwlock_pend(rwlock, key, &rwlock->read_wait_q, timeout);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_read_lock(struct k_rwlock *rwlock,
+					    k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_read_lock(rwlock, timeout);
+}
+#include <zephyr/syscalls/k_rwlock_read_lock_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_k_rwlock_read_unlock(struct k_rwlock *rwlock)
+{
+	struct k_thread *thread;
+	k_spinlock_key_t key;
+
+	__ASSERT(!arch_is_in_isr(), "rwlocks cannot be used inside ISRs");
+
+	key = k_spin_lock(&lock);
+
+	CHECKIF(rwlock->readers == 0U) {
+		k_spin_unlock(&lock, key);
+
+		return -EINVAL;
+	}
+
+	rwlock->readers--;
+
+	if (rwlock->readers == 0U) {
+		thread = z_unpend_first_thread(&rwlock->write_wait_q);
+		if (thread != NULL) {
+			grant_writer(rwlock, thread);
+			(void)writer_prio_set(rwlock, writer_inherited_prio(rwlock));
+			z_reschedule(&lock, key);
+
+			return 0;
+		}
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_read_unlock(struct k_rwlock *rwlock)
+{
+	K_OOPS(K_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_read_unlock(rwlock);
+}
+#include <zephyr/syscalls/k_rwlock_read_unlock_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_k_rwlock_write_lock(struct k_rwlock *rwlock, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+
+	__ASSERT(!arch_is_in_isr(), "rwlocks cannot be used inside ISRs");
+
+	key = k_spin_lock(&lock);
+
+	if (likely((rwlock->writer == NULL) && (rwlock->readers == 0U))) {
+		rwlock->writer = _current;
+		rwlock->writer_orig_prio = _current->base.prio;
+		k_spin_unlock(&lock, key);
+
+		return 0;
+	}
+
+	if (rwlock->writer == _current) {
+		k_spin_unlock(&lock, key);
+
+		return -EDEADLK;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		k_spin_unlock(&lock, key);
+
+		return -EBUSY;
+	}
+
+	return rwlock_pend(rwlock, key, &rwlock->write_wait_q, timeout);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_write_lock(struct k_rwlock *rwlock,
+					     k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_write_lock(rwlock, timeout);
+}
+#include <zephyr/syscalls/k_rwlock_write_lock_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_k_rwlock_write_unlock(struct k_rwlock *rwlock)
+{
+	struct k_thread *thread;
+	k_spinlock_key_t key;
+
+	__ASSERT(!arch_is_in_isr(), "rwlocks cannot be used inside ISRs");
+
+	key = k_spin_lock(&lock);
+
+	CHECKIF(rwlock->writer == NULL) {
+		k_spin_unlock(&lock, key);
+
+		return -EINVAL;
+	}
+
+	CHECKIF(rwlock->writer != _current) {
+		k_spin_unlock(&lock, key);
+
+		return -EPERM;
+	}
+
+	(void)writer_prio_set(rwlock, rwlock->writer_orig_prio);
+	rwlock->writer = NULL;
+
+	if (grant_readers(rwlock) == 0U) {
+		thread = z_unpend_first_thread(&rwlock->write_wait_q);
+		if (thread == NULL) {
+			k_spin_unlock(&lock, key);
+
+			return 0;
+		}
+
+		grant_writer(rwlock, thread);
+		(void)writer_prio_set(rwlock, writer_inherited_prio(rwlock));
+	}
+
+	z_reschedule(&lock, key);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_write_unlock(struct k_rwlock *rwlock)
+{
+	K_OOPS(K_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_write_unlock(rwlock);
+}
+#include <zephyr/syscalls/k_rwlock_write_unlock_mrsh.c>
+#endif /* CONFIG_USERSPACE */
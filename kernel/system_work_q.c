@@ -19,6 +19,13 @@ static K_KERNEL_STACK_DEFINE(sys_work_q_stack,
 
 struct k_work_q k_sys_work_q;
 
+#if defined(CONFIG_SYSTEM_WORKQUEUE_POOL_THREADS) && (CONFIG_SYSTEM_WORKQUEUE_POOL_THREADS > 0)
+static K_KERNEL_STACK_ARRAY_DEFINE(sys_work_q_pool_stacks,
+				   CONFIG_SYSTEM_WORKQUEUE_POOL_THREADS,
+				   CONFIG_SYSTEM_WORKQUEUE_STACK_SIZE);
+static struct k_work_q_thread sys_work_q_pool_threads[CONFIG_SYSTEM_WORKQUEUE_POOL_THREADS];
+#endif
+
 static int k_sys_work_q_init(void)
 {
 	struct k_work_queue_config cfg = {
@@ -31,6 +38,17 @@ static int k_sys_work_q_init(void)
 			    sys_work_q_stack,
 			    K_KERNEL_STACK_SIZEOF(sys_work_q_stack),
 			    CONFIG_SYSTEM_WORKQUEUE_PRIORITY, &cfg);
+
+#if defined(CONFIG_SYSTEM_WORKQUEUE_POOL_THREADS) && (CONFIG_SYSTEM_WORKQUEUE_POOL_THREADS > 0)
+	for (int i = 0; i < CONFIG_SYSTEM_WORKQUEUE_POOL_THREADS; i++) {
+		(void)k_work_queue_thread_add(&k_sys_work_q,
+					      &sys_work_q_pool_threads[i],
+					      sys_work_q_pool_stacks[i],
+					      K_KERNEL_STACK_SIZEOF(sys_work_q_pool_stacks[i]),
+					      CONFIG_SYSTEM_WORKQUEUE_PRIORITY, -1);
+	}
+#endif
+
 	return 0;
 }
 
@@ -200,6 +200,9 @@ static void queue_flusher_locked(struct k_work_q *queue,
 	}
 
 	init_flusher(flusher);
+#ifdef CONFIG_WORKQUEUE_POOL
+	flusher->target = work;
+#endif
 	if (in_list) {
 		sys_slist_insert(&queue->pending, &work->node,
 				 &flusher->work.node);
@@ -245,6 +248,31 @@ static inline bool notify_queue_locked(struct k_work_q *queue)
 	return rv;
 }
 
+/* Check whether the current thread is one of the threads of a queue.
+ *
+ * Invoked with work lock held.
+ *
+ * @param queue the queue to check.
+ */
+static inline bool queue_thread_is_current(struct k_work_q *queue)
+{
+	if (_current == &queue->thread) {
+		return true;
+	}
+
+#ifdef CONFIG_WORKQUEUE_POOL
+	struct k_work_q_thread *wthread;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&queue->threads, wthread, node) {
+		if (_current == &wthread->thread) {
+			return true;
+		}
+	}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
+	return false;
+}
+
 /* Submit an work item to a queue if queue state allows new work.
  *
  * Submission is rejected if no queue is provided, or if the queue is
@@ -272,7 +300,7 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	}
 
 	int ret;
-	bool chained = (_current == &queue->thread) && !k_is_in_isr();
+	bool chained = queue_thread_is_current(queue) && !k_is_in_isr();
 	bool draining = flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 	bool plugged = flag_test(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
 
@@ -609,6 +637,85 @@ bool k_work_cancel_sync(struct k_work *work,
 	return pending;
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+/* Check whether a pending work item can be started by a queue thread.
+ *
+ * Invoked with work lock held.
+ *
+ * @param work the pending work item.
+ */
+static bool work_runnable_locked(struct k_work *work)
+{
+	/* Resubmitted while running on another thread of the queue: it must
+	 * not be re-entered.
+	 */
+	if (flag_test(&work->flags, K_WORK_RUNNING_BIT)) {
+		return false;
+	}
+
+	/* A flusher may only complete once the flushed item has completed,
+	 * which on a single-threaded queue is implied by the ordering.
+	 */
+	if (flag_test(&work->flags, K_WORK_FLUSHING_BIT)) {
+		struct z_work_flusher *flusher
+			= CONTAINER_OF(work, struct z_work_flusher, work);
+
+		return !flag_test(&flusher->target->flags, K_WORK_RUNNING_BIT);
+	}
+
+	return true;
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
+/* Take the next work item to be processed from a queue.
+ *
+ * Invoked with work lock held.
+ *
+ * @param queue the queue to take work from.
+ *
+ * @return the node of the work item, or NULL if none can be started.
+ */
+static sys_snode_t *queue_next_locked(struct k_work_q *queue)
+{
+#ifdef CONFIG_WORKQUEUE_POOL
+	if (!sys_slist_is_empty(&queue->threads)) {
+		sys_snode_t *prev = NULL;
+		sys_snode_t *node;
+
+		SYS_SLIST_FOR_EACH_NODE(&queue->pending, node) {
+			if (work_runnable_locked(CONTAINER_OF(node, struct k_work,
+							      node))) {
+				sys_slist_remove(&queue->pending, prev, node);
+				return node;
+			}
+
+			prev = node;
+		}
+
+		return NULL;
+	}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
+	return sys_slist_get(&queue->pending);
+}
+
+/* Check whether a queue has no pending or active work.
+ *
+ * Invoked with work lock held, when no work can be taken from the queue.
+ *
+ * @param queue the queue to check.
+ */
+static inline bool queue_idle_locked(struct k_work_q *queue)
+{
+#ifdef CONFIG_WORKQUEUE_POOL
+	return (queue->active == 0U) && sys_slist_is_empty(&queue->pending);
+#else
+	ARG_UNUSED(queue);
+
+	return true;
+#endif /* CONFIG_WORKQUEUE_POOL */
+}
+
 /* Loop executed by a work queue thread.
  *
  * @param workq_ptr pointer to the work queue structure
@@ -628,12 +735,15 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		bool yield;
 
 		/* Check for and prepare any new work. */
-		node = sys_slist_get(&queue->pending);
+		node = queue_next_locked(queue);
 		if (node != NULL) {
 			/* Mark that there's some work active that's
 			 * not on the pending list.
 			 */
 			flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+#ifdef CONFIG_WORKQUEUE_POOL
+			queue->active++;
+#endif
 			work = CONTAINER_OF(node, struct k_work, node);
 			flag_set(&work->flags, K_WORK_RUNNING_BIT);
 			flag_clear(&work->flags, K_WORK_QUEUED_BIT);
@@ -651,7 +761,8 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			 * This means that if node is not NULL, then work will not be NULL.
 			 */
 			handler = work->handler;
-		} else if (flag_test_and_clear(&queue->flags,
+		} else if (queue_idle_locked(queue) &&
+			   flag_test_and_clear(&queue->flags,
 					       K_WORK_QUEUE_DRAIN_BIT)) {
 			/* Not busy and draining: move threads waiting for
 			 * drain to ready state.  The held spinlock inhibits
@@ -702,7 +813,21 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			finalize_cancel_locked(work);
 		}
 
+#ifdef CONFIG_WORKQUEUE_POOL
+		queue->active--;
+		if (queue->active == 0U) {
+			flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+		}
+
+		/* Items held back while this one was running may now be
+		 * taken by another thread of the queue.
+		 */
+		if (!sys_slist_is_empty(&queue->pending)) {
+			(void)notify_queue_locked(queue);
+		}
+#else
 		flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+#endif /* CONFIG_WORKQUEUE_POOL */
 		yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT);
 		k_spin_unlock(&lock, key);
 
@@ -742,6 +867,10 @@ void k_work_queue_start(struct k_work_q *queue,
 	sys_slist_init(&queue->pending);
 	z_waitq_init(&queue->notifyq);
 	z_waitq_init(&queue->drainq);
+#ifdef CONFIG_WORKQUEUE_POOL
+	sys_slist_init(&queue->threads);
+	queue->active = 0U;
+#endif
 
 	if ((cfg != NULL) && cfg->no_yield) {
 		flags |= K_WORK_QUEUE_NO_YIELD;
@@ -770,6 +899,72 @@ void k_work_queue_start(struct k_work_q *queue,
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
 }
 
+bool k_work_queue_is_current(struct k_work_q *queue)
+{
+	__ASSERT_NO_MSG(queue);
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	bool ret = queue_thread_is_current(queue);
+
+	k_spin_unlock(&lock, key);
+
+	return ret;
+}
+
+#ifdef CONFIG_WORKQUEUE_POOL
+int k_work_queue_thread_add(struct k_work_q *queue,
+			    struct k_work_q_thread *wthread,
+			    k_thread_stack_t *stack, size_t stack_size,
+			    int prio, int cpu)
+{
+	__ASSERT_NO_MSG(queue);
+	__ASSERT_NO_MSG(wthread);
+	__ASSERT_NO_MSG(stack);
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	bool started = flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT);
+
+	k_spin_unlock(&lock, key);
+
+	if (!started) {
+		return -ENODEV;
+	}
+
+	if (cpu >= (int)arch_num_cpus()) {
+		return -EINVAL;
+	}
+
+	if ((cpu >= 0) && !IS_ENABLED(CONFIG_SCHED_CPU_MASK)) {
+		return -ENOTSUP;
+	}
+
+	(void)k_thread_create(&wthread->thread, stack, stack_size,
+			      work_queue_main, queue, NULL, NULL,
+			      prio, 0, K_FOREVER);
+
+#ifdef CONFIG_THREAD_NAME
+	k_thread_name_set(&wthread->thread, queue->thread.name);
+#endif
+
+	wthread->thread.base.user_options |=
+		(queue->thread.base.user_options & K_ESSENTIAL);
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	if (cpu >= 0) {
+		(void)k_thread_cpu_pin(&wthread->thread, cpu);
+	}
+#endif
+
+	key = k_spin_lock(&lock);
+	sys_slist_append(&queue->threads, &wthread->node);
+	k_spin_unlock(&lock, key);
+
+	k_thread_start(&wthread->thread);
+
+	return 0;
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 int k_work_queue_drain(struct k_work_q *queue,
 		       bool plug)
 {
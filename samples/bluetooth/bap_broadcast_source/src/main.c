@@ -148,57 +148,66 @@ static int octets_per_frame;
 static K_SEM_DEFINE(lc3_encoder_sem, 0U, TOTAL_BUF_NEEDED);
 #endif
 
-static void send_data(struct broadcast_source_stream *source_stream)
+static struct net_buf *alloc_data(struct broadcast_source_stream *source_stream)
 {
-	struct bt_bap_stream *stream = &source_stream->stream;
 	struct net_buf *buf;
-	int ret;
 
 	if (stopping) {
-		return;
+		return NULL;
 	}
 
 	buf = net_buf_alloc(&tx_pool, K_FOREVER);
 	if (buf == NULL) {
-		printk("Could not allocate buffer when sending on %p\n", stream);
-		return;
+		printk("Could not allocate buffer when sending on %p\n", &source_stream->stream);
+		return NULL;
 	}
 
 	net_buf_reserve(buf, BT_ISO_CHAN_SEND_RESERVE);
+
+	return buf;
+}
+
 #if defined(CONFIG_LIBLC3)
-	uint8_t lc3_encoded_buffer[preset_active.qos.sdu];
+/* Encodes all frame blocks of an SDU directly into the TX buffer */
+static int encode_data(struct broadcast_source_stream *source_stream, struct net_buf *buf)
+{
+	int ret;
 
 	if (source_stream->lc3_encoder == NULL) {
 		printk("LC3 encoder not setup, cannot encode data.\n");
-		net_buf_unref(buf);
-		return;
+		return -EINVAL;
 	}
 
+	for (int i = 0; i < frames_per_sdu; i++) {
 #if defined(CONFIG_USB_DEVICE_AUDIO)
-	uint32_t size = ring_buf_get(&source_stream->audio_ring_buf, (uint8_t *)send_pcm_data,
-				     sizeof(send_pcm_data));
+		uint32_t size = ring_buf_get(&source_stream->audio_ring_buf,
+					     (uint8_t *)send_pcm_data, sizeof(send_pcm_data));
 
-	if (size < sizeof(send_pcm_data)) {
-		const size_t padding_size = sizeof(send_pcm_data) - size;
+		if (size < sizeof(send_pcm_data)) {
+			const size_t padding_size = sizeof(send_pcm_data) - size;
 
-		printk("Not enough bytes ready, padding %d!\n", padding_size);
-		memset(&((uint8_t *)send_pcm_data)[size], 0, padding_size);
-	}
+			printk("Not enough bytes ready, padding %d!\n", padding_size);
+			memset(&((uint8_t *)send_pcm_data)[size], 0, padding_size);
+		}
 #endif
 
-	ret = lc3_encode(source_stream->lc3_encoder, LC3_PCM_FORMAT_S16, send_pcm_data, 1,
-			 octets_per_frame, lc3_encoded_buffer);
-	if (ret == -1) {
-		printk("LC3 encoder failed - wrong parameters?: %d", ret);
-		net_buf_unref(buf);
-		return;
+		ret = lc3_encode(source_stream->lc3_encoder, LC3_PCM_FORMAT_S16, send_pcm_data, 1,
+				 octets_per_frame, net_buf_add(buf, octets_per_frame));
+		if (ret == -1) {
+			printk("LC3 encoder failed - wrong parameters?: %d", ret);
+			return -EINVAL;
+		}
 	}
 
-	net_buf_add_mem(buf, lc3_encoded_buffer, preset_active.qos.sdu);
-#else
-	net_buf_add_mem(buf, send_pcm_data, preset_active.qos.sdu);
+	return 0;
+}
 #endif /* defined(CONFIG_LIBLC3) */
 
+static void send_buf(struct broadcast_source_stream *source_stream, struct net_buf *buf)
+{
+	struct bt_bap_stream *stream = &source_stream->stream;
+	int ret;
+
 	ret = bt_bap_stream_send(stream, buf, source_stream->seq_num++);
 	if (ret < 0) {
 		/* This will end broadcasting on this stream. */
@@ -213,7 +222,49 @@ static void send_data(struct broadcast_source_stream *source_stream)
 	}
 }
 
+#if !defined(CONFIG_LIBLC3)
+static void send_data(struct broadcast_source_stream *source_stream)
+{
+	struct net_buf *buf;
+
+	buf = alloc_data(source_stream);
+	if (buf == NULL) {
+		return;
+	}
+
+	net_buf_add_mem(buf, send_pcm_data, preset_active.qos.sdu);
+
+	send_buf(source_stream, buf);
+}
+#endif /* !defined(CONFIG_LIBLC3) */
+
 #if defined(CONFIG_LIBLC3)
+#if defined(CONFIG_LC3_ENCODE_STATS)
+static struct {
+	uint64_t total_cycles;
+	uint32_t max_cycles;
+	uint32_t count;
+} encode_stats;
+
+static void encode_stats_add(uint32_t cycles)
+{
+	encode_stats.total_cycles += cycles;
+	encode_stats.max_cycles = MAX(encode_stats.max_cycles, cycles);
+	encode_stats.count++;
+
+	if (encode_stats.count == 1000U) {
+		const uint32_t avg_cycles = encode_stats.total_cycles / encode_stats.count;
+
+		printk("LC3 encoding of %zu streams: avg %u us (%u us per stream), max %u us\n",
+		       ARRAY_SIZE(streams), k_cyc_to_us_floor32(avg_cycles),
+		       k_cyc_to_us_floor32(avg_cycles / ARRAY_SIZE(streams)),
+		       k_cyc_to_us_floor32(encode_stats.max_cycles));
+
+		(void)memset(&encode_stats, 0, sizeof(encode_stats));
+	}
+}
+#endif /* CONFIG_LC3_ENCODE_STATS */
+
 static void init_lc3_thread(void *arg1, void *arg2, void *arg3)
 {
 	const struct bt_audio_codec_cfg *codec_cfg = &preset_active.codec_cfg;
@@ -269,11 +320,44 @@ static void init_lc3_thread(void *arg1, void *arg2, void *arg3)
 	}
 
 	while (true) {
+		struct net_buf *bufs[ARRAY_SIZE(streams)];
+#if defined(CONFIG_LC3_ENCODE_STATS)
+		uint32_t start_cycles;
+		uint32_t cycles;
+#endif /* CONFIG_LC3_ENCODE_STATS */
+
 		for (size_t i = 0U; i < ARRAY_SIZE(streams); i++) {
 			k_sem_take(&lc3_encoder_sem, K_FOREVER);
 		}
+
+		/* Encode the SDUs of all streams for this SDU interval as one batch, while
+		 * the SDUs of the previous intervals are still queued for transmission,
+		 * then send them back-to-back.
+		 */
+		for (size_t i = 0U; i < ARRAY_SIZE(streams); i++) {
+			bufs[i] = alloc_data(&streams[i]);
+		}
+
+#if defined(CONFIG_LC3_ENCODE_STATS)
+		start_cycles = k_cycle_get_32();
+#endif /* CONFIG_LC3_ENCODE_STATS */
+
+		for (size_t i = 0U; i < ARRAY_SIZE(streams); i++) {
+			if (bufs[i] != NULL && encode_data(&streams[i], bufs[i]) != 0) {
+				net_buf_unref(bufs[i]);
+				bufs[i] = NULL;
+			}
+		}
+
+#if defined(CONFIG_LC3_ENCODE_STATS)
+		cycles = k_cycle_get_32() - start_cycles;
+		encode_stats_add(cycles);
+#endif /* CONFIG_LC3_ENCODE_STATS */
+
 		for (size_t i = 0U; i < ARRAY_SIZE(streams); i++) {
-			send_data(&streams[i]);
+			if (bufs[i] != NULL) {
+				send_buf(&streams[i], bufs[i]);
+			}
 		}
 	}
 }
@@ -20,6 +20,7 @@ LOG_ARCH_HDR_SIZE = struct.calcsize(LOG_ARCH_HDR_STRUCT)
 
 COREDUMP_MEM_HDR_ID = b'M'
 COREDUMP_MEM_HDR_VER = 1
+COREDUMP_MEM_HDR_VER_COMPRESSED = 2
 LOG_MEM_HDR_STRUCT = "<cH"
 LOG_MEM_HDR_SIZE = struct.calcsize(LOG_MEM_HDR_STRUCT)
 
@@ -27,6 +28,46 @@ LOG_MEM_HDR_SIZE = struct.calcsize(LOG_MEM_HDR_STRUCT)
 logger = logging.getLogger("parser")
 
 
+def decompress_memory(fd, size):
+    """
+    Read a compressed memory block of the given size,
+    see subsys/debug/coredump/coredump_compress.c for the format.
+    """
+    data = bytearray()
+
+    while len(data) < size:
+        token = fd.read(1)
+        if not token:
+            return None
+
+        token = token[0]
+        if token < 0x80:
+            literals = fd.read(token + 1)
+            if len(literals) != token + 1:
+                return None
+            data += literals
+        elif token < 0xc0:
+            dist = fd.read(2)
+            if len(dist) != 2:
+                return None
+            dist = struct.unpack("<H", dist)[0]
+            if dist == 0 or dist > len(data):
+                return None
+            # Copy byte by byte, as the match can overlap the data it produces
+            for _ in range((token & 0x3f) + 4):
+                data.append(data[-dist])
+        else:
+            count = fd.read(1)
+            if not count:
+                return None
+            data += bytes((((token & 0x3f) << 8) | count[0]) + 1)
+
+    if len(data) != size:
+        return None
+
+    return bytes(data)
+
+
 def reason_string(reason):
     # Keep sync with "enum k_fatal_error_reason"
     ret = "(Unknown)"
@@ -85,8 +126,9 @@ class CoredumpLogFile:
         hdr = self.fd.read(LOG_MEM_HDR_SIZE)
         _, hdr_ver = struct.unpack(LOG_MEM_HDR_STRUCT, hdr)
 
-        if hdr_ver != COREDUMP_MEM_HDR_VER:
-            logger.error(f"Memory block version: {hdr_ver}, expected {COREDUMP_MEM_HDR_VER}!")
+        if hdr_ver not in (COREDUMP_MEM_HDR_VER, COREDUMP_MEM_HDR_VER_COMPRESSED):
+            logger.error(f"Memory block version: {hdr_ver}, "
+                         f"expected {COREDUMP_MEM_HDR_VER} or {COREDUMP_MEM_HDR_VER_COMPRESSED}!")
             return False
 
         # Figure out how to read the start and end addresses
@@ -103,14 +145,24 @@ class CoredumpLogFile:
 
         size = eaddr - saddr
 
-        data = self.fd.read(size)
+        if hdr_ver == COREDUMP_MEM_HDR_VER_COMPRESSED:
+            pos = self.fd.tell()
+            data = decompress_memory(self.fd, size)
+            if data is None:
+                logger.error("Cannot decompress memory block at 0x%x" % saddr)
+                return False
+
+            logger.info("Memory: 0x%x to 0x%x of size %d, compressed to %d" %
+                        (saddr, eaddr, size, self.fd.tell() - pos))
+        else:
+            data = self.fd.read(size)
+
+            logger.info("Memory: 0x%x to 0x%x of size %d" %
+                        (saddr, eaddr, size))
 
         mem = {"start": saddr, "end": eaddr, "data": data}
         self.memory_regions.append(mem)
 
-        logger.info("Memory: 0x%x to 0x%x of size %d" %
-                    (saddr, eaddr, size))
-
         return True
 
     def parse(self):
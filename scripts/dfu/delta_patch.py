@@ -0,0 +1,246 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Create and apply patches for delta image updates.
+
+A patch rebuilds a target image from a source image, the image currently on
+the device, with the following format, all values being little endian:
+
+    header:
+        uint32 magic        0x544c445a ("ZDLT")
+        uint32 source_size
+        uint32 target_size
+        uint32 reserved     0
+        uint8  source_sha256[32]
+        uint8  target_sha256[32]
+    commands, until target_size bytes have been produced:
+        0x01 uint32 offset uint32 length    copy from the source image
+        0x02 uint32 length data[length]     insert data
+
+Patches are applied on the device by the flash image patch API
+(CONFIG_IMG_PATCH), for instance when uploaded through MCUmgr with
+CONFIG_MCUMGR_GRP_IMG_DELTA.
+"""
+
+import argparse
+import hashlib
+import struct
+import sys
+
+MAGIC = 0x544C445A
+HEADER = struct.Struct('<IIII32s32s')
+OP_COPY = 0x01
+OP_INSERT = 0x02
+COPY = struct.Struct('<BII')
+INSERT = struct.Struct('<BI')
+
+# Shortest match worth a copy command rather than inserting the data
+DEFAULT_BLOCK = 16
+# Source offsets indexed, matches of at least block + step - 1 bytes are found
+INDEX_STEP = 4
+# Source offsets kept for each block value
+MAX_CANDIDATES = 8
+
+
+class PatchError(Exception):
+    pass
+
+
+def match_length(source, src_off, target, tgt_off):
+    """Return the length of the common data at src_off and tgt_off."""
+    length = 0
+    limit = min(len(source) - src_off, len(target) - tgt_off)
+
+    # Compare in chunks first, then byte by byte
+    chunk = 64
+    while length + chunk <= limit and \
+            source[src_off + length:src_off + length + chunk] == \
+            target[tgt_off + length:tgt_off + length + chunk]:
+        length += chunk
+
+    while length < limit and source[src_off + length] == target[tgt_off + length]:
+        length += 1
+
+    return length
+
+
+def build_index(source, block):
+    index = {}
+
+    for off in range(0, len(source) - block + 1, INDEX_STEP):
+        offsets = index.setdefault(source[off:off + block], [])
+        if len(offsets) < MAX_CANDIDATES:
+            offsets.append(off)
+
+    return index
+
+
+def diff(source, target, block=DEFAULT_BLOCK):
+    """Return the list of commands rebuilding target from source.
+
+    Commands are ('copy', offset, length) and ('insert', data) tuples.
+    """
+    index = build_index(source, block)
+    commands = []
+    literal_start = 0
+    pos = 0
+    # Source offset following the last copy, where the next match often is
+    next_src = None
+
+    while pos + block <= len(target):
+        key = target[pos:pos + block]
+        candidates = list(index.get(key, ()))
+
+        if next_src is not None and source[next_src:next_src + block] == key:
+            candidates.insert(0, next_src)
+
+        best_off = None
+        best_len = 0
+        for off in candidates:
+            length = match_length(source, off, target, pos)
+            if length > best_len:
+                best_off = off
+                best_len = length
+
+        if best_len < block:
+            pos += 1
+            continue
+
+        # Extend the match backwards over the data not covered yet
+        back = 0
+        while pos - back > literal_start and best_off - back > 0 and \
+                source[best_off - back - 1] == target[pos - back - 1]:
+            back += 1
+
+        if pos - back > literal_start:
+            commands.append(('insert', target[literal_start:pos - back]))
+
+        commands.append(('copy', best_off - back, best_len + back))
+        pos += best_len
+        literal_start = pos
+        next_src = best_off + best_len
+
+    if literal_start < len(target):
+        commands.append(('insert', target[literal_start:]))
+
+    return commands
+
+
+def create(source, target, block=DEFAULT_BLOCK):
+    """Return a patch rebuilding target from source."""
+    if not source or not target:
+        raise PatchError('source and target images must not be empty')
+
+    patch = bytearray(HEADER.pack(MAGIC, len(source), len(target), 0,
+                                  hashlib.sha256(source).digest(),
+                                  hashlib.sha256(target).digest()))
+
+    for command in diff(source, target, block):
+        if command[0] == 'copy':
+            patch += COPY.pack(OP_COPY, command[1], command[2])
+        else:
+            patch += INSERT.pack(OP_INSERT, len(command[1]))
+            patch += command[1]
+
+    return bytes(patch)
+
+
+def apply(source, patch):
+    """Return the target image rebuilt from source and patch."""
+    if len(patch) < HEADER.size:
+        raise PatchError('patch too short')
+
+    magic, source_size, target_size, reserved, source_sha, target_sha = \
+        HEADER.unpack_from(patch)
+    if magic != MAGIC or reserved != 0:
+        raise PatchError('invalid patch header')
+
+    if source_size != len(source) or hashlib.sha256(source).digest() != source_sha:
+        raise PatchError('source image does not match the patch')
+
+    target = bytearray()
+    pos = HEADER.size
+    while len(target) < target_size:
+        if pos >= len(patch):
+            raise PatchError('incomplete patch')
+
+        if patch[pos] == OP_COPY:
+            _, offset, length = COPY.unpack_from(patch, pos)
+            if offset + length > source_size:
+                raise PatchError(f'copy out of source image at {pos}')
+            target += source[offset:offset + length]
+            pos += COPY.size
+        elif patch[pos] == OP_INSERT:
+            _, length = INSERT.unpack_from(patch, pos)
+            pos += INSERT.size
+            target += patch[pos:pos + length]
+            pos += length
+        else:
+            raise PatchError(f'invalid command 0x{patch[pos]:02x} at {pos}')
+
+    if pos != len(patch) or len(target) != target_size or \
+            hashlib.sha256(target).digest() != target_sha:
+        raise PatchError('target image does not match the patch')
+
+    return bytes(target)
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter,
+                                     allow_abbrev=False)
+    subparsers = parser.add_subparsers(dest='command', required=True)
+
+    create_parser = subparsers.add_parser('create', help='create a patch')
+    create_parser.add_argument('source', help='source image, currently on the device')
+    create_parser.add_argument('target', help='target image, to update to')
+    create_parser.add_argument('patch', help='output patch file')
+    create_parser.add_argument('--block', type=int, default=DEFAULT_BLOCK,
+                               help='shortest match copied from the source image '
+                               f'(default: {DEFAULT_BLOCK})')
+
+    apply_parser = subparsers.add_parser('apply', help='apply a patch')
+    apply_parser.add_argument('source', help='source image')
+    apply_parser.add_argument('patch', help='patch file')
+    apply_parser.add_argument('target', help='output target image')
+
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+
+    with open(args.source, 'rb') as f:
+        source = f.read()
+
+    try:
+        if args.command == 'create':
+            with open(args.target, 'rb') as f:
+                target = f.read()
+
+            patch = create(source, target, args.block)
+            # Check the patch before writing it
+            apply(source, patch)
+
+            with open(args.patch, 'wb') as f:
+                f.write(patch)
+
+            print(f'{args.patch}: {len(patch)} bytes, '
+                  f'{100 * len(patch) / len(target):.1f}% of {len(target)} bytes image')
+        else:
+            with open(args.patch, 'rb') as f:
+                patch = f.read()
+
+            target = apply(source, patch)
+
+            with open(args.target, 'wb') as f:
+                f.write(target)
+    except PatchError as e:
+        sys.exit(f'ERROR: {e}')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Host build of the coredump memory compressor: compresses the data read
+ * from stdin as a single memory region, and writes the stream to stdout.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Stand-ins for the Zephyr headers used by the compressor */
+#define ZEPHYR_INCLUDE_DEBUG_COREDUMP_H_
+#define ZEPHYR_INCLUDE_SYS_BYTEORDER_H_
+#define ZEPHYR_INCLUDE_SYS_UTIL_H_
+#define ZEPHYR_INCLUDE_TOOLCHAIN_H_
+
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#define BIT(n) (1UL << (n))
+#define IS_POWER_OF_TWO(x) (((x) != 0U) && (((x) & ((x) - 1U)) == 0U))
+#define BUILD_ASSERT(expr, msg) _Static_assert(expr, msg)
+#define UINT_TO_POINTER(x) ((void *)(uintptr_t)(x))
+
+static inline uint32_t sys_get_le32(const uint8_t src[4])
+{
+	return src[0] | (src[1] << 8) | (src[2] << 16) | ((uint32_t)src[3] << 24);
+}
+
+static inline void sys_put_le16(uint16_t val, uint8_t dst[2])
+{
+	dst[0] = val & 0xff;
+	dst[1] = val >> 8;
+}
+
+void coredump_buffer_output(uint8_t *buf, size_t buflen)
+{
+	fwrite(buf, 1, buflen, stdout);
+}
+
+#include "coredump_compress.c"
+
+int main(void)
+{
+	size_t cap = 1 << 16;
+	size_t len = 0;
+	uint8_t *data = malloc(cap);
+	size_t n;
+
+	while (data != NULL && (n = fread(data + len, 1, cap - len, stdin)) > 0) {
+		len += n;
+		if (len == cap) {
+			cap *= 2;
+			data = realloc(data, cap);
+		}
+	}
+
+	if (data == NULL) {
+		return 1;
+	}
+
+	z_coredump_compress_memory((uintptr_t)data, len);
+	free(data);
+
+	return 0;
+}
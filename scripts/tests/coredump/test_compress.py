@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+# Copyright (c) 2024 The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+"""
+Round trip tests of the coredump memory compressor, built for the host,
+and of the decompressor of the coredump parser.
+"""
+
+import io
+import os
+import random
+import shutil
+import subprocess
+import sys
+
+import pytest
+
+ZEPHYR_BASE = os.getenv("ZEPHYR_BASE")
+sys.path.insert(0, os.path.join(ZEPHYR_BASE, "scripts/coredump"))
+
+from coredump_parser.log_parser import decompress_memory
+
+CC = shutil.which("cc") or shutil.which("gcc")
+
+# (window size, hash bits) of the compressor builds
+CONFIGS = [(256, 8), (1024, 10), (32768, 14)]
+
+
+@pytest.fixture(scope="module", params=CONFIGS, ids=lambda c: f"window{c[0]}-hash{c[1]}")
+def compressor(request, tmp_path_factory):
+    if CC is None:
+        pytest.skip("no C compiler")
+
+    window, hash_bits = request.param
+    exe = tmp_path_factory.mktemp("coredump") / f"compress_{window}_{hash_bits}"
+
+    subprocess.run([CC, "-O2", "-o", str(exe),
+                    "-I", os.path.join(ZEPHYR_BASE, "include"),
+                    "-I", os.path.join(ZEPHYR_BASE, "subsys/debug/coredump"),
+                    f"-DCONFIG_DEBUG_COREDUMP_COMPRESS_WINDOW_SIZE={window}",
+                    f"-DCONFIG_DEBUG_COREDUMP_COMPRESS_HASH_BITS={hash_bits}",
+                    os.path.join(os.path.dirname(__file__), "compress_host.c")],
+                   check=True)
+
+    def compress(data):
+        return subprocess.run([str(exe)], input=data, stdout=subprocess.PIPE,
+                              check=True).stdout
+
+    compress.window = window
+    return compress
+
+
+def round_trip(compress, data):
+    stream = compress(data)
+    fd = io.BytesIO(stream)
+
+    assert decompress_memory(fd, len(data)) == data
+    # The stream of a region ends once the region has been produced
+    assert fd.tell() == len(stream)
+
+    return stream
+
+
+def test_empty(compressor):
+    assert round_trip(compressor, b"") == b""
+
+
+def test_random(compressor):
+    data = random.Random(1).randbytes(100000)
+    stream = round_trip(compressor, data)
+
+    # At worst, one token byte for each 128 literal bytes
+    assert len(stream) <= len(data) + -(-len(data) // 128)
+
+
+def test_overlapping_matches(compressor):
+    # Matches at a distance shorter than their length copy their own output
+    for period in (1, 2, 3, 7, 63):
+        data = bytes(range(1, period + 1)) * (5000 // period)
+        stream = round_trip(compressor, data)
+
+        assert len(stream) < len(data) // 2
+
+
+def test_zero_runs(compressor):
+    rng = random.Random(2)
+    head = rng.randbytes(300)
+
+    # Runs longer than the window, and than the longest zero run token
+    for run in (7, 8, 9, compressor.window - 1, compressor.window + 1, 0x4000, 0x4001, 100000):
+        data = head + bytes(run) + head + bytes(run % 13) + b"\x01"
+        round_trip(compressor, data)
+
+    # Nothing but zeros, two bytes for each 16 KiB
+    stream = round_trip(compressor, bytes(0x4000 * 8))
+    assert len(stream) == 2 * 8
+
+
+def test_distance_wrap(compressor):
+    # Regions over 64 KiB, where the positions held by the hash table wrap
+    # around, with data repeated at distances below and beyond the window
+    # and beyond 64 KiB.
+    rng = random.Random(3)
+    block = rng.randbytes(compressor.window // 2 + 17)
+    far = rng.randbytes(4096)
+    data = bytearray()
+
+    while len(data) < 300000:
+        data += block
+        data += rng.randbytes(rng.randrange(1, 3 * compressor.window))
+        if len(data) % 3 == 0:
+            data += far
+
+    round_trip(compressor, bytes(data))
+
+
+def test_truncated_stream(compressor):
+    data = bytes(range(256)) * 40
+    stream = compressor(data)
+
+    assert decompress_memory(io.BytesIO(stream[:-1]), len(data)) is None
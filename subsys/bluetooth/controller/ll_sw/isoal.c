@@ -253,7 +253,8 @@ static void isoal_sink_deallocate(isoal_sink_handle_t hdl)
  * @param group_sync_delay[in]  CIG / BIG sync delay
  * @param sdu_alloc[in]         Callback of SDU allocator
  * @param sdu_emit[in]          Callback of SDU emitter
- * @param sdu_write[in]         Callback of SDU byte writer
+ * @param sdu_write[in]         Callback of SDU byte writer, or NULL to write
+ *                              to the SDU buffer in place
  * @param hdl[out]              Handle to new sink
  *
  * @return ISOAL_STATUS_OK if we could create a new sink; otherwise ISOAL_STATUS_ERR_SINK_ALLOC
@@ -638,6 +639,42 @@ static isoal_status_t isoal_rx_try_emit_sdu(struct isoal_sink *sink, bool end_of
 	return err;
 }
 
+/**
+ * @brief Write PDU payload bytes to the SDU under production
+ * @details Without a sink write callback, the SDU buffer is plain memory and
+ *          the bytes are written to it in place.
+ *
+ * @param sink[in]         Sink with the SDU under production
+ * @param pdu_payload[in]  Source data
+ * @param consume_len[in]  Number of bytes to write
+ *
+ * @return Status
+ */
+static isoal_status_t isoal_rx_sdu_write(const struct isoal_sink *sink,
+					 const uint8_t *pdu_payload,
+					 const size_t consume_len)
+{
+	const struct isoal_sdu_production *sp = &sink->sdu_production;
+	const struct isoal_sdu_produced *sdu = &sp->sdu;
+
+	if (sink->session.sdu_write) {
+		return sink->session.sdu_write(sdu->contents.dbuf,
+					       sp->sdu_written,
+					       pdu_payload,
+					       consume_len);
+	}
+
+	if ((sp->sdu_written + consume_len) > sdu->contents.size) {
+		/* Exceeded SDU buffer */
+		return ISOAL_STATUS_ERR_UNSPECIFIED;
+	}
+
+	(void)memcpy((uint8_t *)sdu->contents.dbuf + sp->sdu_written,
+		     pdu_payload, consume_len);
+
+	return ISOAL_STATUS_OK;
+}
+
 static isoal_status_t isoal_rx_append_to_sdu(struct isoal_sink *sink,
 					     const struct isoal_pdu_rx *pdu_meta,
 					     uint8_t offset,
@@ -691,12 +728,7 @@ static isoal_status_t isoal_rx_append_to_sdu(struct isoal_sink *sink,
 		);
 
 		if (consume_len > 0) {
-			const struct isoal_sink_session *session = &sink->session;
-
-			err |= session->sdu_write(sdu->contents.dbuf,
-						  sp->sdu_written,
-						  pdu_payload,
-						  consume_len);
+			err |= isoal_rx_sdu_write(sink, pdu_payload, consume_len);
 			pdu_payload += consume_len;
 			sp->sdu_written   += consume_len;
 			sp->sdu_available -= consume_len;
@@ -1518,7 +1550,8 @@ static isoal_status_t isoal_check_source_hdl_valid(isoal_source_handle_t hdl)
  * @param stream_sync_delay[in] CIS / BIS sync delay
  * @param group_sync_delay[in]  CIG / BIG sync delay
  * @param pdu_alloc[in]         Callback of PDU allocator
- * @param pdu_write[in]         Callback of PDU byte writer
+ * @param pdu_write[in]         Callback of PDU byte writer, or NULL to write
+ *                              to the PDU payload in place
  * @param pdu_emit[in]          Callback of PDU emitter
  * @param pdu_release[in]       Callback of PDU deallocator
  * @param hdl[out]              Handle to new source
@@ -1727,6 +1760,38 @@ static isoal_status_t isoal_tx_pdu_emit(const struct isoal_source *source_ctx,
 	return status;
 }
 
+/**
+ * Write SDU payload bytes to the PDU under production
+ * Without a source write callback, the bytes are written in place to the
+ * payload of the PDU.
+ * @param[in]  source      ISO-AL source reference
+ * @param[in]  offset      Offset within the PDU payload
+ * @param[in]  sdu_payload Source data
+ * @param[in]  consume_len Number of bytes to write
+ * @return     Error status of operation
+ */
+static isoal_status_t isoal_tx_pdu_write(struct isoal_source *source,
+					 const size_t offset,
+					 const uint8_t *sdu_payload,
+					 const size_t consume_len)
+{
+	struct isoal_pdu_buffer *pdu_buffer = &source->pdu_production.pdu.contents;
+
+	if (source->session.pdu_write) {
+		return source->session.pdu_write(pdu_buffer, offset, sdu_payload,
+						 consume_len);
+	}
+
+	if ((offset + consume_len) > pdu_buffer->size) {
+		/* Exceeded PDU buffer */
+		return ISOAL_STATUS_ERR_UNSPECIFIED;
+	}
+
+	(void)memcpy(&pdu_buffer->pdu->payload[offset], sdu_payload, consume_len);
+
+	return ISOAL_STATUS_OK;
+}
+
 /**
  * Allocates a new PDU only if the previous PDU was emitted
  * @param[in]  source      ISO-AL source reference
@@ -2087,7 +2152,6 @@ static isoal_status_t isoal_tx_unframed_produce(isoal_source_handle_t source_hdl
 	while ((err == ISOAL_STATUS_OK) &&
 		((packet_available > 0) || padding_pdu || zero_length_sdu)) {
 		const isoal_status_t err_alloc = isoal_tx_allocate_pdu(source, tx_sdu);
-		struct isoal_pdu_produced  *pdu = &pp->pdu;
 		err |= err_alloc;
 
 		/*
@@ -2108,10 +2172,8 @@ static isoal_status_t isoal_tx_unframed_produce(isoal_source_handle_t source_hdl
 					zero_length_sdu);
 
 		if (consume_len > 0) {
-			err |= session->pdu_write(&pdu->contents,
-						  pp->pdu_written,
-						  sdu_payload,
-						  consume_len);
+			err |= isoal_tx_pdu_write(source, pp->pdu_written,
+						  sdu_payload, consume_len);
 			sdu_payload       += consume_len;
 			pp->pdu_written   += consume_len;
 			pp->pdu_available -= consume_len;
@@ -2191,16 +2253,12 @@ static isoal_status_t isoal_insert_seg_header_timeoffset(struct isoal_source *so
 							 const bool cmplt,
 							 const uint32_t time_offset)
 {
-	struct isoal_source_session *session;
 	struct isoal_pdu_production *pp;
-	struct isoal_pdu_produced *pdu;
 	struct pdu_iso_sdu_sh seg_hdr;
 	isoal_status_t err;
 	uint8_t write_size;
 
-	session    = &source->session;
 	pp         = &source->pdu_production;
-	pdu        = &pp->pdu;
 	write_size = PDU_ISO_SEG_HDR_SIZE + (sc ? 0 : PDU_ISO_SEG_TIMEOFFSET_SIZE);
 
 	memset(&seg_hdr, 0, sizeof(seg_hdr));
@@ -2231,10 +2289,8 @@ static isoal_status_t isoal_insert_seg_header_timeoffset(struct isoal_source *so
 	 */
 	pp->last_seg_hdr_loc = pp->pdu_written;
 	/* Write to PDU */
-	err = session->pdu_write(&pdu->contents,
-				  pp->pdu_written,
-				  (uint8_t *) &seg_hdr,
-				  write_size);
+	err = isoal_tx_pdu_write(source, pp->pdu_written, (uint8_t *) &seg_hdr,
+				 write_size);
 	pp->pdu_written   += write_size;
 	pp->pdu_available -= write_size;
 
@@ -2263,16 +2319,29 @@ static isoal_status_t isoal_update_seg_header_cmplt_length(struct isoal_source *
 	session    = &source->session;
 	pp         = &source->pdu_production;
 	pdu        = &pp->pdu;
+
+	pp->seg_hdr_length += add_length;
+
+	if (!session->pdu_write) {
+		struct pdu_iso_sdu_sh *pdu_seg_hdr;
+
+		/* Update the segmentation header in place */
+		pdu_seg_hdr = (struct pdu_iso_sdu_sh *)
+			      &pdu->contents.pdu->payload[pp->last_seg_hdr_loc];
+		pdu_seg_hdr->cmplt = cmplt;
+		pdu_seg_hdr->len = pp->seg_hdr_length;
+
+		return ISOAL_STATUS_OK;
+	}
+
 	memset(&seg_hdr, 0, sizeof(seg_hdr));
 
 	seg_hdr.sc = pp->seg_hdr_sc;
 
 	/* Update the complete flag and length */
 	seg_hdr.cmplt = cmplt;
-	pp->seg_hdr_length += add_length;
 	seg_hdr.len = pp->seg_hdr_length;
 
-
 	/* Re-write the segmentation header at the same location */
 	return session->pdu_write(&pdu->contents,
 				  pp->last_seg_hdr_loc,
@@ -2621,7 +2690,6 @@ static isoal_status_t isoal_tx_framed_produce(isoal_source_handle_t source_hdl,
 	while ((err == ISOAL_STATUS_OK) &&
 		((packet_available > 0) || padding_pdu || zero_length_sdu)) {
 		const isoal_status_t err_alloc = isoal_tx_allocate_pdu(source, tx_sdu);
-		struct isoal_pdu_produced  *pdu = &pp->pdu;
 
 		err |= err_alloc;
 
@@ -2661,10 +2729,8 @@ static isoal_status_t isoal_tx_framed_produce(isoal_source_handle_t source_hdl,
 					zero_length_sdu);
 
 		if (consume_len > 0) {
-			err |= session->pdu_write(&pdu->contents,
-						  pp->pdu_written,
-						  sdu_payload,
-						  consume_len);
+			err |= isoal_tx_pdu_write(source, pp->pdu_written,
+						  sdu_payload, consume_len);
 			sdu_payload       += consume_len;
 			pp->pdu_written   += consume_len;
 			pp->pdu_available -= consume_len;
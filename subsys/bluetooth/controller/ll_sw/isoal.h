@@ -238,6 +238,9 @@ typedef isoal_status_t (*isoal_sink_sdu_emit_cb)(
 
 /**
  * @brief  Callback: Write a number of bytes to SDU buffer
+ *
+ * Optional. Without it, the SDU buffer provided at allocation is plain
+ * memory of the given size, and PDU payload bytes are written to it in place.
  */
 typedef isoal_status_t (*isoal_sink_sdu_write_cb)(
 	/*!< [in]  Destination buffer */
@@ -340,6 +343,10 @@ typedef isoal_status_t (*isoal_source_pdu_release_cb)(
 
 /**
  * @brief  Callback: Write a number of bytes to PDU buffer
+ *
+ * Optional. Without it, SDU payload bytes are written in place to the payload
+ * of the PDU provided at allocation, and segmentation headers are updated in
+ * place.
  */
 typedef isoal_status_t (*isoal_source_pdu_write_cb)(
 	/*!< [out]  PDU under production */
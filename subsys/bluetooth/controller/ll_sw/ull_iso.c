@@ -85,10 +85,6 @@ static int init_reset(void);
 
 #if defined(CONFIG_BT_CTLR_ADV_ISO) || defined(CONFIG_BT_CTLR_CONN_ISO)
 static isoal_status_t ll_iso_pdu_alloc(struct isoal_pdu_buffer *pdu_buffer);
-static isoal_status_t ll_iso_pdu_write(struct isoal_pdu_buffer *pdu_buffer,
-				       const size_t   offset,
-				       const uint8_t *sdu_payload,
-				       const size_t   consume_len);
 static isoal_status_t ll_iso_pdu_emit(struct node_tx_iso *node_tx,
 				      const uint16_t handle);
 static isoal_status_t ll_iso_pdu_release(struct node_tx_iso *node_tx,
@@ -479,9 +475,10 @@ uint8_t ll_setup_iso_path(uint16_t handle, uint8_t path_dir, uint8_t path_id,
 		} else {
 			/* Set default callbacks when not vendor specific
 			 * or that the vendor specific path is the same.
+			 * SDU data is written by ISO-AL in place to the PDUs.
 			 */
 			pdu_alloc   = ll_iso_pdu_alloc;
-			pdu_write   = ll_iso_pdu_write;
+			pdu_write   = NULL;
 			pdu_emit    = ll_iso_pdu_emit;
 			pdu_release = ll_iso_pdu_release;
 		}
@@ -1259,7 +1256,7 @@ uint8_t ll_iso_transmit_test(uint16_t handle, uint8_t payload_type)
 					  cis->lll.tx.max_pdu, sdu_interval,
 					  cig->iso_interval, cis->sync_delay,
 					  cig->sync_delay, ll_iso_pdu_alloc,
-					  ll_iso_pdu_write, ll_iso_pdu_emit,
+					  NULL, ll_iso_pdu_emit,
 					  ll_iso_test_pdu_release,
 					  &source_handle);
 
@@ -1794,37 +1791,6 @@ static isoal_status_t ll_iso_pdu_alloc(struct isoal_pdu_buffer *pdu_buffer)
 	return ISOAL_STATUS_OK;
 }
 
-/**
- * Write the given SDU payload to the target PDU buffer at the given offset.
- * @param[in,out]  pdu_buffer  Target PDU buffer
- * @param[in]      pdu_offset  Offset / current write position within PDU
- * @param[in]      sdu_payload Location of source data
- * @param[in]      consume_len Length of data to copy
- * @return         Error status of write operation
- */
-static isoal_status_t ll_iso_pdu_write(struct isoal_pdu_buffer *pdu_buffer,
-				       const size_t  pdu_offset,
-				       const uint8_t *sdu_payload,
-				       const size_t  consume_len)
-{
-	ARG_UNUSED(pdu_offset);
-	ARG_UNUSED(consume_len);
-
-	LL_ASSERT(pdu_buffer);
-	LL_ASSERT(pdu_buffer->pdu);
-	LL_ASSERT(sdu_payload);
-
-	if ((pdu_offset + consume_len) > pdu_buffer->size) {
-		/* Exceeded PDU buffer */
-		return ISOAL_STATUS_ERR_UNSPECIFIED;
-	}
-
-	/* Copy source to destination at given offset */
-	memcpy(&pdu_buffer->pdu->payload[pdu_offset], sdu_payload, consume_len);
-
-	return ISOAL_STATUS_OK;
-}
-
 /**
  * Emit the encoded node to the transmission queue
  * @param node_tx TX node to enqueue
@@ -22,6 +22,13 @@
  ****************************************************************************/
 #define DOUBLE_BUFFER_SIZE 2
 
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+/* Number of express lanes indexing the ticker node list, each lane linking
+ * about a quarter of the nodes of the lane below.
+ */
+#define TICKER_SKIP_LEVELS 3
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
+
 #if defined(CONFIG_BT_TICKER_EXT_EXPIRE_INFO)
 #if !defined(CONFIG_BT_CTLR_ADV_AUX_SET)
 #define BT_CTLR_ADV_AUX_SET 0
@@ -97,6 +104,18 @@ struct ticker_node {
 #if  defined(CONFIG_BT_TICKER_EXT)
 	struct ticker_ext *ext_data;	    /* Ticker extension data */
 #endif /* CONFIG_BT_TICKER_EXT */
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+	uint32_t skip_ticks[TICKER_SKIP_LEVELS]; /* Ticks from this node to
+						  * the next one in each
+						  * express lane
+						  */
+	uint8_t  skip_next[TICKER_SKIP_LEVELS];  /* Next node in each express
+						  * lane
+						  */
+	uint8_t  skip_level;		    /* Number of express lanes the
+					     * node is linked in
+					     */
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
 #if !defined(CONFIG_BT_TICKER_LOW_LAT) && \
 	!defined(CONFIG_BT_TICKER_SLOT_AGNOSTIC)
 	uint8_t  must_expire;		    /* Node must expire, even if it
@@ -299,6 +318,16 @@ struct ticker_instance {
 	uint8_t  ticker_id_head;	/* Index of first ticker node (next to
 					 * expire)
 					 */
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+	uint8_t  skip_head[TICKER_SKIP_LEVELS]; /* First node of each express
+						 * lane
+						 */
+	uint32_t skip_head_ticks[TICKER_SKIP_LEVELS]; /* Ticks to expire of
+						       * the first node of
+						       * each express lane
+						       */
+	uint32_t skip_seed;		/* Express lane level generator state */
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
 	uint8_t  job_guard;		/* Flag preventing ticker_worker from
 					 * running if ticker_job is active
 					 */
@@ -541,12 +570,269 @@ static void ticker_by_next_slot_get(struct ticker_instance *instance,
 }
 #endif /* CONFIG_BT_TICKER_NEXT_SLOT_GET */
 
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+/**
+ * @brief Draw express lane level
+ *
+ * @details Returns the number of express lanes a ticker node being enqueued
+ * is linked in. A node is promoted to each next lane with a probability of
+ * 1/4.
+ *
+ * @param instance Pointer to ticker instance
+ *
+ * @return Number of express lanes
+ * @internal
+ */
+static uint8_t ticker_skip_level_draw(struct ticker_instance *instance)
+{
+	uint32_t rand;
+	uint8_t level;
+
+	instance->skip_seed = (instance->skip_seed * 1103515245U) + 12345U;
+	rand = instance->skip_seed >> 16;
+
+	level = 0U;
+	while ((level < TICKER_SKIP_LEVELS) && ((rand & 0x03) == 0U)) {
+		rand >>= 2;
+		level++;
+	}
+
+	return level;
+}
+
+/**
+ * @brief Search express lanes
+ *
+ * @details Walks down the express lanes to find, in each lane, the last
+ * node expiring strictly before ticks_to_expire. Nodes expiring in the same
+ * tick are left to the linear search in ticker_enqueue, which orders them
+ * by latency.
+ *
+ * @param instance        Pointer to ticker instance
+ * @param ticks_to_expire Ticks to expire of the node to enqueue, updated
+ *                        relative to the returned node
+ * @param prev            Last node of each lane before the new node
+ * @param offset          Ticks from each node in prev to the new node
+ *
+ * @return Id of the node to resume linear search from, or TICKER_NULL to
+ * start from the head
+ * @internal
+ */
+static uint8_t ticker_skip_search(struct ticker_instance *instance,
+				  uint32_t *ticks_to_expire, uint8_t *prev,
+				  uint32_t *offset)
+{
+	struct ticker_node *node;
+	uint8_t previous;
+	uint32_t ticks;
+	uint8_t level;
+
+	node = &instance->nodes[0];
+	ticks = *ticks_to_expire;
+	previous = TICKER_NULL;
+	level = TICKER_SKIP_LEVELS;
+
+	while (level--) {
+		uint32_t ticks_span;
+		uint8_t next;
+
+		if (previous == TICKER_NULL) {
+			next = instance->skip_head[level];
+			ticks_span = instance->skip_head_ticks[level];
+		} else {
+			next = node[previous].skip_next[level];
+			ticks_span = node[previous].skip_ticks[level];
+		}
+
+		while ((next != TICKER_NULL) && (ticks > ticks_span)) {
+			ticks -= ticks_span;
+			previous = next;
+			next = node[previous].skip_next[level];
+			ticks_span = node[previous].skip_ticks[level];
+		}
+
+		prev[level] = previous;
+		offset[level] = ticks;
+	}
+
+	*ticks_to_expire = ticks;
+
+	return previous;
+}
+
+/**
+ * @brief Link ticker node in express lanes
+ *
+ * @param instance Pointer to ticker instance
+ * @param id       Ticker node id, already linked in the node list
+ * @param prev     Last node of each lane before the new node
+ * @param offset   Ticks from each node in prev to the new node
+ * @internal
+ */
+static void ticker_skip_link(struct ticker_instance *instance, uint8_t id,
+			     const uint8_t *prev, const uint32_t *offset)
+{
+	struct ticker_node *ticker;
+	struct ticker_node *node;
+	uint8_t level;
+
+	node = &instance->nodes[0];
+	ticker = &node[id];
+	ticker->skip_level = ticker_skip_level_draw(instance);
+
+	for (level = 0U; level < ticker->skip_level; level++) {
+		uint32_t *ticks_span;
+		uint8_t *next;
+
+		if (prev[level] == TICKER_NULL) {
+			next = &instance->skip_head[level];
+			ticks_span = &instance->skip_head_ticks[level];
+		} else {
+			next = &node[prev[level]].skip_next[level];
+			ticks_span = &node[prev[level]].skip_ticks[level];
+		}
+
+		ticker->skip_next[level] = *next;
+		ticker->skip_ticks[level] = *ticks_span - offset[level];
+
+		*next = id;
+		*ticks_span = offset[level];
+	}
+}
+
+/**
+ * @brief Unlink ticker node from express lanes
+ *
+ * @param instance Pointer to ticker instance
+ * @param id       Ticker node id
+ * @param prev     Last node of each lane before the node
+ * @internal
+ */
+static void ticker_skip_unlink(struct ticker_instance *instance, uint8_t id,
+			       const uint8_t *prev)
+{
+	struct ticker_node *ticker;
+	struct ticker_node *node;
+	uint8_t level;
+
+	node = &instance->nodes[0];
+	ticker = &node[id];
+
+	for (level = 0U; level < ticker->skip_level; level++) {
+		if (prev[level] == TICKER_NULL) {
+			instance->skip_head[level] = ticker->skip_next[level];
+			instance->skip_head_ticks[level] +=
+				ticker->skip_ticks[level];
+		} else {
+			node[prev[level]].skip_next[level] =
+				ticker->skip_next[level];
+			node[prev[level]].skip_ticks[level] +=
+				ticker->skip_ticks[level];
+		}
+	}
+
+	ticker->skip_level = 0U;
+}
+
+/**
+ * @brief Advance express lanes
+ *
+ * @details Accounts for ticks elapsed at the head of the node list, and
+ * unlinks the head node if it expired.
+ *
+ * @param instance Pointer to ticker instance
+ * @param id_head  Id of expired head node, already removed from the node
+ *                 list, or TICKER_NULL
+ * @param ticks    Ticks elapsed
+ * @internal
+ */
+static void ticker_skip_advance(struct ticker_instance *instance,
+				uint8_t id_head, uint32_t ticks)
+{
+	uint8_t level;
+
+	for (level = 0U; level < TICKER_SKIP_LEVELS; level++) {
+		if (instance->skip_head[level] == TICKER_NULL) {
+			continue;
+		}
+
+		if (instance->skip_head[level] == id_head) {
+			struct ticker_node *ticker;
+
+			ticker = &instance->nodes[id_head];
+			instance->skip_head[level] = ticker->skip_next[level];
+			instance->skip_head_ticks[level] =
+				ticker->skip_ticks[level];
+		} else {
+			instance->skip_head_ticks[level] -= ticks;
+		}
+	}
+
+	if (id_head != TICKER_NULL) {
+		instance->nodes[id_head].skip_level = 0U;
+	}
+}
+
+/**
+ * @brief Rebuild express lanes
+ *
+ * @details Relinks the express lanes from the node list, keeping the level
+ * of each node. Used when nodes are moved in the list in place.
+ *
+ * @param instance Pointer to ticker instance
+ * @internal
+ */
+static void ticker_skip_rebuild(struct ticker_instance *instance)
+{
+	uint32_t ticks[TICKER_SKIP_LEVELS];
+	uint8_t prev[TICKER_SKIP_LEVELS];
+	struct ticker_node *node;
+	uint8_t current;
+	uint8_t level;
+
+	node = &instance->nodes[0];
+
+	for (level = 0U; level < TICKER_SKIP_LEVELS; level++) {
+		instance->skip_head[level] = TICKER_NULL;
+		prev[level] = TICKER_NULL;
+		ticks[level] = 0U;
+	}
+
+	current = instance->ticker_id_head;
+	while (current != TICKER_NULL) {
+		struct ticker_node *ticker = &node[current];
+
+		for (level = 0U; level < TICKER_SKIP_LEVELS; level++) {
+			ticks[level] += ticker->ticks_to_expire;
+		}
+
+		for (level = 0U; level < ticker->skip_level; level++) {
+			if (prev[level] == TICKER_NULL) {
+				instance->skip_head[level] = current;
+				instance->skip_head_ticks[level] = ticks[level];
+			} else {
+				node[prev[level]].skip_next[level] = current;
+				node[prev[level]].skip_ticks[level] =
+					ticks[level];
+			}
+
+			ticker->skip_next[level] = TICKER_NULL;
+			prev[level] = current;
+			ticks[level] = 0U;
+		}
+
+		current = ticker->next;
+	}
+}
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
+
 #if !defined(CONFIG_BT_TICKER_LOW_LAT)
 /**
  * @brief Enqueue ticker node
  *
  * @details Finds insertion point for new ticker node and inserts the
- * node in the linked node list.
+ * node in the linked node list. With CONFIG_BT_TICKER_SKIP_LIST, the
+ * express lanes are searched first, leaving only a few nodes to walk.
  *
  * @param instance Pointer to ticker instance
  * @param id       Ticker node id to enqueue
@@ -574,6 +860,17 @@ static uint8_t ticker_enqueue(struct ticker_instance *instance, uint8_t id)
 	 */
 	previous = TICKER_NULL;
 
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+	uint32_t skip_offset[TICKER_SKIP_LEVELS];
+	uint8_t skip_prev[TICKER_SKIP_LEVELS];
+
+	previous = ticker_skip_search(instance, &ticks_to_expire, skip_prev,
+				      skip_offset);
+	if (previous != TICKER_NULL) {
+		current = node[previous].next;
+	}
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
+
 	while ((current != TICKER_NULL) && (ticks_to_expire >=
 		(ticks_to_expire_current =
 		(ticker_current = &node[current])->ticks_to_expire))) {
@@ -589,6 +886,14 @@ static uint8_t ticker_enqueue(struct ticker_instance *instance, uint8_t id)
 			break;
 		}
 
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+		for (uint8_t level = 0U; level < ticker_current->skip_level;
+		     level++) {
+			skip_prev[level] = current;
+			skip_offset[level] = ticks_to_expire;
+		}
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
+
 		previous = current;
 		current = ticker_current->next;
 	}
@@ -608,6 +913,10 @@ static uint8_t ticker_enqueue(struct ticker_instance *instance, uint8_t id)
 		node[current].ticks_to_expire -= ticks_to_expire;
 	}
 
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+	ticker_skip_link(instance, id, skip_prev, skip_offset);
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
+
 	return id;
 }
 #else /* CONFIG_BT_TICKER_LOW_LAT */
@@ -740,6 +1049,15 @@ static uint32_t ticker_dequeue(struct ticker_instance *instance, uint8_t id)
 	current = previous;
 	total = 0U;
 	ticker_current = 0;
+
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+	uint8_t skip_prev[TICKER_SKIP_LEVELS];
+
+	for (uint8_t level = 0U; level < TICKER_SKIP_LEVELS; level++) {
+		skip_prev[level] = TICKER_NULL;
+	}
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
+
 	while (current != TICKER_NULL) {
 		ticker_current = &node[current];
 
@@ -747,6 +1065,13 @@ static uint32_t ticker_dequeue(struct ticker_instance *instance, uint8_t id)
 			break;
 		}
 
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+		for (uint8_t level = 0U; level < ticker_current->skip_level;
+		     level++) {
+			skip_prev[level] = current;
+		}
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
+
 		total += ticker_current->ticks_to_expire;
 		previous = current;
 		current = ticker_current->next;
@@ -777,6 +1102,10 @@ static uint32_t ticker_dequeue(struct ticker_instance *instance, uint8_t id)
 		node[ticker_current->next].ticks_to_expire += timeout;
 	}
 
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+	ticker_skip_unlink(instance, id, skip_prev);
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
+
 	return (total + timeout);
 }
 
@@ -2053,6 +2382,12 @@ static inline void ticker_job_worker_bh(struct ticker_instance *instance,
 		ticks_to_expire = ticker->ticks_to_expire;
 		if (ticks_elapsed < ticks_to_expire) {
 			ticker->ticks_to_expire -= ticks_elapsed;
+
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+			ticker_skip_advance(instance, TICKER_NULL,
+					    ticks_elapsed);
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
+
 			break;
 		}
 
@@ -2108,6 +2443,10 @@ static inline void ticker_job_worker_bh(struct ticker_instance *instance,
 		/* remove the expired ticker from head */
 		instance->ticker_id_head = ticker->next;
 
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+		ticker_skip_advance(instance, id_expired, ticks_to_expire);
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
+
 		/* Ticker will be restarted if periodic or to be re-scheduled */
 		if ((ticker->ticks_periodic != 0U) ||
 		    TICKER_RESCHEDULE_PENDING(ticker)) {
@@ -2610,6 +2949,11 @@ static uint8_t ticker_job_reschedule_in_window(struct ticker_instance *instance,
 			nodes[ticker_id_prev].next = ticker_id_resched;
 		}
 
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+		/* Node was moved in place, relink the express lanes */
+		ticker_skip_rebuild(instance);
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
+
 		/* Remove latency added in ticker_worker */
 		ticker_resched->lazy_current--;
 
@@ -3318,6 +3662,13 @@ uint8_t ticker_init(uint8_t instance_index, uint8_t count_node, void *node,
 
 	instance->ticker_id_head = TICKER_NULL;
 	instance->ticks_current = cntr_cnt_get();
+
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+	for (int i = 0; i < TICKER_SKIP_LEVELS; i++) {
+		instance->skip_head[i] = TICKER_NULL;
+	}
+	instance->skip_seed = instance->ticks_current;
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
 	instance->ticks_elapsed_first = 0U;
 	instance->ticks_elapsed_last = 0U;
 
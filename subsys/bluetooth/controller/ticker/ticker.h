@@ -35,23 +35,31 @@
  * @}
  */
 
+/** \brief Timer node express lanes size.
+ */
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+#define TICKER_NODE_SKIP_T_SIZE 16
+#else /* !CONFIG_BT_TICKER_SKIP_LIST */
+#define TICKER_NODE_SKIP_T_SIZE 0
+#endif /* !CONFIG_BT_TICKER_SKIP_LIST */
+
 /** \brief Timer node type size.
  */
 #if defined(CONFIG_BT_TICKER_EXT)
 #if defined(CONFIG_BT_TICKER_SLOT_AGNOSTIC)
-#define TICKER_NODE_T_SIZE      40
+#define TICKER_NODE_T_SIZE      (40 + TICKER_NODE_SKIP_T_SIZE)
 #elif defined(CONFIG_BT_TICKER_LOW_LAT)
 #define TICKER_NODE_T_SIZE      44
 #else
-#define TICKER_NODE_T_SIZE      48
+#define TICKER_NODE_T_SIZE      (48 + TICKER_NODE_SKIP_T_SIZE)
 #endif /* CONFIG_BT_TICKER_SLOT_AGNOSTIC */
 #else /* CONFIG_BT_TICKER_EXT */
 #if defined(CONFIG_BT_TICKER_SLOT_AGNOSTIC)
-#define TICKER_NODE_T_SIZE      36
+#define TICKER_NODE_T_SIZE      (36 + TICKER_NODE_SKIP_T_SIZE)
 #elif defined(CONFIG_BT_TICKER_LOW_LAT)
 #define TICKER_NODE_T_SIZE      40
 #else
-#define TICKER_NODE_T_SIZE      44
+#define TICKER_NODE_T_SIZE      (44 + TICKER_NODE_SKIP_T_SIZE)
 #endif /* CONFIG_BT_TICKER_SLOT_AGNOSTIC */
 #endif /* CONFIG_BT_TICKER_EXT */
 
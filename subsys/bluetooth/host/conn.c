@@ -255,8 +255,7 @@ static void tx_free(struct bt_conn_tx *tx)
 #if defined(CONFIG_BT_CONN_TX)
 static void tx_notify(struct bt_conn *conn)
 {
-	__ASSERT_NO_MSG(k_current_get() ==
-			k_work_queue_thread_get(&k_sys_work_q));
+	__ASSERT_NO_MSG(k_work_queue_is_current(&k_sys_work_q));
 
 	LOG_DBG("conn %p", conn);
 
@@ -432,7 +431,7 @@ static void wait_for_tx_work(struct bt_conn *conn)
 	LOG_DBG("conn %p", conn);
 
 	if (IS_ENABLED(CONFIG_BT_RECV_WORKQ_SYS) ||
-	    k_current_get() == k_work_queue_thread_get(&k_sys_work_q)) {
+	    k_work_queue_is_current(&k_sys_work_q)) {
 		tx_notify(conn);
 	} else {
 		struct k_work_sync sync;
@@ -781,6 +780,17 @@ static bool should_stop_tx(struct bt_conn *conn)
 		return true;
 	}
 
+#if defined(CONFIG_BT_CONN_TX_SCHED_DRR)
+	/* Yield to the next connection if the deficit cannot cover another
+	 * full fragment after this one.
+	 */
+	if (is_acl_conn(conn) &&
+	    (conn->tx_deficit - (int32_t)conn_mtu(conn)) <= 0) {
+		LOG_DBG("%p used its turn", conn);
+		return true;
+	}
+#endif /* CONFIG_BT_CONN_TX_SCHED_DRR */
+
 	/* Queue only 3 buffers per-conn for now */
 	if (atomic_get(&conn->in_ll) < 3) {
 		/* The goal of this heuristic is to allow the link-layer to
@@ -839,6 +849,66 @@ static bool dont_have_viewbufs(void)
 #endif	/* CONFIG_BT_CONN_TX */
 }
 
+/* Deficit round-robin: a connection reaching the head of the TX queue is
+ * credited with a quantum of bytes. If that is not enough to cover what it
+ * sent in excess during its previous turn, it is skipped.
+ */
+static bool out_of_turn(struct bt_conn *conn)
+{
+#if defined(CONFIG_BT_CONN_TX_SCHED_DRR)
+	if (!is_acl_conn(conn) || conn->tx_deficit > 0) {
+		return false;
+	}
+
+	conn->tx_deficit += CONFIG_BT_CONN_TX_SCHED_QUANTUM;
+
+	return conn->tx_deficit <= 0;
+#else
+	return false;
+#endif /* CONFIG_BT_CONN_TX_SCHED_DRR */
+}
+
+static void tx_charge(struct bt_conn *conn, size_t len)
+{
+#if defined(CONFIG_BT_CONN_TX_SCHED_DRR)
+	conn->tx_deficit -= len;
+#endif /* CONFIG_BT_CONN_TX_SCHED_DRR */
+
+#if defined(CONFIG_BT_CONN_TX_STATS)
+	conn->tx_stats.bytes += len;
+	conn->tx_stats.frags++;
+#endif /* CONFIG_BT_CONN_TX_STATS */
+}
+
+static void tx_idle(struct bt_conn *conn)
+{
+#if defined(CONFIG_BT_CONN_TX_SCHED_DRR)
+	/* Credit is not kept while the connection has nothing to send */
+	conn->tx_deficit = 0;
+#endif /* CONFIG_BT_CONN_TX_SCHED_DRR */
+}
+
+static void move_to_back(struct bt_conn *conn)
+{
+	__maybe_unused sys_snode_t *s = sys_slist_get(&bt_dev.le.conn_ready);
+
+	__ASSERT_NO_MSG(s == &conn->_conn_ready);
+
+	(void)atomic_set(&conn->_conn_ready_lock, 0);
+	/* Note: we can't assert `old` is non-NULL here, as the
+	 * connection might have been marked ready by an l2cap channel
+	 * that cancelled its request to send.
+	 */
+
+	/* Append connection to list if it still has data */
+	if (conn->has_data(conn)) {
+		LOG_DBG("appending %p to back of TX queue", conn);
+		bt_conn_data_ready(conn);
+	} else {
+		tx_idle(conn);
+	}
+}
+
 static bool dont_have_methods(struct bt_conn *conn)
 {
 	return (conn->tx_data_pull == NULL) ||
@@ -859,6 +929,18 @@ struct bt_conn *get_conn_ready(void)
 
 	struct bt_conn *conn = CONTAINER_OF(node, struct bt_conn, _conn_ready);
 
+	while (out_of_turn(conn)) {
+		LOG_DBG("%p skips its turn", conn);
+		move_to_back(conn);
+
+		node = sys_slist_peek_head(&bt_dev.le.conn_ready);
+		if (node == NULL) {
+			return NULL;
+		}
+
+		conn = CONTAINER_OF(node, struct bt_conn, _conn_ready);
+	}
+
 	if (dont_have_viewbufs()) {
 		/* We will get scheduled again when the (view) buffers are freed. If you
 		 * hit this a lot, try increasing `CONFIG_BT_CONN_FRAG_COUNT`
@@ -887,21 +969,7 @@ struct bt_conn *get_conn_ready(void)
 	}
 
 	if (should_stop_tx(conn)) {
-		__maybe_unused sys_snode_t *s = sys_slist_get(&bt_dev.le.conn_ready);
-
-		__ASSERT_NO_MSG(s == node);
-
-		(void)atomic_set(&conn->_conn_ready_lock, 0);
-		/* Note: we can't assert `old` is non-NULL here, as the
-		 * connection might have been marked ready by an l2cap channel
-		 * that cancelled its request to send.
-		 */
-
-		/* Append connection to list if it still has data */
-		if (conn->has_data(conn)) {
-			LOG_DBG("appending %p to back of TX queue", conn);
-			bt_conn_data_ready(conn);
-		}
+		move_to_back(conn);
 	}
 
 	return conn;
@@ -957,29 +1025,20 @@ void bt_conn_suspend_tx(bool suspend)
 }
 #endif	/* CONFIG_BT_TESTING */
 
-void bt_conn_tx_processor(void)
+/* Returns true if a fragment has been sent to the controller */
+static bool tx_process_one(void)
 {
-	LOG_DBG("start");
 	struct bt_conn *conn;
 	struct net_buf *buf;
 	bt_conn_tx_cb_t cb = NULL;
 	size_t buf_len;
 	void *ud = NULL;
 
-	if (!IS_ENABLED(CONFIG_BT_CONN_TX)) {
-		/* Mom, can we have a real compiler? */
-		return;
-	}
-
-	if (IS_ENABLED(CONFIG_BT_TESTING) && _suspend_tx) {
-		return;
-	}
-
 	conn = get_conn_ready();
 
 	if (!conn) {
 		LOG_DBG("no connection wants to do stuff");
-		return;
+		return false;
 	}
 
 	LOG_DBG("processing conn %p", conn);
@@ -994,7 +1053,7 @@ void bt_conn_tx_processor(void)
 			destroy_and_callback(conn, buf, cb, ud);
 			buf = conn->tx_data_pull(conn, SIZE_MAX, &buf_len);
 		}
-		return;
+		return false;
 	}
 
 	/* now that we are guaranteed resources, we can pull data from the upper
@@ -1008,7 +1067,7 @@ void bt_conn_tx_processor(void)
 		 * the upper layer when it has more data.
 		 */
 		LOG_DBG("no buf returned");
-		return;
+		return false;
 	}
 
 	bool last_buf = conn_mtu(conn) >= buf_len;
@@ -1044,9 +1103,33 @@ void bt_conn_tx_processor(void)
 		destroy_and_callback(conn, buf, cb, ud);
 		bt_conn_disconnect(conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
 
+		return false;
+	}
+
+	tx_charge(conn, MIN(conn_mtu(conn), buf_len));
+
+	return true;
+}
+
+void bt_conn_tx_processor(void)
+{
+	LOG_DBG("start");
+
+	if (!IS_ENABLED(CONFIG_BT_CONN_TX)) {
+		/* Mom, can we have a real compiler? */
 		return;
 	}
 
+	for (int i = 0; i < CONFIG_BT_CONN_TX_BATCH; i++) {
+		if (IS_ENABLED(CONFIG_BT_TESTING) && _suspend_tx) {
+			return;
+		}
+
+		if (!tx_process_one()) {
+			return;
+		}
+	}
+
 	/* Always kick the TX work. It will self-suspend if it doesn't get
 	 * resources or there is nothing left to send.
 	 */
@@ -1156,6 +1239,12 @@ void bt_conn_set_state(struct bt_conn *conn, bt_conn_state_t state)
 			break;
 		}
 
+#if defined(CONFIG_BT_CONN_TX_STATS)
+		conn->tx_stats.bytes = 0U;
+		conn->tx_stats.frags = 0U;
+		conn->tx_stats.since = k_uptime_get();
+#endif /* CONFIG_BT_CONN_TX_STATS */
+
 #if defined(CONFIG_BT_CONN)
 		sys_slist_init(&conn->channels);
 
@@ -1510,7 +1599,7 @@ struct net_buf *bt_conn_create_pdu_timeout(struct net_buf_pool *pool,
 	__ASSERT_NO_MSG(!k_is_in_isr());
 
 	if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT) &&
-	    k_current_get() == k_work_queue_thread_get(&k_sys_work_q)) {
+	    k_work_queue_is_current(&k_sys_work_q)) {
 		LOG_DBG("Timeout discarded. No blocking in syswq.");
 		timeout = K_NO_WAIT;
 	}
@@ -2662,6 +2751,25 @@ const bt_addr_le_t *bt_conn_get_dst(const struct bt_conn *conn)
 	return &conn->le.dst;
 }
 
+#if defined(CONFIG_BT_CONN_TX_STATS)
+int bt_conn_get_tx_stats(const struct bt_conn *conn, struct bt_conn_tx_stats *stats)
+{
+	if (conn->state != BT_CONN_CONNECTED) {
+		return -ENOTCONN;
+	}
+
+	/* The counters are updated by the TX processor without locking, they
+	 * are only meant for monitoring.
+	 */
+	stats->bytes = conn->tx_stats.bytes;
+	stats->frags = conn->tx_stats.frags;
+	stats->elapsed_ms = (uint32_t)(k_uptime_get() - conn->tx_stats.since);
+	stats->in_ll = (uint16_t)atomic_get(&conn->in_ll);
+
+	return 0;
+}
+#endif /* CONFIG_BT_CONN_TX_STATS */
+
 static enum bt_conn_state conn_internal_to_public_state(bt_conn_state_t state)
 {
 	switch (state) {
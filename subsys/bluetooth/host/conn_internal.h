@@ -191,6 +191,11 @@ struct acl_data {
 
 	/** ACL connection handle */
 	uint16_t handle;
+
+#if defined(CONFIG_BT_L2CAP_RX_SDU_CHAIN)
+	/* Held as a segment of a received L2CAP SDU */
+	bool l2cap_chained;
+#endif
 };
 
 struct bt_conn {
@@ -303,6 +308,21 @@ struct bt_conn {
 	/* Next buffer should be an ACL/ISO HCI fragment */
 	bool			next_is_frag;
 
+#if defined(CONFIG_BT_CONN_TX_SCHED_DRR)
+	/* Number of bytes the connection may still send before yielding to
+	 * the next connection in the TX queue.
+	 */
+	int32_t			tx_deficit;
+#endif /* CONFIG_BT_CONN_TX_SCHED_DRR */
+
+#if defined(CONFIG_BT_CONN_TX_STATS)
+	struct {
+		uint32_t	bytes;
+		uint32_t	frags;
+		int64_t		since;
+	} tx_stats;
+#endif /* CONFIG_BT_CONN_TX_STATS */
+
 	/* Must be at the end so that everything else in the structure can be
 	 * memset to zero without affecting the ref.
 	 */
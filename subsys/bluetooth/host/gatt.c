@@ -90,6 +90,31 @@ static sys_slist_t callback_list = SYS_SLIST_STATIC_INIT(&callback_list);
 static sys_slist_t db;
 #endif /* CONFIG_BT_GATT_DYNAMIC_DB */
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+/* Attributes by handle, entry 0 holding handle 0x0001 */
+static const struct bt_gatt_attr *attr_index[CONFIG_BT_GATT_ATTR_INDEX_SIZE];
+static uint16_t attr_index_last;
+/* Set if some attributes have a handle too large for the index */
+static bool attr_index_overflow;
+static bool attr_index_valid;
+
+/* Attribute types looked up by ATT discovery procedures */
+static const uint16_t type_index_uuids[] = {
+	BT_UUID_GATT_PRIMARY_VAL,
+	BT_UUID_GATT_SECONDARY_VAL,
+	BT_UUID_GATT_INCLUDE_VAL,
+	BT_UUID_GATT_CHRC_VAL,
+	BT_UUID_GATT_CCC_VAL,
+};
+
+/* Handles of the attributes of each indexed type, in ascending order, the
+ * ones of type i being stored from type_index_start[i] up to
+ * type_index_start[i + 1].
+ */
+static uint16_t type_index[CONFIG_BT_GATT_ATTR_INDEX_SIZE];
+static uint16_t type_index_start[ARRAY_SIZE(type_index_uuids) + 1];
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 enum gatt_global_flags {
 	GATT_INITIALIZED,
 	GATT_SERVICE_INITIALIZED,
@@ -1530,6 +1555,55 @@ static void gatt_store_ccc_cf(uint8_t id, const bt_addr_le_t *peer_addr)
 	}
 }
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+static uint8_t attr_index_add(const struct bt_gatt_attr *attr, uint16_t handle,
+			      void *user_data)
+{
+	if (handle > ARRAY_SIZE(attr_index)) {
+		attr_index_overflow = true;
+		return BT_GATT_ITER_CONTINUE;
+	}
+
+	attr_index[handle - 1] = attr;
+	attr_index_last = MAX(attr_index_last, handle);
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+static void attr_index_rebuild(void)
+{
+	uint16_t count = 0;
+
+	/* Walk the database itself rather than the outdated index */
+	attr_index_valid = false;
+	attr_index_overflow = false;
+	attr_index_last = 0;
+	(void)memset(attr_index, 0, sizeof(attr_index));
+
+	bt_gatt_foreach_attr(0x0001, 0xffff, attr_index_add, NULL);
+
+	for (size_t i = 0; i < ARRAY_SIZE(type_index_uuids); i++) {
+		type_index_start[i] = count;
+
+		for (uint16_t handle = 1; handle <= attr_index_last; handle++) {
+			const struct bt_gatt_attr *attr = attr_index[handle - 1];
+
+			if (attr && attr->uuid->type == BT_UUID_TYPE_16 &&
+			    BT_UUID_16(attr->uuid)->val == type_index_uuids[i]) {
+				type_index[count++] = handle;
+			}
+		}
+	}
+
+	type_index_start[ARRAY_SIZE(type_index_uuids)] = count;
+	attr_index_valid = true;
+}
+#else
+static inline void attr_index_rebuild(void)
+{
+}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 static void bt_gatt_service_init(void)
 {
 	if (atomic_test_and_set_bit(gatt_flags, GATT_SERVICE_INITIALIZED)) {
@@ -1539,6 +1613,8 @@ static void bt_gatt_service_init(void)
 	STRUCT_SECTION_FOREACH(bt_gatt_service_static, svc) {
 		last_static_handle += svc->attr_count;
 	}
+
+	attr_index_rebuild();
 }
 
 void bt_gatt_init(void)
@@ -1757,6 +1833,8 @@ int bt_gatt_service_register(struct bt_gatt_service *svc)
 		return err;
 	}
 
+	attr_index_rebuild();
+
 	/* Don't submit any work until the stack is initialized */
 	if (!atomic_test_bit(gatt_flags, GATT_INITIALIZED)) {
 		k_sched_unlock();
@@ -1787,6 +1865,8 @@ int bt_gatt_service_unregister(struct bt_gatt_service *svc)
 		return err;
 	}
 
+	attr_index_rebuild();
+
 	/* Don't submit any work until the stack is initialized */
 	if (!atomic_test_bit(gatt_flags, GATT_INITIALIZED)) {
 		k_sched_unlock();
@@ -2074,6 +2154,86 @@ static void foreach_attr_type_dyndb(uint16_t start_handle, uint16_t end_handle,
 #endif /* CONFIG_BT_GATT_DYNAMIC_DB */
 }
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+static int type_index_find(const struct bt_uuid *uuid)
+{
+	if (!uuid || uuid->type != BT_UUID_TYPE_16) {
+		return -1;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(type_index_uuids); i++) {
+		if (BT_UUID_16(uuid)->val == type_index_uuids[i]) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+/* Iterate over the indexed attributes, returns true if the iteration was
+ * stopped.
+ */
+static bool foreach_attr_type_index(uint16_t start_handle, uint16_t end_handle,
+				    const struct bt_uuid *uuid,
+				    const void *attr_data, uint16_t *num_matches,
+				    bt_gatt_attr_func_t func, void *user_data)
+{
+	uint16_t last = MIN(end_handle, attr_index_last);
+	int type = type_index_find(uuid);
+
+	start_handle = MAX(start_handle, 1);
+
+	if (type >= 0) {
+		uint16_t lo = type_index_start[type];
+		uint16_t hi = type_index_start[type + 1];
+
+		/* Look for the first handle not below start_handle */
+		while (lo < hi) {
+			uint16_t mid = lo + (hi - lo) / 2;
+
+			if (type_index[mid] < start_handle) {
+				lo = mid + 1;
+			} else {
+				hi = mid;
+			}
+		}
+
+		for (; lo < type_index_start[type + 1]; lo++) {
+			uint16_t handle = type_index[lo];
+
+			if (handle > last) {
+				break;
+			}
+
+			if (gatt_foreach_iter(attr_index[handle - 1], handle,
+					      start_handle, end_handle, uuid,
+					      attr_data, num_matches, func,
+					      user_data) == BT_GATT_ITER_STOP) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	for (uint32_t handle = start_handle; handle <= last; handle++) {
+		const struct bt_gatt_attr *attr = attr_index[handle - 1];
+
+		if (!attr) {
+			continue;
+		}
+
+		if (gatt_foreach_iter(attr, handle, start_handle, end_handle,
+				      uuid, attr_data, num_matches, func,
+				      user_data) == BT_GATT_ITER_STOP) {
+			return true;
+		}
+	}
+
+	return false;
+}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 void bt_gatt_foreach_attr_type(uint16_t start_handle, uint16_t end_handle,
 			       const struct bt_uuid *uuid,
 			       const void *attr_data, uint16_t num_matches,
@@ -2085,6 +2245,24 @@ void bt_gatt_foreach_attr_type(uint16_t start_handle, uint16_t end_handle,
 		num_matches = UINT16_MAX;
 	}
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	if (attr_index_valid) {
+		if (foreach_attr_type_index(start_handle, end_handle, uuid,
+					    attr_data, &num_matches, func,
+					    user_data)) {
+			return;
+		}
+
+		/* Only attributes beyond the index are left to look up */
+		if (!attr_index_overflow ||
+		    end_handle <= ARRAY_SIZE(attr_index)) {
+			return;
+		}
+
+		start_handle = MAX(start_handle, ARRAY_SIZE(attr_index) + 1);
+	}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 	if (start_handle <= last_static_handle) {
 		uint16_t handle = 1;
 
@@ -2490,42 +2668,17 @@ static int gatt_notify_mult(struct bt_conn *conn, uint16_t handle,
 #endif /* CONFIG_BT_GATT_NOTIFY_MULTIPLE_FLUSH_MS != 0 */
 #endif /* CONFIG_BT_GATT_NOTIFY_MULTIPLE */
 
-static int gatt_notify(struct bt_conn *conn, uint16_t handle,
-		       struct bt_gatt_notify_params *params)
+/* Queue a notification to a peer whose change awareness and security level
+ * have been checked, and whose subscription has been checked by gatt_notify()
+ * or is given by the CCC configuration the peer was found with when notifying
+ * all subscribers.
+ */
+static int gatt_notify_send(struct bt_conn *conn, uint16_t handle,
+			    struct bt_gatt_notify_params *params)
 {
 	struct net_buf *buf;
 	struct bt_att_notify *nfy;
 
-#if defined(CONFIG_BT_GATT_ENFORCE_CHANGE_UNAWARE)
-	/* BLUETOOTH CORE SPECIFICATION Version 5.3
-	 * Vol 3, Part G 2.5.3 (page 1479):
-	 *
-	 * Except for a Handle Value indication for the Service Changed
-	 * characteristic, the server shall not send notifications and
-	 * indications to such a client until it becomes change-aware.
-	 */
-	if (!bt_gatt_change_aware(conn, false)) {
-		return -EAGAIN;
-	}
-#endif
-
-	/* Confirm that the connection has the correct level of security */
-	if (bt_gatt_check_perm(conn, params->attr, BT_GATT_PERM_READ_ENCRYPT_MASK)) {
-		LOG_WRN("Link is not encrypted");
-		return -EPERM;
-	}
-
-	if (IS_ENABLED(CONFIG_BT_GATT_ENFORCE_SUBSCRIPTION)) {
-		/* Check if client has subscribed before sending notifications.
-		 * This is not really required in the Bluetooth specification,
-		 * but follows its spirit.
-		 */
-		if (!bt_gatt_is_subscribed(conn, params->attr, BT_GATT_CCC_NOTIFY)) {
-			LOG_WRN("Device is not subscribed to characteristic");
-			return -EINVAL;
-		}
-	}
-
 	if (IS_ENABLED(CONFIG_BT_EATT) &&
 	    !bt_att_chan_opt_valid(conn, BT_ATT_CHAN_OPT(params))) {
 		return -EINVAL;
@@ -2556,6 +2709,49 @@ static int gatt_notify(struct bt_conn *conn, uint16_t handle,
 	return bt_att_send(conn, buf);
 }
 
+static bool gatt_notify_allowed(struct bt_conn *conn)
+{
+#if defined(CONFIG_BT_GATT_ENFORCE_CHANGE_UNAWARE)
+	/* BLUETOOTH CORE SPECIFICATION Version 5.3
+	 * Vol 3, Part G 2.5.3 (page 1479):
+	 *
+	 * Except for a Handle Value indication for the Service Changed
+	 * characteristic, the server shall not send notifications and
+	 * indications to such a client until it becomes change-aware.
+	 */
+	return bt_gatt_change_aware(conn, false);
+#else
+	return true;
+#endif
+}
+
+static int gatt_notify(struct bt_conn *conn, uint16_t handle,
+		       struct bt_gatt_notify_params *params)
+{
+	if (!gatt_notify_allowed(conn)) {
+		return -EAGAIN;
+	}
+
+	/* Confirm that the connection has the correct level of security */
+	if (bt_gatt_check_perm(conn, params->attr, BT_GATT_PERM_READ_ENCRYPT_MASK)) {
+		LOG_WRN("Link is not encrypted");
+		return -EPERM;
+	}
+
+	if (IS_ENABLED(CONFIG_BT_GATT_ENFORCE_SUBSCRIPTION)) {
+		/* Check if client has subscribed before sending notifications.
+		 * This is not really required in the Bluetooth specification,
+		 * but follows its spirit.
+		 */
+		if (!bt_gatt_is_subscribed(conn, params->attr, BT_GATT_CCC_NOTIFY)) {
+			LOG_WRN("Device is not subscribed to characteristic");
+			return -EINVAL;
+		}
+	}
+
+	return gatt_notify_send(conn, handle, params);
+}
+
 /* Converts error (negative errno) to ATT Error code */
 static uint8_t att_err_from_int(int err)
 {
@@ -2821,7 +3017,21 @@ static uint8_t notify_cb(const struct bt_gatt_attr *attr, uint16_t handle,
 			}
 		} else if ((data->type == BT_GATT_CCC_NOTIFY) &&
 			   (cfg->value & BT_GATT_CCC_NOTIFY)) {
-			err = gatt_notify(conn, data->handle, data->nfy_params);
+			/* The subscription is given by the CCC configuration,
+			 * don't look it up again. The security level checked
+			 * above is the one of the CCC descriptor, the value
+			 * attribute may require more.
+			 */
+			if (!gatt_notify_allowed(conn)) {
+				err = -EAGAIN;
+			} else if (bt_gatt_check_perm(conn, data->nfy_params->attr,
+						      BT_GATT_PERM_READ_ENCRYPT_MASK)) {
+				LOG_WRN("Link is not encrypted");
+				err = -EPERM;
+			} else {
+				err = gatt_notify_send(conn, data->handle,
+						       data->nfy_params);
+			}
 		} else {
 			err = 0;
 		}
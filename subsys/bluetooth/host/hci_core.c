@@ -237,6 +237,10 @@ void bt_hci_host_num_completed_packets(struct net_buf *buf)
 	struct bt_conn *conn;
 	uint8_t index = acl(buf)->index;
 
+#if defined(CONFIG_BT_L2CAP_RX_SDU_CHAIN)
+	bt_l2cap_rx_chain_release(buf);
+#endif
+
 	net_buf_destroy(buf);
 
 	/* Do nothing if controller to host flow control is not supported */
@@ -374,7 +378,7 @@ int bt_hci_cmd_send_sync(uint16_t opcode, struct net_buf *buf,
 	/* Since the commands are now processed in the syswq, we cannot suspend
 	 * and wait. We have to send the command from the current context.
 	 */
-	if (k_current_get() == &k_sys_work_q.thread) {
+	if (k_work_queue_is_current(&k_sys_work_q)) {
 		/* drain the command queue until we get to send the command of interest. */
 		struct net_buf *cmd = NULL;
 
@@ -607,6 +611,9 @@ static void hci_acl(struct net_buf *buf)
 
 	acl(buf)->handle = bt_acl_handle(handle);
 	acl(buf)->index = BT_CONN_INDEX_INVALID;
+#if defined(CONFIG_BT_L2CAP_RX_SDU_CHAIN)
+	acl(buf)->l2cap_chained = false;
+#endif
 
 	LOG_DBG("handle %u len %u flags %u", acl(buf)->handle, len, flags);
 
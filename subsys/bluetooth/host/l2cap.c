@@ -776,29 +776,77 @@ static void chan_take_credit(struct bt_l2cap_le_chan *lechan)
 #endif
 }
 
+/* Deficit round-robin between the channels of a connection: a channel
+ * reaching the head of the ready list with a new PDU to send is credited
+ * with a quantum of bytes, and keeps its turn as long as it has credit left.
+ */
+static bool chan_out_of_turn(struct bt_l2cap_le_chan *lechan)
+{
+#if defined(CONFIG_BT_CONN_TX_SCHED_DRR)
+	if (lechan->_pdu_remaining != 0 || lechan->_tx_deficit > 0) {
+		return false;
+	}
+
+	lechan->_tx_deficit += CONFIG_BT_CONN_TX_SCHED_QUANTUM;
+
+	return lechan->_tx_deficit <= 0;
+#else
+	return false;
+#endif /* CONFIG_BT_CONN_TX_SCHED_DRR */
+}
+
+static bool chan_keeps_turn(struct bt_l2cap_le_chan *lechan)
+{
+#if defined(CONFIG_BT_CONN_TX_SCHED_DRR)
+	if (!chan_has_data(lechan)) {
+		/* Credit is not kept while the channel has nothing to send */
+		lechan->_tx_deficit = 0;
+
+		return false;
+	}
+
+	return lechan->_tx_deficit > 0;
+#else
+	return false;
+#endif /* CONFIG_BT_CONN_TX_SCHED_DRR */
+}
+
+static void chan_charge(struct bt_l2cap_le_chan *lechan, size_t len)
+{
+#if defined(CONFIG_BT_CONN_TX_SCHED_DRR)
+	lechan->_tx_deficit -= len;
+#endif /* CONFIG_BT_CONN_TX_SCHED_DRR */
+}
+
 static struct bt_l2cap_le_chan *get_ready_chan(struct bt_conn *conn)
 {
 	struct bt_l2cap_le_chan *lechan;
+	sys_snode_t *pdu_ready;
 
-	sys_snode_t *pdu_ready = sys_slist_peek_head(&conn->l2cap_data_ready);
+	while ((pdu_ready = sys_slist_peek_head(&conn->l2cap_data_ready)) != NULL) {
+		lechan = CONTAINER_OF(pdu_ready, struct bt_l2cap_le_chan, _pdu_ready);
 
-	if (!pdu_ready) {
-		LOG_DBG("nothing to send on this conn");
-		return NULL;
-	}
+		if (!chan_has_data(lechan)) {
+			LOG_DBG("chan %p has no data", lechan);
+			lower_data_ready(lechan);
+			continue;
+		}
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn->l2cap_data_ready, lechan, _pdu_ready) {
-		if (chan_has_data(lechan)) {
-			LOG_DBG("sending from chan %p (%s) data %d", lechan,
-				L2CAP_LE_CID_IS_DYN(lechan->tx.cid) ? "dynamic" : "static",
-				chan_has_data(lechan));
-			return lechan;
+		if (chan_out_of_turn(lechan)) {
+			LOG_DBG("chan %p skips its turn", lechan);
+			lower_data_ready(lechan);
+			raise_data_ready(lechan);
+			continue;
 		}
 
-		LOG_DBG("chan %p has no data", lechan);
-		lower_data_ready(lechan);
+		LOG_DBG("sending from chan %p (%s) data %d", lechan,
+			L2CAP_LE_CID_IS_DYN(lechan->tx.cid) ? "dynamic" : "static",
+			chan_has_data(lechan));
+		return lechan;
 	}
 
+	LOG_DBG("nothing to send on this conn");
+
 	return NULL;
 }
 
@@ -908,6 +956,7 @@ struct net_buf *l2cap_data_pull(struct bt_conn *conn,
 
 		lechan->_pdu_remaining = pdu_len + sizeof(*hdr);
 		chan_take_credit(lechan);
+		chan_charge(lechan, lechan->_pdu_remaining);
 	}
 
 	/* Whether the data to be pulled is the last ACL fragment */
@@ -943,15 +992,22 @@ struct net_buf *l2cap_data_pull(struct bt_conn *conn,
 		 * FIFO on `conn`. Adding it again will send it to the back of
 		 * the queue.
 		 *
+		 * With deficit round-robin scheduling, the channel stays at the
+		 * head of the queue until it has used its credit.
+		 *
 		 * TODO: add a user-controlled QoS function.
 		 */
-		LOG_DBG("chan %p done", lechan);
-		lower_data_ready(lechan);
+		if (chan_keeps_turn(lechan)) {
+			LOG_DBG("chan %p keeps its turn", lechan);
+		} else {
+			LOG_DBG("chan %p done", lechan);
+			lower_data_ready(lechan);
 
-		/* Append channel to list if it still has data */
-		if (chan_has_data(lechan)) {
-			LOG_DBG("chan %p ready", lechan);
-			raise_data_ready(lechan);
+			/* Append channel to list if it still has data */
+			if (chan_has_data(lechan)) {
+				LOG_DBG("chan %p ready", lechan);
+				raise_data_ready(lechan);
+			}
 		}
 	}
 
@@ -2421,13 +2477,74 @@ static void l2cap_chan_le_recv_sdu(struct bt_l2cap_le_chan *chan,
 	net_buf_unref(buf);
 }
 
+#if defined(CONFIG_BT_L2CAP_RX_SDU_CHAIN)
+#define acl(buf) ((struct acl_data *)net_buf_user_data(buf))
+
+/* ACL RX buffers held as segments of SDUs, until the SDUs are freed. One is
+ * always left to the Controller, so that segments keep being received, and
+ * copied, while the application holds on to SDUs or while SDUs are being
+ * reassembled on several channels.
+ */
+#define L2CAP_RX_CHAIN_MAX (CONFIG_BT_BUF_ACL_RX_COUNT - 1)
+
+static atomic_t l2cap_rx_chained;
+
+static bool l2cap_rx_chain_hold(struct net_buf *buf)
+{
+	atomic_val_t held;
+
+	/* Only the buffers of the ACL RX pool are accounted for */
+	if (net_buf_pool_get(buf->pool_id)->destroy != bt_hci_host_num_completed_packets) {
+		return false;
+	}
+
+	do {
+		held = atomic_get(&l2cap_rx_chained);
+		if (held >= L2CAP_RX_CHAIN_MAX) {
+			return false;
+		}
+	} while (!atomic_cas(&l2cap_rx_chained, held, held + 1));
+
+	acl(buf)->l2cap_chained = true;
+
+	return true;
+}
+
+void bt_l2cap_rx_chain_release(struct net_buf *buf)
+{
+	if (acl(buf)->l2cap_chained) {
+		acl(buf)->l2cap_chained = false;
+		atomic_dec(&l2cap_rx_chained);
+	}
+}
+#endif /* CONFIG_BT_L2CAP_RX_SDU_CHAIN */
+
+static bool l2cap_chan_le_recv_chain(struct bt_l2cap_le_chan *chan, struct net_buf *buf)
+{
+#if defined(CONFIG_BT_L2CAP_RX_SDU_CHAIN)
+	if (!l2cap_rx_chain_hold(buf)) {
+		LOG_DBG("chan %p ACL RX buffers low, copying segment", chan);
+		return false;
+	}
+
+	/* Hold on to the received segment instead of copying it, the caller
+	 * releases its own reference.
+	 */
+	net_buf_frag_add(chan->_sdu, net_buf_ref(buf));
+
+	return true;
+#else
+	return false;
+#endif
+}
+
 static void l2cap_chan_le_recv_seg(struct bt_l2cap_le_chan *chan,
 				   struct net_buf *buf)
 {
-	uint16_t len;
+	size_t len;
 	uint16_t seg = 0U;
 
-	len = chan->_sdu->len;
+	len = net_buf_frags_len(chan->_sdu);
 	if (len) {
 		memcpy(&seg, net_buf_user_data(chan->_sdu), sizeof(seg));
 	}
@@ -2444,16 +2561,21 @@ static void l2cap_chan_le_recv_seg(struct bt_l2cap_le_chan *chan,
 
 	LOG_DBG("chan %p seg %d len %zu", chan, seg, buf->len);
 
-	/* Append received segment to SDU */
-	len = net_buf_append_bytes(chan->_sdu, buf->len, buf->data, K_NO_WAIT,
-				   l2cap_alloc_frag, chan);
-	if (len != buf->len) {
-		LOG_ERR("Unable to store SDU");
-		bt_l2cap_chan_disconnect(&chan->chan);
-		return;
+	if (len && l2cap_chan_le_recv_chain(chan, buf)) {
+		len += buf->len;
+	} else {
+		/* Append received segment to SDU */
+		if (net_buf_append_bytes(chan->_sdu, buf->len, buf->data, K_NO_WAIT,
+					 l2cap_alloc_frag, chan) != buf->len) {
+			LOG_ERR("Unable to store SDU");
+			bt_l2cap_chan_disconnect(&chan->chan);
+			return;
+		}
+
+		len = net_buf_frags_len(chan->_sdu);
 	}
 
-	if (chan->_sdu->len < chan->_sdu_len) {
+	if (len < chan->_sdu_len) {
 		/* Give more credits if remote has run out of them, this
 		 * should only happen if the remote cannot fully utilize the
 		 * MPS for some reason.
@@ -2579,8 +2701,12 @@ static void l2cap_chan_le_recv(struct bt_l2cap_le_chan *chan,
 		}
 		chan->_sdu_len = sdu_len;
 
-		/* Send sdu_len/mps worth of credits */
+		/* Send sdu_len/mps worth of credits. Unless segments are
+		 * chained, no more than what fits in the SDU buffer.
+		 */
 		uint16_t credits = DIV_ROUND_UP(
+			IS_ENABLED(CONFIG_BT_L2CAP_RX_SDU_CHAIN) ?
+			sdu_len - buf->len :
 			MIN(sdu_len - buf->len, net_buf_tailroom(chan->_sdu)),
 			chan->rx.mps);
 
@@ -220,6 +220,9 @@ int bt_l2cap_send_pdu(struct bt_l2cap_le_chan *le_chan, struct net_buf *pdu,
 /* Receive a new L2CAP PDU from a connection */
 void bt_l2cap_recv(struct bt_conn *conn, struct net_buf *buf, bool complete);
 
+/* Release an ACL RX buffer held as a segment of a received SDU, when it is destroyed */
+void bt_l2cap_rx_chain_release(struct net_buf *buf);
+
 /* Perform connection parameter update request */
 int bt_l2cap_update_conn_param(struct bt_conn *conn,
 			       const struct bt_le_conn_param *param);
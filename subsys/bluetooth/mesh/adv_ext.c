@@ -503,7 +503,7 @@ int bt_mesh_adv_disable(void)
 	for (int i = 0; i < ARRAY_SIZE(advs); i++) {
 		atomic_set_bit(advs[i].flags, ADV_FLAG_SUSPENDING);
 
-		if (k_current_get() != &k_sys_work_q.thread ||
+		if (!k_work_queue_is_current(&k_sys_work_q) ||
 		    (k_work_busy_get(&advs[i].work) & K_WORK_RUNNING) == 0) {
 			k_work_flush(&advs[i].work, &sync);
 		}
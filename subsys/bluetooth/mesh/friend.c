@@ -205,6 +205,9 @@ static void friend_clear(struct bt_mesh_friend *frnd)
 	frnd->queue_size = 0U;
 	frnd->pending_req = 0U;
 	(void)memset(frnd->sub_list, 0, sizeof(frnd->sub_list));
+#if defined(CONFIG_BT_MESH_FRIEND_STATS)
+	(void)memset(&frnd->stats, 0, sizeof(frnd->stats));
+#endif
 }
 
 void bt_mesh_friends_clear(void)
@@ -691,16 +694,97 @@ int bt_mesh_friend_sub_rem(struct bt_mesh_net_rx *rx,
 	return 0;
 }
 
+static void stats_enqueued(struct bt_mesh_friend *frnd, uint32_t count)
+{
+#if defined(CONFIG_BT_MESH_FRIEND_STATS)
+	frnd->stats.enqueued += count;
+	frnd->stats.queue_max = MAX(frnd->stats.queue_max, frnd->queue_size);
+#endif
+}
+
+static void stats_dropped(struct bt_mesh_friend *frnd, uint32_t count)
+{
+#if defined(CONFIG_BT_MESH_FRIEND_STATS)
+	frnd->stats.dropped += count;
+#endif
+}
+
 static void enqueue_buf(struct bt_mesh_friend *frnd, struct net_buf *buf)
 {
 	net_buf_slist_put(&frnd->queue, buf);
 	frnd->queue_size++;
+
+	stats_enqueued(frnd, 1);
+}
+
+static struct bt_mesh_ctl_friend_update *update_get(struct net_buf *buf)
+{
+	struct bt_mesh_ctl_friend_update *upd = NULL;
+	struct net_buf_simple_state state;
+
+	if (buf->len != 16) {
+		return NULL;
+	}
+
+	net_buf_simple_save(&buf->b, &state);
+
+	net_buf_skip(buf, 1); /* skip IVI, NID */
+
+	if (!(net_buf_pull_u8(buf) >> 7)) {
+		goto end;
+	}
+
+	net_buf_skip(buf, 7); /* skip seqnum src dec*/
+
+	if (TRANS_CTL_OP((uint8_t *) net_buf_pull_mem(buf, 1))
+			!= TRANS_CTL_OP_FRIEND_UPDATE) {
+		goto end;
+	}
+
+	upd = net_buf_pull_mem(buf, sizeof(*upd));
+
+end:
+	net_buf_simple_restore(&buf->b, &state);
+	return upd;
+}
+
+/* A Friend Update only carries the current security state of the subnet,
+ * which a newer one supersedes. Instead of queuing another Friend Update
+ * behind one the LPN hasn't fetched yet, refresh the queued one.
+ */
+static bool update_merge(struct bt_mesh_friend *frnd)
+{
+	struct bt_mesh_ctl_friend_update *upd;
+	sys_snode_t *cur;
+
+	SYS_SLIST_FOR_EACH_NODE(&frnd->queue, cur) {
+		upd = update_get((void *)cur);
+		if (!upd) {
+			continue;
+		}
+
+		LOG_DBG("Merging into queued Friend Update for LPN 0x%04x", frnd->lpn);
+
+		upd->flags = bt_mesh_net_flags(frnd->subnet);
+		upd->iv_index = sys_cpu_to_be32(bt_mesh.iv_index);
+
+#if defined(CONFIG_BT_MESH_FRIEND_STATS)
+		frnd->stats.superseded++;
+#endif
+		return true;
+	}
+
+	return false;
 }
 
 static void enqueue_update(struct bt_mesh_friend *frnd, uint8_t md)
 {
 	struct net_buf *buf;
 
+	if (update_merge(frnd)) {
+		return;
+	}
+
 	buf = encode_update(frnd, md);
 	if (!buf) {
 		LOG_ERR("Unable to encode Friend Update");
@@ -1140,6 +1224,7 @@ static void enqueue_friend_pdu(struct bt_mesh_friend *frnd,
 	if (!seg) {
 		LOG_ERR("No free friend segment RX contexts for 0x%04x", src);
 		net_buf_unref(buf);
+		stats_dropped(frnd, 1);
 		return;
 	}
 
@@ -1149,6 +1234,7 @@ static void enqueue_friend_pdu(struct bt_mesh_friend *frnd,
 		sys_slist_merge_slist(&frnd->queue, &seg->queue);
 
 		frnd->queue_size += seg->seg_count;
+		stats_enqueued(frnd, seg->seg_count);
 		seg->seg_count = 0U;
 	} else {
 		FRIEND_ADV(buf)->seg = true;
@@ -1199,34 +1285,15 @@ static void buf_send_end(int err, void *user_data)
 
 static void update_overwrite(struct net_buf *buf, uint8_t md)
 {
-	struct net_buf_simple_state state;
 	struct bt_mesh_ctl_friend_update *upd;
 
-	if (buf->len != 16) {
+	upd = update_get(buf);
+	if (!upd) {
 		return;
 	}
 
-	net_buf_simple_save(&buf->b, &state);
-
-	net_buf_skip(buf, 1); /* skip IVI, NID */
-
-	if (!(net_buf_pull_u8(buf) >> 7)) {
-		goto end;
-	}
-
-	net_buf_skip(buf, 7); /* skip seqnum src dec*/
-
-	if (TRANS_CTL_OP((uint8_t *) net_buf_pull_mem(buf, 1))
-			!= TRANS_CTL_OP_FRIEND_UPDATE) {
-		goto end;
-	}
-
-	upd = net_buf_pull_mem(buf, sizeof(*upd));
 	LOG_DBG("Update Previous Friend Update MD 0x%02x -> 0x%02x", upd->md, md);
 	upd->md = md;
-
-end:
-	net_buf_simple_restore(&buf->b, &state);
 }
 
 static void friend_timeout(struct k_work *work)
@@ -1279,6 +1346,10 @@ static void friend_timeout(struct k_work *work)
 	LOG_DBG("Sending buf %p from Friend Queue of LPN 0x%04x", frnd->last, frnd->lpn);
 	frnd->queue_size--;
 
+#if defined(CONFIG_BT_MESH_FRIEND_STATS)
+	frnd->stats.sent++;
+#endif
+
 send_last:
 	adv = bt_mesh_adv_create(BT_MESH_ADV_DATA, BT_MESH_ADV_TAG_FRIEND,
 				 FRIEND_XMIT, K_NO_WAIT);
@@ -1419,6 +1490,10 @@ static void friend_purge_old_ack(struct bt_mesh_friend *frnd,
 			frnd->queue_size--;
 
 			net_buf_unref(buf);
+
+#if defined(CONFIG_BT_MESH_FRIEND_STATS)
+			frnd->stats.superseded++;
+#endif
 			break;
 		}
 	}
@@ -1465,6 +1540,7 @@ static void friend_lpn_enqueue_rx(struct bt_mesh_friend *frnd,
 	buf = create_friend_pdu(frnd, &info, sbuf);
 	if (!buf) {
 		LOG_ERR("Failed to encode Friend buffer");
+		stats_dropped(frnd, 1);
 		return;
 	}
 
@@ -1501,6 +1577,7 @@ static void friend_lpn_enqueue_tx(struct bt_mesh_friend *frnd,
 	buf = create_friend_pdu(frnd, &info, sbuf);
 	if (!buf) {
 		LOG_ERR("Failed to encode Friend buffer");
+		stats_dropped(frnd, 1);
 		return;
 	}
 
@@ -1669,6 +1746,7 @@ static bool friend_queue_prepare_space(struct bt_mesh_friend *frnd, uint16_t add
 	uint8_t avail_space;
 
 	if (!friend_queue_has_space(frnd, addr, seq_auth, seg_count)) {
+		stats_dropped(frnd, 1);
 		return false;
 	}
 
@@ -1680,6 +1758,7 @@ static bool friend_queue_prepare_space(struct bt_mesh_friend *frnd, uint16_t add
 
 		if (!buf) {
 			LOG_ERR("Unable to free up enough buffers");
+			stats_dropped(frnd, 1);
 			return false;
 		}
 
@@ -1689,6 +1768,7 @@ static bool friend_queue_prepare_space(struct bt_mesh_friend *frnd, uint16_t add
 		pending_segments = FRIEND_ADV(buf)->seg;
 
 		net_buf_unref(buf);
+		stats_dropped(frnd, 1);
 	}
 
 	return true;
@@ -1773,6 +1853,23 @@ bool bt_mesh_friend_enqueue_tx(struct bt_mesh_net_tx *tx,
 	return matched;
 }
 
+#if defined(CONFIG_BT_MESH_FRIEND_STATS)
+int bt_mesh_friend_stats_get(uint16_t lpn_addr, struct bt_mesh_friend_stats *stats)
+{
+	struct bt_mesh_friend *frnd;
+
+	frnd = bt_mesh_friend_find(BT_MESH_KEY_ANY, lpn_addr, false, true);
+	if (!frnd) {
+		return -ENOENT;
+	}
+
+	*stats = frnd->stats;
+	stats->queue_size = frnd->queue_size;
+
+	return 0;
+}
+#endif
+
 int bt_mesh_friend_terminate(uint16_t lpn_addr)
 {
 	struct bt_mesh_friend *frnd;
@@ -1811,6 +1908,7 @@ void bt_mesh_friend_clear_incomplete(struct bt_mesh_subnet *sub, uint16_t src,
 
 			LOG_WRN("Clearing incomplete segments for 0x%04x", src);
 
+			stats_dropped(frnd, sys_slist_len(&seg->queue));
 			purge_buffers(&seg->queue);
 			seg->seg_count = 0U;
 			break;
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/sys/util.h>
+
+#include <zephyr/bluetooth/mesh.h>
+
+#include "msg_cache.h"
+
+#define SEQ_BITS 17
+
+static struct {
+	uint32_t src : 15, /* MSb of source is always 0 */
+	      seq : SEQ_BITS;
+} msg_cache[CONFIG_BT_MESH_MSG_CACHE_SIZE];
+static uint16_t msg_cache_next;
+
+#if defined(CONFIG_BT_MESH_MSG_CACHE_HASH)
+/* Cache entries are chained by hash of their source address and sequence
+ * number. Links hold the entry index plus one, zero terminates a chain.
+ */
+static uint16_t msg_cache_bucket[NHPOT(CONFIG_BT_MESH_MSG_CACHE_SIZE)];
+static uint16_t msg_cache_chain[CONFIG_BT_MESH_MSG_CACHE_SIZE];
+
+static uint16_t *msg_cache_bucket_get(uint16_t src, uint32_t seq)
+{
+	uint32_t key = ((uint32_t)src << SEQ_BITS) | seq;
+	/* The top bits of the product select the bucket, none with a single one */
+	uint64_t hash = (uint64_t)(uint32_t)(key * 0x9e3779b1U)
+			<< LOG2CEIL(CONFIG_BT_MESH_MSG_CACHE_SIZE);
+
+	return &msg_cache_bucket[hash >> 32];
+}
+
+static void msg_cache_link(uint16_t idx)
+{
+	uint16_t *bucket = msg_cache_bucket_get(msg_cache[idx].src, msg_cache[idx].seq);
+
+	msg_cache_chain[idx] = *bucket;
+	*bucket = idx + 1;
+}
+
+static void msg_cache_unlink(uint16_t idx)
+{
+	uint16_t *link = msg_cache_bucket_get(msg_cache[idx].src, msg_cache[idx].seq);
+
+	while (*link) {
+		if (*link == idx + 1) {
+			*link = msg_cache_chain[idx];
+			return;
+		}
+
+		link = &msg_cache_chain[*link - 1];
+	}
+}
+#endif /* CONFIG_BT_MESH_MSG_CACHE_HASH */
+
+bool bt_mesh_msg_cache_match(uint16_t src, uint32_t seq)
+{
+	uint16_t i;
+
+	seq &= BIT_MASK(SEQ_BITS);
+
+#if defined(CONFIG_BT_MESH_MSG_CACHE_HASH)
+	for (i = *msg_cache_bucket_get(src, seq); i; i = msg_cache_chain[i - 1]) {
+		if (msg_cache[i - 1].src == src && msg_cache[i - 1].seq == seq) {
+			return true;
+		}
+	}
+#else
+	for (i = msg_cache_next; i > 0U;) {
+		if (msg_cache[--i].src == src && msg_cache[i].seq == seq) {
+			return true;
+		}
+	}
+
+	for (i = ARRAY_SIZE(msg_cache); i > msg_cache_next;) {
+		if (msg_cache[--i].src == src && msg_cache[i].seq == seq) {
+			return true;
+		}
+	}
+#endif /* CONFIG_BT_MESH_MSG_CACHE_HASH */
+
+	return false;
+}
+
+void bt_mesh_msg_cache_add(uint16_t src, uint32_t seq)
+{
+	msg_cache_next %= ARRAY_SIZE(msg_cache);
+
+#if defined(CONFIG_BT_MESH_MSG_CACHE_HASH)
+	if (msg_cache[msg_cache_next].src != BT_MESH_ADDR_UNASSIGNED) {
+		msg_cache_unlink(msg_cache_next);
+	}
+#endif
+
+	msg_cache[msg_cache_next].src = src;
+	msg_cache[msg_cache_next].seq = seq;
+
+#if defined(CONFIG_BT_MESH_MSG_CACHE_HASH)
+	msg_cache_link(msg_cache_next);
+#endif
+
+	msg_cache_next++;
+}
+
+void bt_mesh_msg_cache_rewind(void)
+{
+	msg_cache_next--;
+
+#if defined(CONFIG_BT_MESH_MSG_CACHE_HASH)
+	msg_cache_unlink(msg_cache_next);
+#endif
+
+	msg_cache[msg_cache_next].src = BT_MESH_ADDR_UNASSIGNED;
+}
+
+void bt_mesh_msg_cache_clear(void)
+{
+	(void)memset(msg_cache, 0, sizeof(msg_cache));
+	msg_cache_next = 0U;
+
+#if defined(CONFIG_BT_MESH_MSG_CACHE_HASH)
+	(void)memset(msg_cache_bucket, 0, sizeof(msg_cache_bucket));
+#endif
+}
@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Network message cache, holding the source address and the 17 least
+ * significant bits of the sequence number of the recently received network
+ * PDUs.
+ */
+
+bool bt_mesh_msg_cache_match(uint16_t src, uint32_t seq);
+void bt_mesh_msg_cache_add(uint16_t src, uint32_t seq);
+/* Forget the last added entry */
+void bt_mesh_msg_cache_rewind(void);
+void bt_mesh_msg_cache_clear(void);
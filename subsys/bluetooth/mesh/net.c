@@ -23,6 +23,7 @@
 #include "mesh.h"
 #include "net.h"
 #include "rpl.h"
+#include "msg_cache.h"
 #include "lpn.h"
 #include "friend.h"
 #include "proxy.h"
@@ -72,12 +73,6 @@ struct iv_val {
 	      iv_duration:7;
 } __packed;
 
-static struct {
-	uint32_t src : 15, /* MSb of source is always 0 */
-	      seq : 17;
-} msg_cache[CONFIG_BT_MESH_MSG_CACHE_SIZE];
-static uint16_t msg_cache_next;
-
 /* Singleton network context (the implementation only supports one) */
 struct bt_mesh_net bt_mesh = {
 	.local_queue = SYS_SLIST_STATIC_INIT(&bt_mesh.local_queue),
@@ -137,35 +132,6 @@ static bool check_dup(struct net_buf_simple *data)
 	return false;
 }
 
-static bool msg_cache_match(struct net_buf_simple *pdu)
-{
-	uint16_t i;
-
-	for (i = msg_cache_next; i > 0U;) {
-		if (msg_cache[--i].src == SRC(pdu->data) &&
-		    msg_cache[i].seq == (SEQ(pdu->data) & BIT_MASK(17))) {
-			return true;
-		}
-	}
-
-	for (i = ARRAY_SIZE(msg_cache); i > msg_cache_next;) {
-		if (msg_cache[--i].src == SRC(pdu->data) &&
-		    msg_cache[i].seq == (SEQ(pdu->data) & BIT_MASK(17))) {
-			return true;
-		}
-	}
-
-	return false;
-}
-
-static void msg_cache_add(struct bt_mesh_net_rx *rx)
-{
-	msg_cache_next %= ARRAY_SIZE(msg_cache);
-	msg_cache[msg_cache_next].src = rx->ctx.addr;
-	msg_cache[msg_cache_next].seq = rx->seq;
-	msg_cache_next++;
-}
-
 static void store_iv(bool only_duration)
 {
 	bt_mesh_settings_store_schedule(BT_MESH_SETTINGS_IV_PENDING);
@@ -207,8 +173,7 @@ int bt_mesh_net_create(uint16_t idx, uint8_t flags, const struct bt_mesh_key *ke
 		return err;
 	}
 
-	(void)memset(msg_cache, 0, sizeof(msg_cache));
-	msg_cache_next = 0U;
+	bt_mesh_msg_cache_clear();
 
 	bt_mesh.iv_index = iv_index;
 	atomic_set_bit_to(bt_mesh.flags, BT_MESH_IVU_IN_PROGRESS,
@@ -645,7 +610,7 @@ static bool net_decrypt(struct bt_mesh_net_rx *rx, struct net_buf_simple *in,
 		return false;
 	}
 
-	if (rx->net_if == BT_MESH_NET_IF_ADV && msg_cache_match(out)) {
+	if (rx->net_if == BT_MESH_NET_IF_ADV && bt_mesh_msg_cache_match(SRC(out->data), SEQ(out->data))) {
 		LOG_DBG("Duplicate found in Network Message Cache");
 		return false;
 	}
@@ -821,7 +786,7 @@ int bt_mesh_net_decode(struct net_buf_simple *in, enum bt_mesh_net_if net_if,
 	LOG_DBG("src 0x%04x dst 0x%04x ttl %u", rx->ctx.addr, rx->ctx.recv_dst, rx->ctx.recv_ttl);
 	LOG_DBG("PDU: %s", bt_hex(out->data, out->len));
 
-	msg_cache_add(rx);
+	bt_mesh_msg_cache_add(rx->ctx.addr, rx->seq);
 
 	return 0;
 }
@@ -877,7 +842,7 @@ void bt_mesh_net_recv(struct net_buf_simple *data, int8_t rssi,
 		 */
 		LOG_WRN("Removing rejected message from Network Message Cache");
 		/* Rewind the next index now that we're not using this entry */
-		msg_cache[--msg_cache_next].src = BT_MESH_ADDR_UNASSIGNED;
+		bt_mesh_msg_cache_rewind();
 		dup_cache[--dup_cache_next] = 0;
 		return;
 	} else if (err == -EBADMSG) {
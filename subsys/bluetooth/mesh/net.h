@@ -84,6 +84,10 @@ struct bt_mesh_friend {
 	sys_slist_t queue;
 	uint32_t queue_size;
 
+#if defined(CONFIG_BT_MESH_FRIEND_STATS)
+	struct bt_mesh_friend_stats stats;
+#endif
+
 	/* Friend Clear Procedure */
 	struct {
 		uint32_t start;                  /* Clear Procedure start */
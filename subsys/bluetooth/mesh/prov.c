@@ -35,11 +35,146 @@ const struct bt_mesh_prov *bt_mesh_prov;
 BUILD_ASSERT(sizeof(bt_mesh_prov_link.conf_inputs) == 145,
 	     "Confirmation inputs shall be 145 bytes");
 
+#if defined(CONFIG_BT_MESH_PROV_DHKEY_WORKQ)
+static struct k_work_q dhkey_work_q;
+static K_THREAD_STACK_DEFINE(dhkey_work_stack, CONFIG_BT_MESH_PROV_DHKEY_WORKQ_STACK_SIZE);
+#endif
+
+/* The DHKey is generated from copies of the keys into a buffer of its own,
+ * and only handed over to bt_mesh_prov_link from the continuation, so that
+ * a generation running while the link is reset does not touch it.
+ */
+static struct {
+	struct k_work gen;
+	struct k_work done;
+	struct k_spinlock lock;
+	/* Incremented on each request and on link reset, to tell whether a
+	 * request and its result are for the current link.
+	 */
+	uint32_t id;
+	/* Last request, and the result of its generation */
+	uint32_t req_id;
+	uint32_t res_id;
+	uint8_t pub_key[PUB_KEY_SIZE];
+	uint8_t priv_key[PRIV_KEY_SIZE];
+	bool has_priv_key;
+	uint8_t key[DH_KEY_SIZE];
+	int err;
+	void (*cb)(int err);
+	uint32_t start;
+	/* Buffers owned by the generation in progress */
+	uint8_t gen_pub_key[PUB_KEY_SIZE];
+	uint8_t gen_priv_key[PRIV_KEY_SIZE];
+	uint8_t gen_key[DH_KEY_SIZE];
+} dhkey;
+
+static void dhkey_done(struct k_work *work)
+{
+	k_spinlock_key_t key = k_spin_lock(&dhkey.lock);
+	void (*cb)(int err) = dhkey.cb;
+	int err = dhkey.err;
+
+	/* Drop results of requests made for a link that has been closed or
+	 * superseded by a new request.
+	 */
+	if (!cb || dhkey.res_id != dhkey.req_id || dhkey.req_id != dhkey.id) {
+		k_spin_unlock(&dhkey.lock, key);
+		return;
+	}
+
+	dhkey.cb = NULL;
+	memcpy(bt_mesh_prov_link.dhkey, dhkey.key, DH_KEY_SIZE);
+	k_spin_unlock(&dhkey.lock, key);
+
+	LOG_DBG("DHKey generated in %u ms (err %d)", k_uptime_get_32() - dhkey.start, err);
+
+	cb(err);
+}
+
+static void dhkey_gen(struct k_work *work)
+{
+	k_spinlock_key_t key = k_spin_lock(&dhkey.lock);
+	uint32_t id = dhkey.req_id;
+	bool has_priv_key = dhkey.has_priv_key;
+	int err;
+
+	memcpy(dhkey.gen_pub_key, dhkey.pub_key, PUB_KEY_SIZE);
+	memcpy(dhkey.gen_priv_key, dhkey.priv_key, PRIV_KEY_SIZE);
+	k_spin_unlock(&dhkey.lock, key);
+
+	err = bt_mesh_dhkey_gen(dhkey.gen_pub_key, has_priv_key ? dhkey.gen_priv_key : NULL,
+				dhkey.gen_key);
+
+	key = k_spin_lock(&dhkey.lock);
+	/* A new request resubmits the generation, which then runs again */
+	if (id == dhkey.req_id) {
+		memcpy(dhkey.key, dhkey.gen_key, DH_KEY_SIZE);
+		dhkey.err = err;
+		dhkey.res_id = id;
+	}
+	k_spin_unlock(&dhkey.lock, key);
+
+#if defined(CONFIG_BT_MESH_PROV_DHKEY_WORKQ)
+	/* Continue the provisioning procedure in the same context as the
+	 * rest of the state machine.
+	 */
+	k_work_submit(&dhkey.done);
+#else
+	dhkey_done(&dhkey.done);
+#endif
+}
+
+int bt_mesh_prov_dhkey_gen(const uint8_t *pub_key, const uint8_t *priv_key,
+			   void (*cb)(int err))
+{
+	k_spinlock_key_t key = k_spin_lock(&dhkey.lock);
+
+	if (dhkey.cb && dhkey.req_id == dhkey.id) {
+		k_spin_unlock(&dhkey.lock, key);
+		return -EBUSY;
+	}
+
+	dhkey.req_id = ++dhkey.id;
+	memcpy(dhkey.pub_key, pub_key, PUB_KEY_SIZE);
+	dhkey.has_priv_key = (priv_key != NULL);
+	if (priv_key) {
+		memcpy(dhkey.priv_key, priv_key, PRIV_KEY_SIZE);
+	}
+	dhkey.cb = cb;
+	dhkey.start = k_uptime_get_32();
+	k_spin_unlock(&dhkey.lock, key);
+
+#if defined(CONFIG_BT_MESH_PROV_DHKEY_WORKQ)
+	(void)k_work_submit_to_queue(&dhkey_work_q, &dhkey.gen);
+#else
+	(void)k_work_submit(&dhkey.gen);
+#endif
+
+	return 0;
+}
+
+/* Drops the DHKey request of the link being reset. A generation already
+ * running is not waited for, its result is discarded.
+ */
+static void dhkey_cancel(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&dhkey.lock);
+
+	dhkey.id++;
+	dhkey.cb = NULL;
+	k_spin_unlock(&dhkey.lock, key);
+
+	(void)k_work_cancel(&dhkey.gen);
+	(void)k_work_cancel(&dhkey.done);
+}
+
 int bt_mesh_prov_reset_state(void)
 {
 	int err;
 	const size_t offset = offsetof(struct bt_mesh_prov_link, addr);
 
+	dhkey_cancel();
+
 	atomic_clear(bt_mesh_prov_link.flags);
 	(void)memset((uint8_t *)&bt_mesh_prov_link + offset, 0,
 		     sizeof(bt_mesh_prov_link) - offset);
@@ -439,6 +574,16 @@ int bt_mesh_prov_init(const struct bt_mesh_prov *prov_info)
 
 	bt_mesh_prov = prov_info;
 
+	k_work_init(&dhkey.gen, dhkey_gen);
+	k_work_init(&dhkey.done, dhkey_done);
+
+#if defined(CONFIG_BT_MESH_PROV_DHKEY_WORKQ)
+	k_work_queue_start(&dhkey_work_q, dhkey_work_stack,
+			   K_THREAD_STACK_SIZEOF(dhkey_work_stack),
+			   K_PRIO_PREEMPT(CONFIG_BT_MESH_PROV_DHKEY_WORKQ_PRIO), NULL);
+	k_thread_name_set(&dhkey_work_q.thread, "BT Mesh DHKey workq");
+#endif
+
 	if (IS_ENABLED(CONFIG_BT_MESH_PB_ADV)) {
 		bt_mesh_pb_adv_init();
 	}
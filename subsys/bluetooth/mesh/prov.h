@@ -184,6 +184,12 @@ bool bt_mesh_prov_active(void);
 
 int bt_mesh_prov_auth(bool is_provisioner, uint8_t method, uint8_t action, uint8_t size);
 
+/* Generates bt_mesh_prov_link.dhkey in the background, and calls cb from the
+ * system workqueue once done, unless the link has been closed in between.
+ */
+int bt_mesh_prov_dhkey_gen(const uint8_t *pub_key, const uint8_t *priv_key,
+			   void (*cb)(int err));
+
 int bt_mesh_pb_remote_open(struct bt_mesh_rpr_cli *cli,
 			   const struct bt_mesh_rpr_node *srv, const uint8_t uuid[16],
 			   uint16_t net_idx, uint16_t addr);
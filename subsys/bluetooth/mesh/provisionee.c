@@ -327,6 +327,23 @@ static void send_pub_key(void)
 	start_auth();
 }
 
+static void prov_dh_key_cb(int err)
+{
+	if (err) {
+		LOG_ERR("Failed to generate DHKey");
+		prov_fail(PROV_ERR_UNEXP_ERR);
+		return;
+	}
+
+	LOG_DBG("DHkey: %s", bt_hex(bt_mesh_prov_link.dhkey, DH_KEY_SIZE));
+
+	if (atomic_test_bit(bt_mesh_prov_link.flags, OOB_PUB_KEY)) {
+		start_auth();
+	} else {
+		send_pub_key();
+	}
+}
+
 static void prov_dh_key_gen(void)
 {
 	const uint8_t *remote_pub_key;
@@ -341,28 +358,12 @@ static void prov_dh_key_gen(void)
 		remote_priv_key = NULL;
 	}
 
-	if (bt_mesh_dhkey_gen(remote_pub_key, remote_priv_key, bt_mesh_prov_link.dhkey)) {
+	if (bt_mesh_prov_dhkey_gen(remote_pub_key, remote_priv_key, prov_dh_key_cb)) {
 		LOG_ERR("Failed to generate DHKey");
 		prov_fail(PROV_ERR_UNEXP_ERR);
-		return;
-	}
-
-	LOG_DBG("DHkey: %s", bt_hex(bt_mesh_prov_link.dhkey, DH_KEY_SIZE));
-
-	if (atomic_test_bit(bt_mesh_prov_link.flags, OOB_PUB_KEY)) {
-		start_auth();
-	} else {
-		send_pub_key();
 	}
 }
 
-static void prov_dh_key_gen_handler(struct k_work *work)
-{
-	prov_dh_key_gen();
-}
-
-static K_WORK_DEFINE(dh_gen_work, prov_dh_key_gen_handler);
-
 static void prov_pub_key(const uint8_t *data)
 {
 	LOG_DBG("Remote Public Key: %s", bt_hex(data, PUB_KEY_SIZE));
@@ -390,7 +391,7 @@ static void prov_pub_key(const uint8_t *data)
 		       PDU_LEN_PUB_KEY);
 	}
 
-	k_work_submit(&dh_gen_work);
+	prov_dh_key_gen();
 }
 
 static void notify_input_complete(void)
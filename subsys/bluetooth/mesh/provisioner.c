@@ -414,23 +414,12 @@ static void send_pub_key(void)
 	bt_mesh_prov_link.expect = PROV_PUB_KEY;
 }
 
-static void prov_dh_key_gen(void)
+static void prov_dh_key_cb(int err)
 {
-	const uint8_t *remote_pk;
-	const uint8_t *local_pk;
-
-	local_pk = bt_mesh_prov_link.conf_inputs.pub_key_provisioner;
-	remote_pk = bt_mesh_prov_link.conf_inputs.pub_key_device;
-
-	if (!memcmp(local_pk, remote_pk, PUB_KEY_SIZE)) {
-		LOG_ERR("Public keys are identical");
-		prov_fail(PROV_ERR_NVAL_FMT);
-		return;
-	}
-
-	if (bt_mesh_dhkey_gen(remote_pk, NULL, bt_mesh_prov_link.dhkey)) {
+	if (err) {
 		LOG_ERR("Failed to generate DHKey");
 		prov_fail(PROV_ERR_UNEXP_ERR);
+		return;
 	}
 
 	LOG_DBG("DHkey: %s", bt_hex(bt_mesh_prov_link.dhkey, DH_KEY_SIZE));
@@ -449,12 +438,25 @@ static void prov_dh_key_gen(void)
 	send_confirm();
 }
 
-static void prov_dh_key_gen_handler(struct k_work *work)
+static void prov_dh_key_gen(void)
 {
-	prov_dh_key_gen();
-}
+	const uint8_t *remote_pk;
+	const uint8_t *local_pk;
 
-static K_WORK_DEFINE(dh_gen_work, prov_dh_key_gen_handler);
+	local_pk = bt_mesh_prov_link.conf_inputs.pub_key_provisioner;
+	remote_pk = bt_mesh_prov_link.conf_inputs.pub_key_device;
+
+	if (!memcmp(local_pk, remote_pk, PUB_KEY_SIZE)) {
+		LOG_ERR("Public keys are identical");
+		prov_fail(PROV_ERR_NVAL_FMT);
+		return;
+	}
+
+	if (bt_mesh_prov_dhkey_gen(remote_pk, NULL, prov_dh_key_cb)) {
+		LOG_ERR("Failed to generate DHKey");
+		prov_fail(PROV_ERR_UNEXP_ERR);
+	}
+}
 
 static void prov_pub_key(const uint8_t *data)
 {
@@ -466,7 +468,7 @@ static void prov_pub_key(const uint8_t *data)
 	memcpy(bt_mesh_prov_link.conf_inputs.pub_key_device, data, PUB_KEY_SIZE);
 	bt_mesh_prov_link.bearer->clear_tx();
 
-	k_work_submit(&dh_gen_work);
+	prov_dh_key_gen();
 }
 
 static void notify_input_complete(void)
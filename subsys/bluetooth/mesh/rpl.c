@@ -49,6 +49,99 @@ static inline int rpl_idx(const struct bt_mesh_rpl *rpl)
 	return rpl - &replay_list[0];
 }
 
+#if defined(CONFIG_BT_MESH_RPL_HASH)
+#define RPL_BUCKETS NHPOT(CONFIG_BT_MESH_CRPL)
+
+/* Entries of the list are chained by hash of their source address. Links hold
+ * the entry index plus one, zero terminates a chain.
+ */
+static uint16_t rpl_bucket[RPL_BUCKETS];
+static uint16_t rpl_chain[CONFIG_BT_MESH_CRPL];
+/* No entry below this index is empty */
+static uint16_t rpl_free_hint;
+/* Cleared while entries are being moved around */
+static bool rpl_index_valid = true;
+
+static uint16_t *rpl_bucket_get(uint16_t src)
+{
+	/* The top bits of the product select the bucket, none with a single one */
+	uint64_t hash = (uint64_t)(uint32_t)((uint32_t)src * 0x9e3779b1U)
+			<< LOG2CEIL(CONFIG_BT_MESH_CRPL);
+
+	return &rpl_bucket[hash >> 32];
+}
+
+static void rpl_index_add(struct bt_mesh_rpl *rpl)
+{
+	uint16_t *bucket;
+	int i = rpl_idx(rpl);
+
+	if (!rpl_index_valid) {
+		return;
+	}
+
+	bucket = rpl_bucket_get(rpl->src);
+	rpl_chain[i] = *bucket;
+	*bucket = i + 1;
+
+	if (rpl_free_hint == i) {
+		rpl_free_hint++;
+	}
+}
+
+static void rpl_index_rebuild(void)
+{
+	(void)memset(rpl_bucket, 0, sizeof(rpl_bucket));
+	rpl_free_hint = 0U;
+	rpl_index_valid = true;
+
+	for (int i = 0; i < ARRAY_SIZE(replay_list); i++) {
+		if (replay_list[i].src) {
+			rpl_index_add(&replay_list[i]);
+		}
+	}
+
+	/* Entries are kept packed at the beginning of the list */
+	while (rpl_free_hint < ARRAY_SIZE(replay_list) &&
+	       replay_list[rpl_free_hint].src) {
+		rpl_free_hint++;
+	}
+}
+
+static struct bt_mesh_rpl *rpl_index_find(uint16_t src)
+{
+	for (uint16_t i = *rpl_bucket_get(src); i; i = rpl_chain[i - 1]) {
+		if (replay_list[i - 1].src == src) {
+			return &replay_list[i - 1];
+		}
+	}
+
+	return NULL;
+}
+
+static struct bt_mesh_rpl *rpl_index_free_slot(void)
+{
+	for (int i = rpl_free_hint; i < ARRAY_SIZE(replay_list); i++) {
+		if (!replay_list[i].src) {
+			rpl_free_hint = i;
+			return &replay_list[i];
+		}
+	}
+
+	rpl_free_hint = ARRAY_SIZE(replay_list);
+
+	return NULL;
+}
+#else
+static void rpl_index_add(struct bt_mesh_rpl *rpl)
+{
+}
+
+static void rpl_index_rebuild(void)
+{
+}
+#endif /* CONFIG_BT_MESH_RPL_HASH */
+
 static void clear_rpl(struct bt_mesh_rpl *rpl)
 {
 	int err;
@@ -92,7 +185,18 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 		rpl->seg = 0;
 	}
 
-	rpl->src = rx->ctx.addr;
+	if (rpl->src != rx->ctx.addr) {
+		bool was_empty = !rpl->src;
+
+		rpl->src = rx->ctx.addr;
+
+		if (was_empty) {
+			rpl_index_add(rpl);
+		} else {
+			rpl_index_rebuild();
+		}
+	}
+
 	rpl->seq = rx->seq;
 	rpl->old_iv = rx->old_iv;
 
@@ -107,6 +211,28 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
  * by upper logic (access, transport commands) and for receiving the segmented messages.
  * If a NULL match is given the RPL is immediately updated (used for proxy configuration).
  */
+/* Check a message against the existing entry for its source address. */
+static bool rpl_entry_is_replay(const struct bt_mesh_rpl *rpl,
+				const struct bt_mesh_net_rx *rx)
+{
+	if (!rpl->old_iv &&
+	    atomic_test_bit(rpl_flags, PENDING_RESET) &&
+	    !atomic_test_bit(store, rpl_idx(rpl))) {
+		/* Until rpl reset is finished, entry with old_iv == false and
+		 * without "store" bit set will be removed, therefore it can be
+		 * reused. If such entry is reused, "store" bit will be set and
+		 * the entry won't be removed.
+		 */
+		return false;
+	}
+
+	if (rx->old_iv && !rpl->old_iv) {
+		return true;
+	}
+
+	return !((!rx->old_iv && rpl->old_iv) || rpl->seq < rx->seq);
+}
+
 bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx, struct bt_mesh_rpl **match)
 {
 	struct bt_mesh_rpl *rpl;
@@ -122,6 +248,27 @@ bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx, struct bt_mesh_rpl **match)
 		return false;
 	}
 
+#if defined(CONFIG_BT_MESH_RPL_HASH)
+	if (rpl_index_valid) {
+		rpl = rpl_index_find(rx->ctx.addr);
+		if (rpl) {
+			if (rpl_entry_is_replay(rpl, rx)) {
+				return true;
+			}
+
+			goto match;
+		}
+
+		rpl = rpl_index_free_slot();
+		if (rpl) {
+			goto match;
+		}
+
+		LOG_ERR("RPL is full!");
+		return true;
+	}
+#endif /* CONFIG_BT_MESH_RPL_HASH */
+
 	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
 		rpl = &replay_list[i];
 
@@ -132,27 +279,11 @@ bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx, struct bt_mesh_rpl **match)
 
 		/* Existing slot for given address */
 		if (rpl->src == rx->ctx.addr) {
-			if (!rpl->old_iv &&
-			    atomic_test_bit(rpl_flags, PENDING_RESET) &&
-			    !atomic_test_bit(store, i)) {
-				/* Until rpl reset is finished, entry with old_iv == false and
-				 * without "store" bit set will be removed, therefore it can be
-				 * reused. If such entry is reused, "store" bit will be set and
-				 * the entry won't be removed.
-				 */
-				goto match;
-			}
-
-			if (rx->old_iv && !rpl->old_iv) {
+			if (rpl_entry_is_replay(rpl, rx)) {
 				return true;
 			}
 
-			if ((!rx->old_iv && rpl->old_iv) ||
-			    rpl->seq < rx->seq) {
-				goto match;
-			} else {
-				return true;
-			}
+			goto match;
 		}
 	}
 
@@ -175,6 +306,7 @@ void bt_mesh_rpl_clear(void)
 
 	if (!IS_ENABLED(CONFIG_BT_SETTINGS)) {
 		(void)memset(replay_list, 0, sizeof(replay_list));
+		rpl_index_rebuild();
 		return;
 	}
 
@@ -187,6 +319,12 @@ static struct bt_mesh_rpl *bt_mesh_rpl_find(uint16_t src)
 {
 	int i;
 
+#if defined(CONFIG_BT_MESH_RPL_HASH)
+	if (rpl_index_valid) {
+		return rpl_index_find(src);
+	}
+#endif /* CONFIG_BT_MESH_RPL_HASH */
+
 	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
 		if (replay_list[i].src == src) {
 			return &replay_list[i];
@@ -203,6 +341,7 @@ static struct bt_mesh_rpl *bt_mesh_rpl_alloc(uint16_t src)
 	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
 		if (!replay_list[i].src) {
 			replay_list[i].src = src;
+			rpl_index_add(&replay_list[i]);
 			return &replay_list[i];
 		}
 	}
@@ -261,6 +400,7 @@ void bt_mesh_rpl_reset(void)
 		}
 
 		(void)memset(&replay_list[last - shift + 1], 0, sizeof(struct bt_mesh_rpl) * shift);
+		rpl_index_rebuild();
 	}
 }
 
@@ -284,6 +424,7 @@ static int rpl_set(const char *name, size_t len_rd,
 		LOG_DBG("val (null)");
 		if (entry) {
 			(void)memset(entry, 0, sizeof(*entry));
+			rpl_index_rebuild();
 		} else {
 			LOG_WRN("Unable to find RPL entry for 0x%04x", src);
 		}
@@ -361,6 +502,15 @@ void bt_mesh_rpl_pending_store(uint16_t addr)
 	clr = atomic_test_and_clear_bit(rpl_flags, PENDING_CLEAR);
 	rst = atomic_test_bit(rpl_flags, PENDING_RESET);
 
+#if defined(CONFIG_BT_MESH_RPL_HASH)
+	if (addr == BT_MESH_ADDR_ALL_NODES) {
+		/* Entries are moved while the list is compacted, messages
+		 * checked meanwhile fall back to scanning the list.
+		 */
+		rpl_index_valid = false;
+	}
+#endif /* CONFIG_BT_MESH_RPL_HASH */
+
 	for (int i = 0; i < ARRAY_SIZE(replay_list); i++) {
 		struct bt_mesh_rpl *rpl = &replay_list[i];
 
@@ -402,5 +552,6 @@ void bt_mesh_rpl_pending_store(uint16_t addr)
 
 	if (addr == BT_MESH_ADDR_ALL_NODES) {
 		(void)memset(&replay_list[last - shift + 1], 0, sizeof(struct bt_mesh_rpl) * shift);
+		rpl_index_rebuild();
 	}
 }
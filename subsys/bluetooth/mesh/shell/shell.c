@@ -1637,6 +1637,35 @@ static int cmd_stat_clear(const struct shell *sh, size_t argc, char *argv[])
 }
 #endif
 
+#if defined(CONFIG_BT_MESH_FRIEND_STATS)
+static int cmd_stat_friend(const struct shell *sh, size_t argc, char *argv[])
+{
+	struct bt_mesh_friend_stats st;
+	uint16_t lpn_addr;
+	int err = 0;
+
+	lpn_addr = shell_strtoul(argv[1], 0, &err);
+	if (err) {
+		shell_warn(sh, "Unable to parse input string argument");
+		return err;
+	}
+
+	err = bt_mesh_friend_stats_get(lpn_addr, &st);
+	if (err) {
+		shell_error(sh, "No Friendship with 0x%04x (err %d)", lpn_addr, err);
+		return err;
+	}
+
+	shell_print(sh, "queue:       %u (max %u)", st.queue_size, st.queue_max);
+	shell_print(sh, "enqueued:    %u", st.enqueued);
+	shell_print(sh, "sent:        %u", st.sent);
+	shell_print(sh, "dropped:     %u", st.dropped);
+	shell_print(sh, "superseded:  %u", st.superseded);
+
+	return 0;
+}
+#endif
+
 #if defined(CONFIG_BT_MESH_SHELL_CDB)
 SHELL_STATIC_SUBCMD_SET_CREATE(
 	cdb_cmds,
@@ -1765,10 +1794,15 @@ SHELL_STATIC_SUBCMD_SET_CREATE(target_cmds,
 	SHELL_CMD_ARG(app, NULL, "[AppKeyIdx]", cmd_appidx, 1, 1),
 	SHELL_SUBCMD_SET_END);
 
-#if defined(CONFIG_BT_MESH_STATISTIC)
+#if defined(CONFIG_BT_MESH_STATISTIC) || defined(CONFIG_BT_MESH_FRIEND_STATS)
 SHELL_STATIC_SUBCMD_SET_CREATE(stat_cmds,
+#if defined(CONFIG_BT_MESH_STATISTIC)
 	SHELL_CMD_ARG(get, NULL, NULL, cmd_stat_get, 1, 0),
 	SHELL_CMD_ARG(clear, NULL, NULL, cmd_stat_clear, 1, 0),
+#endif
+#if defined(CONFIG_BT_MESH_FRIEND_STATS)
+	SHELL_CMD_ARG(friend, NULL, "<LPNAddr>", cmd_stat_friend, 2, 0),
+#endif
 	SHELL_SUBCMD_SET_END);
 #endif
 
@@ -1809,7 +1843,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(mesh_cmds,
 #endif
 	SHELL_CMD(target, &target_cmds, "Target commands", bt_mesh_shell_mdl_cmds_help),
 
-#if defined(CONFIG_BT_MESH_STATISTIC)
+#if defined(CONFIG_BT_MESH_STATISTIC) || defined(CONFIG_BT_MESH_FRIEND_STATS)
 	SHELL_CMD(stat, &stat_cmds, "Statistic commands", bt_mesh_shell_mdl_cmds_help),
 #endif
 
@@ -3328,6 +3328,33 @@ done:
 	return err;
 }
 
+#if defined(CONFIG_BT_CONN_TX_STATS)
+static int cmd_tx_stats(const struct shell *sh, size_t argc, char *argv[])
+{
+	struct bt_conn_tx_stats stats;
+	int err;
+
+	if (!default_conn) {
+		shell_error(sh, "Not connected");
+		return -ENOEXEC;
+	}
+
+	err = bt_conn_get_tx_stats(default_conn, &stats);
+	if (err) {
+		shell_error(sh, "Failed to get TX stats (err %d)", err);
+		return -ENOEXEC;
+	}
+
+	shell_print(sh, "Queued in controller: %u", stats.in_ll);
+	shell_print(sh, "Sent: %u bytes in %u fragments over %u ms (%u bps)",
+		    stats.bytes, stats.frags, stats.elapsed_ms,
+		    (uint32_t)(((uint64_t)stats.bytes * 8U * MSEC_PER_SEC) /
+			       MAX(stats.elapsed_ms, 1U)));
+
+	return 0;
+}
+#endif /* CONFIG_BT_CONN_TX_STATS */
+
 static int cmd_conn_update(const struct shell *sh, size_t argc, char *argv[])
 {
 	struct bt_le_conn_param param;
@@ -4795,6 +4822,9 @@ SHELL_STATIC_SUBCMD_SET_CREATE(bt_cmds,
 	SHELL_CMD_ARG(disconnect, NULL, HELP_ADDR_LE, cmd_disconnect, 1, 2),
 	SHELL_CMD_ARG(select, NULL, HELP_ADDR_LE, cmd_select, 3, 0),
 	SHELL_CMD_ARG(info, NULL, HELP_ADDR_LE, cmd_info, 1, 2),
+#if defined(CONFIG_BT_CONN_TX_STATS)
+	SHELL_CMD_ARG(tx-stats, NULL, HELP_NONE, cmd_tx_stats, 1, 0),
+#endif /* CONFIG_BT_CONN_TX_STATS */
 	SHELL_CMD_ARG(conn-update, NULL, "<min> <max> <latency> <timeout>",
 		      cmd_conn_update, 5, 0),
 #if defined(CONFIG_BT_USER_DATA_LEN_UPDATE)
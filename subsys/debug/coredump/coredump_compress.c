@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/debug/coredump.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+#include "coredump_internal.h"
+
+/*
+ * Memory regions are compressed with a small LZ77 variant, made of tokens
+ * starting with a byte t:
+ *
+ * - t < 0x80: (t + 1) literal bytes follow.
+ * - 0x80 <= t < 0xc0: copy of ((t & 0x3f) + 4) bytes from the data produced
+ *   before, at the distance given by the little endian 16-bit value following.
+ * - t >= 0xc0: (((t & 0x3f) << 8 | next byte) + 1) zero bytes.
+ *
+ * The stream for a region ends once the size of the region has been
+ * produced, and each region is compressed on its own.
+ *
+ * Matches are only looked for in a window holding a copy of the data
+ * already output, and not in the region itself, as the region may hold
+ * the state of the coredump subsystem and change while it is dumped.
+ */
+
+#define WINDOW_SIZE	CONFIG_DEBUG_COREDUMP_COMPRESS_WINDOW_SIZE
+#define WINDOW_MASK	(WINDOW_SIZE - 1)
+#define HASH_BITS	CONFIG_DEBUG_COREDUMP_COMPRESS_HASH_BITS
+
+#define LITERAL_MAX	128
+#define MATCH_MIN	4
+#define MATCH_MAX	(0x3f + MATCH_MIN)
+#define ZERO_RUN_MIN	8
+#define ZERO_RUN_MAX	(0x3fff + 1)
+
+#define TOKEN_MATCH	0x80
+#define TOKEN_ZERO_RUN	0xc0
+
+/* Input is copied in blocks, so that it does not change while it is compressed */
+#define BLOCK_SIZE	256
+
+BUILD_ASSERT(IS_POWER_OF_TWO(WINDOW_SIZE), "Window size must be a power of two");
+
+static struct {
+	/* Last data output for the region */
+	uint8_t window[WINDOW_SIZE];
+	/* Position of the last occurrence of each hashed sequence, modulo 2^16 */
+	uint16_t hash[BIT(HASH_BITS)];
+	uint8_t block[BLOCK_SIZE];
+	uint8_t literals[LITERAL_MAX];
+	uint8_t out[64];
+	size_t literal_len;
+	size_t out_len;
+	/* Number of bytes of the region output */
+	uint32_t pos;
+} cd_lz;
+
+static void out_flush(void)
+{
+	coredump_buffer_output(cd_lz.out, cd_lz.out_len);
+	cd_lz.out_len = 0;
+}
+
+static void out_put(const uint8_t *data, size_t len)
+{
+	size_t n;
+
+	while (len > 0) {
+		n = MIN(len, sizeof(cd_lz.out) - cd_lz.out_len);
+		memcpy(&cd_lz.out[cd_lz.out_len], data, n);
+		cd_lz.out_len += n;
+		data += n;
+		len -= n;
+
+		if (cd_lz.out_len == sizeof(cd_lz.out)) {
+			out_flush();
+		}
+	}
+}
+
+static void literals_flush(void)
+{
+	uint8_t token;
+
+	if (cd_lz.literal_len == 0) {
+		return;
+	}
+
+	token = cd_lz.literal_len - 1;
+	out_put(&token, 1);
+	out_put(cd_lz.literals, cd_lz.literal_len);
+	cd_lz.literal_len = 0;
+}
+
+static void window_put(uint8_t byte)
+{
+	cd_lz.window[cd_lz.pos & WINDOW_MASK] = byte;
+	cd_lz.pos++;
+}
+
+static uint32_t hash_get(const uint8_t *data)
+{
+	return (sys_get_le32(data) * 2654435761U) >> (32 - HASH_BITS);
+}
+
+static void emit_literal(uint8_t byte)
+{
+	cd_lz.literals[cd_lz.literal_len++] = byte;
+
+	if (cd_lz.literal_len == LITERAL_MAX) {
+		literals_flush();
+	}
+
+	window_put(byte);
+}
+
+static void emit_zero_run(size_t len)
+{
+	uint8_t token[2] = {
+		TOKEN_ZERO_RUN | ((len - 1) >> 8),
+		(len - 1) & 0xff,
+	};
+
+	literals_flush();
+	out_put(token, sizeof(token));
+
+	for (size_t i = 0; i < MIN(len, WINDOW_SIZE); i++) {
+		cd_lz.window[(cd_lz.pos + i) & WINDOW_MASK] = 0;
+	}
+
+	cd_lz.pos += len;
+}
+
+/*
+ * Returns the length of the match of data, of len bytes, with the data output
+ * at the given distance.
+ */
+static size_t match_len(const uint8_t *data, size_t len, uint32_t dist)
+{
+	size_t n;
+
+	len = MIN(len, MATCH_MAX);
+
+	for (n = 0; n < len; n++) {
+		/* Within the match itself when it overlaps the data */
+		uint8_t ref = n < dist ? cd_lz.window[(cd_lz.pos - dist + n) & WINDOW_MASK] :
+					 data[n - dist];
+
+		if (ref != data[n]) {
+			break;
+		}
+	}
+
+	return n;
+}
+
+static void compress_block(const uint8_t *data, size_t len)
+{
+	uint8_t token[3];
+	uint32_t dist;
+	uint32_t h;
+	size_t n;
+
+	while (len > 0) {
+		n = 0;
+
+		if (len >= MATCH_MIN) {
+			h = hash_get(data);
+			dist = (uint16_t)(cd_lz.pos - cd_lz.hash[h]);
+			cd_lz.hash[h] = (uint16_t)cd_lz.pos;
+
+			if (dist > 0 && dist <= MIN(cd_lz.pos, WINDOW_SIZE)) {
+				n = match_len(data, len, dist);
+			}
+		}
+
+		if (n < MATCH_MIN) {
+			emit_literal(data[0]);
+			data++;
+			len--;
+			continue;
+		}
+
+		token[0] = TOKEN_MATCH | (n - MATCH_MIN);
+		sys_put_le16(dist, &token[1]);
+		literals_flush();
+		out_put(token, sizeof(token));
+
+		for (size_t i = 0; i < n; i++) {
+			window_put(data[i]);
+		}
+
+		data += n;
+		len -= n;
+	}
+}
+
+void z_coredump_compress_memory(uintptr_t start_addr, size_t len)
+{
+	const uint8_t *data = UINT_TO_POINTER(start_addr);
+	size_t n;
+
+	cd_lz.pos = 0;
+	cd_lz.literal_len = 0;
+	cd_lz.out_len = 0;
+	memset(cd_lz.hash, 0, sizeof(cd_lz.hash));
+
+	while (len > 0) {
+		/* Runs of zero bytes, such as unused memory pages, take two bytes */
+		for (n = 0; n < MIN(len, ZERO_RUN_MAX) && data[n] == 0; n++) {
+		}
+
+		if (n >= ZERO_RUN_MIN) {
+			emit_zero_run(n);
+		} else {
+			n = MIN(len, BLOCK_SIZE);
+			/* The region may hold the block buffer itself */
+			memmove(cd_lz.block, data, n);
+			compress_block(cd_lz.block, n);
+		}
+
+		data += n;
+		len -= n;
+	}
+
+	literals_flush();
+	out_flush();
+}
@@ -174,7 +174,8 @@ void coredump_memory_dump(uintptr_t start_addr, uintptr_t end_addr)
 	len = end_addr - start_addr;
 
 	m.id = COREDUMP_MEM_HDR_ID;
-	m.hdr_version = COREDUMP_MEM_HDR_VER;
+	m.hdr_version = IS_ENABLED(CONFIG_DEBUG_COREDUMP_COMPRESS) ?
+			COREDUMP_MEM_HDR_VER_COMPRESSED : COREDUMP_MEM_HDR_VER;
 
 	if (sizeof(uintptr_t) == 8) {
 		m.start	= sys_cpu_to_le64(start_addr);
@@ -186,7 +187,11 @@ void coredump_memory_dump(uintptr_t start_addr, uintptr_t end_addr)
 
 	coredump_buffer_output((uint8_t *)&m, sizeof(m));
 
+#if defined(CONFIG_DEBUG_COREDUMP_COMPRESS)
+	z_coredump_compress_memory(start_addr, len);
+#else
 	coredump_buffer_output((uint8_t *)start_addr, len);
+#endif
 }
 
 int coredump_query(enum coredump_query_id query_id, void *arg)
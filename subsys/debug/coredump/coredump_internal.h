@@ -43,6 +43,17 @@ void z_coredump_start(void);
  */
 void z_coredump_end(void);
 
+/**
+ * @brief Output a memory region compressed
+ *
+ * This outputs the content of the memory region, compressed,
+ * to the coredump backend.
+ *
+ * @param start_addr Start address of memory region
+ * @param len Length of memory region
+ */
+void z_coredump_compress_memory(uintptr_t start_addr, size_t len);
+
 /**
  * @endcond
  */
@@ -130,3 +130,31 @@ int flash_img_check(struct flash_img_context *ctx,
 	return rc;
 }
 #endif
+
+#if defined(CONFIG_IMG_STREAM_IMAGE_CHECK)
+int flash_img_check_written(struct flash_img_context *ctx,
+			    const struct flash_img_check *fic)
+{
+	uint8_t hash[STREAM_FLASH_HASH_LEN];
+	int rc;
+
+	if (!ctx || !fic || !fic->match || fic->clen == 0) {
+		return -EINVAL;
+	}
+
+	if (fic->clen != flash_img_bytes_written(ctx)) {
+		return -EINVAL;
+	}
+
+	rc = stream_flash_hash_get(&ctx->stream, hash);
+	if (rc) {
+		return rc;
+	}
+
+	if (memcmp(hash, fic->match, sizeof(hash))) {
+		return -EILSEQ;
+	}
+
+	return 0;
+}
+#endif
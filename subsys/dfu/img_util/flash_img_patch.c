@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/dfu/flash_img_patch.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/byteorder.h>
+
+LOG_MODULE_REGISTER(flash_img_patch, CONFIG_IMG_MANAGER_LOG_LEVEL);
+
+#define PATCH_OP_COPY		0x01
+#define PATCH_OP_INSERT		0x02
+
+#define PATCH_COPY_LEN		9
+#define PATCH_INSERT_LEN	5
+
+enum {
+	PATCH_STATE_HEADER,
+	PATCH_STATE_COMMAND,
+	PATCH_STATE_INSERT,
+	PATCH_STATE_COPY,
+	PATCH_STATE_DONE,
+};
+
+bool flash_img_patch_is_patch(const uint8_t *data, size_t len)
+{
+	return len >= sizeof(uint32_t) && sys_get_le32(data) == FLASH_IMG_PATCH_MAGIC;
+}
+
+int flash_img_patch_init(struct flash_img_patch_context *ctx, uint8_t source_id,
+			 uint8_t target_id)
+{
+	int rc;
+
+	if (source_id == target_id) {
+		return -EINVAL;
+	}
+
+	rc = flash_area_open(source_id, &ctx->source);
+	if (rc) {
+		return rc;
+	}
+
+	rc = flash_img_init_id(&ctx->img, target_id);
+	if (rc) {
+		flash_area_close(ctx->source);
+		return rc;
+	}
+
+	ctx->target_id = target_id;
+	ctx->parsed = 0;
+	ctx->written = 0;
+	ctx->remaining = 0;
+	ctx->copy_off = 0;
+	ctx->state = PATCH_STATE_HEADER;
+
+	return 0;
+}
+
+static int patch_check_header(struct flash_img_patch_context *ctx)
+{
+	struct flash_img_patch_header *hdr = &ctx->hdr;
+	struct flash_area_check fac = {
+		.match = hdr->source_sha,
+		.clen = sys_le32_to_cpu(hdr->source_size),
+		.off = 0,
+		.rbuf = ctx->copy_buf,
+		.rblen = sizeof(ctx->copy_buf),
+	};
+	int rc;
+
+	hdr->source_size = sys_le32_to_cpu(hdr->source_size);
+	hdr->target_size = sys_le32_to_cpu(hdr->target_size);
+
+	if (sys_le32_to_cpu(hdr->magic) != FLASH_IMG_PATCH_MAGIC || hdr->reserved != 0 ||
+	    hdr->source_size == 0 || hdr->target_size == 0) {
+		LOG_ERR("Invalid patch header");
+		return -EINVAL;
+	}
+
+	if (hdr->source_size > ctx->source->fa_size ||
+	    hdr->target_size > ctx->img.flash_area->fa_size) {
+		LOG_ERR("Patch image sizes %u, %u do not fit", hdr->source_size,
+			hdr->target_size);
+		return -ENOSPC;
+	}
+
+	/* The patch only applies to the image it was created against */
+	rc = flash_area_check_int_sha256(ctx->source, &fac);
+	if (rc) {
+		LOG_ERR("Base image does not match the patch: %d", rc);
+		return rc;
+	}
+
+	return 0;
+}
+
+/* Copies data from the base image for the COPY command in progress, up to budget bytes */
+static int patch_copy(struct flash_img_patch_context *ctx, size_t *budget)
+{
+	size_t chunk;
+	int rc;
+
+	while (ctx->remaining > 0 && *budget > 0) {
+		chunk = MIN(MIN(ctx->remaining, *budget), sizeof(ctx->copy_buf));
+
+		rc = flash_area_read(ctx->source, ctx->copy_off, ctx->copy_buf, chunk);
+		if (rc) {
+			return rc;
+		}
+
+		rc = flash_img_buffered_write(&ctx->img, ctx->copy_buf, chunk, false);
+		if (rc) {
+			return rc;
+		}
+
+		ctx->copy_off += chunk;
+		ctx->remaining -= chunk;
+		ctx->written += chunk;
+		*budget -= chunk;
+	}
+
+	return 0;
+}
+
+/* Starts the command received in ctx->cmd */
+static int patch_command(struct flash_img_patch_context *ctx)
+{
+	uint8_t op = ctx->cmd[0];
+	uint32_t len = sys_get_le32(&ctx->cmd[op == PATCH_OP_COPY ? 5 : 1]);
+	uint32_t off;
+
+	if (len == 0 || len > ctx->hdr.target_size - ctx->written) {
+		LOG_ERR("Command of %u bytes out of image", len);
+		return -EINVAL;
+	}
+
+	if (op == PATCH_OP_COPY) {
+		off = sys_get_le32(&ctx->cmd[1]);
+		if (off > ctx->hdr.source_size || len > ctx->hdr.source_size - off) {
+			LOG_ERR("Copy of %u bytes at %u out of base image", len, off);
+			return -EINVAL;
+		}
+
+		ctx->copy_off = off;
+		ctx->state = PATCH_STATE_COPY;
+	} else {
+		ctx->state = PATCH_STATE_INSERT;
+	}
+
+	ctx->remaining = len;
+
+	return 0;
+}
+
+/* Copies patch data to the header or command being received, returns the
+ * number of bytes used.
+ */
+static size_t patch_parse(struct flash_img_patch_context *ctx, uint8_t *dst,
+			  size_t size, const uint8_t *data, size_t len)
+{
+	size_t n = MIN(len, size - ctx->parsed);
+
+	memcpy(dst + ctx->parsed, data, n);
+	ctx->parsed += n;
+
+	return n;
+}
+
+int flash_img_patch_write(struct flash_img_patch_context *ctx, const uint8_t *data,
+			  size_t len, bool flush)
+{
+	const uint8_t *start = data;
+	size_t budget = CONFIG_IMG_PATCH_COPY_MAX_SIZE;
+	struct flash_img_check fic;
+	size_t cmd_len;
+	size_t n;
+	int rc = 0;
+
+	while (len > 0 && budget > 0 && rc == 0) {
+		n = 0;
+
+		switch (ctx->state) {
+		case PATCH_STATE_HEADER:
+			n = patch_parse(ctx, (uint8_t *)&ctx->hdr, sizeof(ctx->hdr),
+					data, len);
+
+			if (ctx->parsed == sizeof(ctx->hdr)) {
+				rc = patch_check_header(ctx);
+				if (rc == 0) {
+					ctx->parsed = 0;
+					ctx->state = PATCH_STATE_COMMAND;
+				}
+			}
+			break;
+
+		case PATCH_STATE_COMMAND:
+			if (ctx->parsed == 0 && data[0] != PATCH_OP_COPY &&
+			    data[0] != PATCH_OP_INSERT) {
+				LOG_ERR("Invalid patch command 0x%02x", data[0]);
+				rc = -EINVAL;
+				break;
+			}
+
+			cmd_len = (ctx->parsed > 0 ? ctx->cmd[0] : data[0]) == PATCH_OP_COPY ?
+				  PATCH_COPY_LEN : PATCH_INSERT_LEN;
+			n = patch_parse(ctx, ctx->cmd, cmd_len, data, len);
+
+			if (ctx->parsed == cmd_len) {
+				ctx->parsed = 0;
+				rc = patch_command(ctx);
+
+				/* The last byte of a COPY command is only consumed once
+				 * the copy is complete, so that it is given again when
+				 * the copy takes more than one call.
+				 */
+				if (ctx->state == PATCH_STATE_COPY) {
+					n--;
+				}
+			}
+			break;
+
+		case PATCH_STATE_INSERT:
+			n = MIN(len, ctx->remaining);
+			rc = flash_img_buffered_write(&ctx->img, data, n, false);
+			ctx->remaining -= n;
+			ctx->written += n;
+
+			if (ctx->remaining == 0) {
+				ctx->state = PATCH_STATE_COMMAND;
+			}
+			break;
+
+		case PATCH_STATE_COPY:
+			if (data[0] != ctx->cmd[PATCH_COPY_LEN - 1]) {
+				LOG_ERR("Patch data given again does not match");
+				rc = -EINVAL;
+				break;
+			}
+
+			rc = patch_copy(ctx, &budget);
+			if (rc == 0 && ctx->remaining == 0) {
+				n = 1;
+				ctx->state = PATCH_STATE_COMMAND;
+			}
+			break;
+
+		default:
+			LOG_ERR("Data after the end of the patch");
+			rc = -EINVAL;
+			break;
+		}
+
+		if (ctx->state == PATCH_STATE_COMMAND &&
+		    ctx->written == ctx->hdr.target_size) {
+			ctx->state = PATCH_STATE_DONE;
+		}
+
+		data += n;
+		len -= n;
+	}
+
+	if (rc) {
+		goto error;
+	}
+
+	/* The rest of the data is given again with the next call */
+	if (!flush || len > 0) {
+		return (int)(data - start);
+	}
+
+	flash_area_close(ctx->source);
+
+	if (ctx->state != PATCH_STATE_DONE) {
+		LOG_ERR("Incomplete patch");
+		return -EINVAL;
+	}
+
+	rc = flash_img_buffered_write(&ctx->img, NULL, 0, true);
+	if (rc) {
+		return rc;
+	}
+
+	fic.match = ctx->hdr.target_sha;
+	fic.clen = ctx->hdr.target_size;
+
+#if defined(CONFIG_IMG_STREAM_IMAGE_CHECK)
+	if (flash_img_check_written(&ctx->img, &fic) == 0) {
+		return (int)(data - start);
+	}
+#endif
+
+	rc = flash_img_check(&ctx->img, &fic, ctx->target_id);
+
+	return rc ? rc : (int)(data - start);
+
+error:
+	flash_area_close(ctx->source);
+
+	return rc;
+}
+
+size_t flash_img_patch_bytes_written(struct flash_img_patch_context *ctx)
+{
+	return ctx->written;
+}
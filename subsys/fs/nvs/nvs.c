@@ -19,9 +19,9 @@ LOG_MODULE_REGISTER(fs_nvs, CONFIG_NVS_LOG_LEVEL);
 static int nvs_prev_ate(struct nvs_fs *fs, uint32_t *addr, struct nvs_ate *ate);
 static int nvs_ate_valid(struct nvs_fs *fs, const struct nvs_ate *entry);
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
+#if defined(CONFIG_NVS_LOOKUP_CACHE) || defined(CONFIG_NVS_LOOKUP_INDEX)
 
-static inline size_t nvs_lookup_cache_pos(uint16_t id)
+static inline uint16_t nvs_id_hash(uint16_t id)
 {
 	uint16_t hash;
 
@@ -33,7 +33,16 @@ static inline size_t nvs_lookup_cache_pos(uint16_t id)
 	hash *= 0xdb2dU;
 	hash ^= hash >> 9;
 
-	return hash % CONFIG_NVS_LOOKUP_CACHE_SIZE;
+	return hash;
+}
+
+#endif
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+
+static inline size_t nvs_lookup_cache_pos(uint16_t id)
+{
+	return nvs_id_hash(id) % CONFIG_NVS_LOOKUP_CACHE_SIZE;
 }
 
 static int nvs_lookup_cache_rebuild(struct nvs_fs *fs)
@@ -84,6 +93,146 @@ static void nvs_lookup_cache_invalidate(struct nvs_fs *fs, uint32_t sector)
 
 #endif /* CONFIG_NVS_LOOKUP_CACHE */
 
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+
+/* The lookup index is a hash table with linear probing. It is never filled
+ * above NVS_LOOKUP_INDEX_MAX_COUNT entries, so that there always is an empty
+ * slot to end a lookup. It holds the location of the most recent data of each
+ * id, with a length of 0 for deleted ids, which are kept until the next mount.
+ */
+static struct nvs_lookup_index_entry *nvs_lookup_index_slot(struct nvs_fs *fs, uint16_t id)
+{
+	size_t pos = nvs_id_hash(id) % CONFIG_NVS_LOOKUP_INDEX_SIZE;
+
+	while ((fs->lookup_index[pos].id != id) &&
+	       (fs->lookup_index[pos].id != NVS_LOOKUP_INDEX_NO_ID)) {
+		pos = (pos + 1) % CONFIG_NVS_LOOKUP_INDEX_SIZE;
+	}
+
+	return &fs->lookup_index[pos];
+}
+
+/* nvs_lookup_index_find gets the address of the most recent data of id.
+ * returns its length, 0 if id was deleted or never written, or -ENOENT if the
+ * index can't tell and flash has to be searched.
+ */
+static int nvs_lookup_index_find(struct nvs_fs *fs, uint16_t id, uint32_t *addr)
+{
+	const struct nvs_lookup_index_entry *entry;
+
+	/* 0xFFFF is a special-purpose identifier. It is not indexed */
+	if (id == 0xFFFF) {
+		return -ENOENT;
+	}
+
+	entry = nvs_lookup_index_slot(fs, id);
+
+	if (entry->id == id) {
+		*addr = entry->addr;
+		return entry->len;
+	}
+
+	if (fs->lookup_index_complete) {
+		*addr = 0U;
+		return 0;
+	}
+
+	return -ENOENT;
+}
+
+/* nvs_lookup_index_update records the valid ate entry, written at ate_addr,
+ * as the most recent one with its id.
+ */
+static void nvs_lookup_index_update(struct nvs_fs *fs, uint32_t ate_addr,
+				    const struct nvs_ate *entry)
+{
+	struct nvs_lookup_index_entry *index_entry;
+
+	if (entry->id == 0xFFFF) {
+		return;
+	}
+
+	index_entry = nvs_lookup_index_slot(fs, entry->id);
+
+	if (index_entry->id == NVS_LOOKUP_INDEX_NO_ID) {
+		if (fs->lookup_index_count == NVS_LOOKUP_INDEX_MAX_COUNT) {
+			/* The ids that don't fit are searched in flash */
+			if (fs->lookup_index_complete) {
+				LOG_WRN("Lookup index full");
+				fs->lookup_index_complete = false;
+			}
+			return;
+		}
+
+		index_entry->id = entry->id;
+		fs->lookup_index_count++;
+	}
+
+	index_entry->addr = (ate_addr & ADDR_SECT_MASK) + entry->offset;
+	index_entry->len = entry->len;
+}
+
+static void nvs_lookup_index_clear(struct nvs_fs *fs)
+{
+	memset(fs->lookup_index, 0xff, sizeof(fs->lookup_index));
+	fs->lookup_index_count = 0U;
+	fs->lookup_index_complete = false;
+}
+
+static int nvs_lookup_index_rebuild(struct nvs_fs *fs)
+{
+	int rc;
+	uint32_t addr, ate_addr;
+	struct nvs_ate ate;
+
+	nvs_lookup_index_clear(fs);
+	fs->lookup_index_complete = true;
+	addr = fs->ate_wra;
+
+	while (true) {
+		/* Make a copy of 'addr' as it will be advanced by nvs_prev_ate() */
+		ate_addr = addr;
+		rc = nvs_prev_ate(fs, &addr, &ate);
+
+		if (rc) {
+			fs->lookup_index_complete = false;
+			return rc;
+		}
+
+		/* Only the most recent valid ate of each id is recorded */
+		if (ate.id != 0xFFFF &&
+		    nvs_lookup_index_slot(fs, ate.id)->id == NVS_LOOKUP_INDEX_NO_ID &&
+		    nvs_ate_valid(fs, &ate)) {
+			nvs_lookup_index_update(fs, ate_addr, &ate);
+		}
+
+		if (addr == fs->ate_wra) {
+			break;
+		}
+	}
+
+	return 0;
+}
+
+/* The most recent data of an id is only left in a sector that gets erased if
+ * it was deleted, or if the sector was erased without garbage collection.
+ * Either way, the id doesn't exist anymore.
+ */
+static void nvs_lookup_index_invalidate(struct nvs_fs *fs, uint32_t sector)
+{
+	struct nvs_lookup_index_entry *entry = fs->lookup_index;
+	struct nvs_lookup_index_entry *const end = &fs->lookup_index[CONFIG_NVS_LOOKUP_INDEX_SIZE];
+
+	for (; entry < end; ++entry) {
+		if ((entry->id != NVS_LOOKUP_INDEX_NO_ID) &&
+		    ((entry->addr >> ADDR_SECT_SHIFT) == sector)) {
+			entry->len = 0U;
+		}
+	}
+}
+
+#endif /* CONFIG_NVS_LOOKUP_INDEX */
+
 /* basic routines */
 /* nvs_al_size returns size aligned to fs->write_block_size */
 static inline size_t nvs_al_size(struct nvs_fs *fs, size_t len)
@@ -168,6 +317,11 @@ static int nvs_flash_ate_wrt(struct nvs_fs *fs, const struct nvs_ate *entry)
 	if (entry->id != 0xFFFF) {
 		fs->lookup_cache[nvs_lookup_cache_pos(entry->id)] = fs->ate_wra;
 	}
+#endif
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	if (!rc) {
+		nvs_lookup_index_update(fs, fs->ate_wra, entry);
+	}
 #endif
 	fs->ate_wra -= nvs_al_size(fs, sizeof(struct nvs_ate));
 
@@ -343,6 +497,9 @@ static int nvs_flash_erase_sector(struct nvs_fs *fs, uint32_t addr)
 
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 	nvs_lookup_cache_invalidate(fs, addr >> ADDR_SECT_SHIFT);
+#endif
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	nvs_lookup_index_invalidate(fs, addr >> ADDR_SECT_SHIFT);
 #endif
 	rc = flash_flatten(fs->flash_device, offset, fs->sector_size);
 
@@ -621,6 +778,81 @@ static int nvs_add_gc_done_ate(struct nvs_fs *fs)
 	return nvs_flash_ate_wrt(fs, &gc_done_ate);
 }
 
+/* nvs_gc_ate_live checks if the valid ate gc_ate, read at addr, is the most
+ * recent one with its id, so that it needs to be moved before its sector is
+ * erased. Deleted items don't need to be moved.
+ * returns 1 if it needs to be moved, 0 if not, errcode if error
+ */
+static int nvs_gc_ate_live(struct nvs_fs *fs, uint32_t addr, const struct nvs_ate *gc_ate)
+{
+	int rc;
+	struct nvs_ate wlk_ate;
+	uint32_t wlk_addr, wlk_prev_addr;
+
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	/* Data locations of ates with data are unique */
+	rc = nvs_lookup_index_find(fs, gc_ate->id, &wlk_addr);
+	if (rc >= 0) {
+		return rc && (wlk_addr == ((addr & ADDR_SECT_MASK) + gc_ate->offset));
+	}
+#endif
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(gc_ate->id)];
+
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		wlk_addr = fs->ate_wra;
+	}
+#else
+	wlk_addr = fs->ate_wra;
+#endif
+	do {
+		wlk_prev_addr = wlk_addr;
+		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
+		if (rc) {
+			return rc;
+		}
+		/* if ate with same id is reached we might need to copy.
+		 * only consider valid wlk_ate's. Something wrong might
+		 * have been written that has the same ate but is
+		 * invalid, don't consider these as a match.
+		 */
+		if ((wlk_ate.id == gc_ate->id) &&
+		    (nvs_ate_valid(fs, &wlk_ate))) {
+			break;
+		}
+	} while (wlk_addr != fs->ate_wra);
+
+	/* if walk has reached the same address as addr copy is
+	 * needed unless it is a deleted item.
+	 */
+	return (wlk_prev_addr == addr) && gc_ate->len;
+}
+
+/* move the ate gc_ate, read at addr, and its data to the current write
+ * locations.
+ */
+static int nvs_gc_ate_move(struct nvs_fs *fs, uint32_t addr, struct nvs_ate *gc_ate)
+{
+	int rc;
+	uint32_t data_addr;
+
+	LOG_DBG("Moving %d, len %d", gc_ate->id, gc_ate->len);
+
+	data_addr = (addr & ADDR_SECT_MASK);
+	data_addr += gc_ate->offset;
+
+	gc_ate->offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
+	nvs_ate_crc8_update(gc_ate);
+
+	rc = nvs_flash_block_move(fs, data_addr, gc_ate->len);
+	if (rc) {
+		return rc;
+	}
+
+	return nvs_flash_ate_wrt(fs, gc_ate);
+}
+
 /* garbage collection: the address ate_wra has been updated to the new sector
  * that has just been started. The data to gc is in the sector after this new
  * sector.
@@ -628,10 +860,10 @@ static int nvs_add_gc_done_ate(struct nvs_fs *fs)
 static int nvs_gc(struct nvs_fs *fs)
 {
 	int rc;
-	struct nvs_ate close_ate, gc_ate, wlk_ate;
-	uint32_t sec_addr, gc_addr, gc_prev_addr, wlk_addr, wlk_prev_addr,
-	      data_addr, stop_addr;
+	struct nvs_ate close_ate, gc_ate;
+	uint32_t sec_addr, gc_addr, gc_prev_addr, stop_addr;
 	size_t ate_size;
+	bool erased = false;
 
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 
@@ -639,6 +871,20 @@ static int nvs_gc(struct nvs_fs *fs)
 	nvs_sector_advance(fs, &sec_addr);
 	gc_addr = sec_addr + fs->sector_size - ate_size;
 
+#ifdef CONFIG_NVS_INCREMENTAL_GC
+	/* nvs_gc_step() might have already moved the entries and erased the
+	 * sector. Whatever happens next, the sector it collects is now the one
+	 * after the next sector.
+	 */
+	erased = fs->gc_step_done;
+	fs->gc_step_addr = NVS_GC_STEP_NO_ADDR;
+	fs->gc_step_done = false;
+
+	if (erased) {
+		goto gc_done;
+	}
+#endif
+
 	/* if the sector is not closed don't do gc */
 	rc = nvs_flash_ate_rd(fs, gc_addr, &close_ate);
 	if (rc < 0) {
@@ -674,51 +920,14 @@ static int nvs_gc(struct nvs_fs *fs)
 			continue;
 		}
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
-		wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(gc_ate.id)];
-
-		if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
-			wlk_addr = fs->ate_wra;
+		rc = nvs_gc_ate_live(fs, gc_prev_addr, &gc_ate);
+		if (rc < 0) {
+			return rc;
 		}
-#else
-		wlk_addr = fs->ate_wra;
-#endif
-		do {
-			wlk_prev_addr = wlk_addr;
-			rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
-			if (rc) {
-				return rc;
-			}
-			/* if ate with same id is reached we might need to copy.
-			 * only consider valid wlk_ate's. Something wrong might
-			 * have been written that has the same ate but is
-			 * invalid, don't consider these as a match.
-			 */
-			if ((wlk_ate.id == gc_ate.id) &&
-			    (nvs_ate_valid(fs, &wlk_ate))) {
-				break;
-			}
-		} while (wlk_addr != fs->ate_wra);
 
-		/* if walk has reached the same address as gc_addr copy is
-		 * needed unless it is a deleted item.
-		 */
-		if ((wlk_prev_addr == gc_prev_addr) && gc_ate.len) {
+		if (rc) {
 			/* copy needed */
-			LOG_DBG("Moving %d, len %d", gc_ate.id, gc_ate.len);
-
-			data_addr = (gc_prev_addr & ADDR_SECT_MASK);
-			data_addr += gc_ate.offset;
-
-			gc_ate.offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
-			nvs_ate_crc8_update(&gc_ate);
-
-			rc = nvs_flash_block_move(fs, data_addr, gc_ate.len);
-			if (rc) {
-				return rc;
-			}
-
-			rc = nvs_flash_ate_wrt(fs, &gc_ate);
+			rc = nvs_gc_ate_move(fs, gc_prev_addr, &gc_ate);
 			if (rc) {
 				return rc;
 			}
@@ -740,6 +949,10 @@ gc_done:
 		}
 	}
 
+	if (erased) {
+		return 0;
+	}
+
 	/* Erase the gc'ed sector */
 	rc = nvs_flash_erase_sector(fs, sec_addr);
 	if (rc) {
@@ -748,6 +961,151 @@ gc_done:
 	return 0;
 }
 
+#ifdef CONFIG_NVS_INCREMENTAL_GC
+/* incremental garbage collection: the sector collected is the one after the
+ * sector following the write sector, which is the sector nvs_gc() will
+ * collect once the write sector is closed. Its entries are moved to the write
+ * sector, then it is erased ahead of time.
+ */
+int nvs_gc_step(struct nvs_fs *fs, size_t max_steps)
+{
+	int rc = 0;
+	struct nvs_ate close_ate, gc_ate;
+	uint32_t sec_addr, close_addr, gc_addr, gc_prev_addr;
+	size_t ate_size;
+
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	/* With less than 4 sectors, the sector to collect would be the write
+	 * sector or the sector after it. Erasing it would also leave no closed
+	 * sector from which nvs_startup() could find the write sector.
+	 */
+	if (fs->sector_count < 4) {
+		return 0;
+	}
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	if (fs->gc_step_done) {
+		goto end;
+	}
+
+	sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
+	nvs_sector_advance(fs, &sec_addr);
+	nvs_sector_advance(fs, &sec_addr);
+
+	/* the address of the close ate is used to mark that all entries have
+	 * been moved, as it never holds a data ate.
+	 */
+	close_addr = sec_addr + fs->sector_size - ate_size;
+
+	if (fs->gc_step_addr == NVS_GC_STEP_NO_ADDR) {
+		gc_addr = close_addr;
+
+		rc = nvs_flash_ate_rd(fs, gc_addr, &close_ate);
+		if (rc) {
+			goto end;
+		}
+
+		if (!nvs_ate_cmp_const(&close_ate, fs->flash_parameters->erase_value)) {
+			/* the sector was not closed, there is nothing to move
+			 * and it only needs erasing if it is not empty.
+			 */
+			rc = nvs_flash_cmp_const(fs, sec_addr, fs->flash_parameters->erase_value,
+						 fs->sector_size);
+			if (rc < 0) {
+				goto end;
+			}
+			if (!rc) {
+				fs->gc_step_done = true;
+				goto end;
+			}
+		} else if (nvs_close_ate_valid(fs, &close_ate)) {
+			gc_addr &= ADDR_SECT_MASK;
+			gc_addr += close_ate.offset;
+		} else {
+			rc = nvs_recover_last_ate(fs, &gc_addr);
+			if (rc) {
+				goto end;
+			}
+		}
+
+		fs->gc_step_addr = gc_addr;
+	}
+
+	while (max_steps--) {
+		if (fs->gc_step_addr == close_addr) {
+			rc = nvs_flash_erase_sector(fs, sec_addr);
+			if (!rc) {
+				fs->gc_step_done = true;
+			}
+			goto end;
+		}
+
+		gc_prev_addr = fs->gc_step_addr;
+		gc_addr = gc_prev_addr;
+		rc = nvs_prev_ate(fs, &gc_addr, &gc_ate);
+		if (rc) {
+			goto end;
+		}
+
+		if (nvs_ate_valid(fs, &gc_ate)) {
+			rc = nvs_gc_ate_live(fs, gc_prev_addr, &gc_ate);
+			if (rc < 0) {
+				goto end;
+			}
+
+			if (rc) {
+				/* Keep the same space free as nvs_write() does */
+				if (fs->ate_wra < (fs->data_wra + nvs_al_size(fs, gc_ate.len) +
+						   ate_size)) {
+					rc = 0;
+					goto end;
+				}
+
+				rc = nvs_gc_ate_move(fs, gc_prev_addr, &gc_ate);
+				if (rc) {
+					goto end;
+				}
+			}
+		}
+
+		/* gc_addr has left the sector once the first ate is reached */
+		if (gc_prev_addr == close_addr - ate_size) {
+			fs->gc_step_addr = close_addr;
+		} else {
+			fs->gc_step_addr = gc_addr;
+		}
+	}
+
+	rc = 1;
+end:
+	k_mutex_unlock(&fs->nvs_lock);
+	return rc;
+}
+
+#ifdef CONFIG_NVS_INCREMENTAL_GC_WORK
+static void nvs_gc_work_handler(struct k_work *work)
+{
+	struct nvs_fs *fs = CONTAINER_OF(work, struct nvs_fs, gc_work);
+	int rc;
+
+	rc = nvs_gc_step(fs, CONFIG_NVS_INCREMENTAL_GC_WORK_STEP);
+	if (rc > 0) {
+		/* let other work items run before the next step */
+		(void)k_work_submit(work);
+	} else if (rc < 0) {
+		LOG_ERR("Garbage collection step failed: %d", rc);
+	}
+}
+#endif /* CONFIG_NVS_INCREMENTAL_GC_WORK */
+#endif /* CONFIG_NVS_INCREMENTAL_GC */
+
 static int nvs_startup(struct nvs_fs *fs)
 {
 	int rc;
@@ -763,6 +1121,15 @@ static int nvs_startup(struct nvs_fs *fs)
 
 	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
 
+#ifdef CONFIG_NVS_INCREMENTAL_GC
+	fs->gc_step_addr = NVS_GC_STEP_NO_ADDR;
+	fs->gc_step_done = false;
+#endif
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	/* Until it is rebuilt, ids are searched in flash */
+	nvs_lookup_index_clear(fs);
+#endif
+
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 	/* step through the sectors to find a open sector following
 	 * a closed sector, this is where NVS can write.
@@ -956,6 +1323,11 @@ end:
 	if (!rc) {
 		rc = nvs_lookup_cache_rebuild(fs);
 	}
+#endif
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	if (!rc) {
+		rc = nvs_lookup_index_rebuild(fs);
+	}
 #endif
 	/* If the sector is empty add a gc done ate to avoid having insufficient
 	 * space when doing gc.
@@ -979,6 +1351,12 @@ int nvs_clear(struct nvs_fs *fs)
 		return -EACCES;
 	}
 
+#ifdef CONFIG_NVS_INCREMENTAL_GC_WORK
+	struct k_work_sync sync;
+
+	(void)k_work_cancel_sync(&fs->gc_work, &sync);
+#endif
+
 	for (uint16_t i = 0; i < fs->sector_count; i++) {
 		addr = i << ADDR_SECT_SHIFT;
 		rc = nvs_flash_erase_sector(fs, addr);
@@ -1038,6 +1416,13 @@ int nvs_mount(struct nvs_fs *fs)
 		return rc;
 	}
 
+#ifdef CONFIG_NVS_INCREMENTAL_GC_WORK
+	/* The work item is already initialized when remounting */
+	if (!fs->ready) {
+		k_work_init(&fs->gc_work, nvs_gc_work_handler);
+	}
+#endif
+
 	/* nvs is ready for use */
 	fs->ready = true;
 
@@ -1081,11 +1466,21 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 	}
 
 	/* find latest entry with same id */
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	rc = nvs_lookup_index_find(fs, id, &rd_addr);
+	if (rc >= 0) {
+		wlk_ate.len = (uint16_t)rc;
+		wlk_ate.offset = (uint16_t)(rd_addr & ADDR_OFFS_MASK);
+		prev_found = true;
+		goto lookup_done;
+	}
+#endif
+
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
 
 	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
-		goto no_cached_entry;
+		goto lookup_done;
 	}
 #else
 	wlk_addr = fs->ate_wra;
@@ -1107,8 +1502,8 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 		}
 	}
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
-no_cached_entry:
+#if defined(CONFIG_NVS_LOOKUP_CACHE) || defined(CONFIG_NVS_LOOKUP_INDEX)
+lookup_done:
 #endif
 
 	if (prev_found) {
@@ -1179,6 +1574,10 @@ no_cached_entry:
 		gc_count++;
 	}
 	rc = len;
+
+#ifdef CONFIG_NVS_INCREMENTAL_GC_WORK
+	(void)k_work_submit(&fs->gc_work);
+#endif
 end:
 	k_mutex_unlock(&fs->nvs_lock);
 	return rc;
@@ -1214,6 +1613,20 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 
 	cnt_his = 0U;
 
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	/* Only the most recent data is indexed, older data is searched in flash */
+	if (cnt == 0U) {
+		rc = nvs_lookup_index_find(fs, id, &rd_addr);
+		if (rc == 0) {
+			return -ENOENT;
+		}
+		if (rc > 0) {
+			wlk_ate.len = (uint16_t)rc;
+			goto found;
+		}
+	}
+#endif
+
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
 
@@ -1245,6 +1658,12 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 		return -ENOENT;
 	}
 
+	rd_addr &= ADDR_SECT_MASK;
+	rd_addr += wlk_ate.offset;
+
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+found:
+#endif
 #ifdef CONFIG_NVS_DATA_CRC
 	/* When data CRC is enabled, there should be at least the CRC stored in the data field */
 	if (wlk_ate.len < NVS_DATA_CRC_SIZE) {
@@ -1252,8 +1671,6 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 	}
 #endif
 
-	rd_addr &= ADDR_SECT_MASK;
-	rd_addr += wlk_ate.offset;
 	rc = nvs_flash_rd(fs, rd_addr, data, MIN(len, wlk_ate.len - NVS_DATA_CRC_SIZE));
 	if (rc) {
 		goto err;
@@ -30,6 +30,11 @@ extern "C" {
 
 #define NVS_LOOKUP_CACHE_NO_ADDR 0xFFFFFFFF
 
+#define NVS_GC_STEP_NO_ADDR 0xFFFFFFFF
+
+#define NVS_LOOKUP_INDEX_NO_ID 0xFFFF
+#define NVS_LOOKUP_INDEX_MAX_COUNT (CONFIG_NVS_LOOKUP_INDEX_SIZE - CONFIG_NVS_LOOKUP_INDEX_SIZE / 8)
+
 /*
  * Allow to use the NVS_DATA_CRC_SIZE macro in computations whether data CRC is enabled or not
  */
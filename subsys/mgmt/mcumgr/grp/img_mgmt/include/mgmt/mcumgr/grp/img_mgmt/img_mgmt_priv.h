@@ -75,6 +75,37 @@ int img_mgmt_read(int slot, unsigned int offset, void *dst, unsigned int num_byt
 int img_mgmt_write_image_data(unsigned int offset, const void *data, unsigned int num_bytes,
 			      bool last);
 
+/**
+ * @brief Gets the number of bytes given to the last call to img_mgmt_write_image_data()
+ * that were not written and must be given again with the next call. Only applying a
+ * patch, which bounds the data copied from the other slot per call, does not write all
+ * the data at once.
+ *
+ * @return Number of bytes not written.
+ */
+unsigned int img_mgmt_write_image_data_left(void);
+
+#if defined(CONFIG_IMG_STREAM_IMAGE_CHECK) || defined(CONFIG_MCUMGR_GRP_IMG_DELTA)
+/**
+ * @brief Checks whether the image written by the last call to img_mgmt_write_image_data()
+ * with last set matches the SHA-256 hash of the upload, using the hash computed as the
+ * image was written. For a patch upload, this tells whether the image resulting from the
+ * patch matches the hash held in the patch.
+ *
+ * @return true if the image matches, false if it does not or could not be checked.
+ */
+bool img_mgmt_written_image_data_match(void);
+
+/**
+ * @brief Checks whether the image written by the last call to img_mgmt_write_image_data()
+ * with last set has been checked as it was written, by
+ * img_mgmt_written_image_data_match().
+ *
+ * @return true if the image has been checked, false if it must be read back to be checked.
+ */
+bool img_mgmt_written_image_data_checked(void);
+#endif
+
 /**
  * @brief Indicates the type of swap operation that will occur on the next
  * reboot, if any, between provided slot and it's pair.
@@ -302,6 +302,182 @@ img_mgmt_find_by_hash(uint8_t *find, struct image_version *ver)
 	return -1;
 }
 
+#if defined(CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW)
+/*
+ * Chunks received ahead of the upload offset. The data is kept in a ring buffer, at the
+ * position given by its offset modulo the buffer size; the chunks are sorted by offset
+ * and do not overlap.
+ */
+static struct {
+	uint8_t buf[CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW_SIZE];
+	struct {
+		size_t off;
+		size_t len;
+	} chunks[CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW_CHUNKS];
+	uint8_t count;
+} img_mgmt_window;
+
+static void img_mgmt_window_reset(void)
+{
+	img_mgmt_window.count = 0;
+}
+
+/**
+ * Holds a chunk received ahead of the upload offset.
+ *
+ * @return true if the data of the chunk is held in the window, false if it has to be
+ *	   sent again.
+ */
+static bool img_mgmt_window_store(size_t off, const uint8_t *data, size_t len)
+{
+	const size_t size = sizeof(img_mgmt_window.buf);
+	size_t pos;
+	size_t part;
+	int i;
+
+	if (len == 0 || off <= g_img_mgmt_state.off || off + len > g_img_mgmt_state.off + size) {
+		return false;
+	}
+
+	for (i = 0; i < img_mgmt_window.count; i++) {
+		if (off + len <= img_mgmt_window.chunks[i].off) {
+			break;
+		}
+
+		if (off < img_mgmt_window.chunks[i].off + img_mgmt_window.chunks[i].len) {
+			/* Sent again, the data is already held if it is within this chunk */
+			return off >= img_mgmt_window.chunks[i].off &&
+			       off + len <= img_mgmt_window.chunks[i].off +
+					    img_mgmt_window.chunks[i].len;
+		}
+	}
+
+	if (img_mgmt_window.count == ARRAY_SIZE(img_mgmt_window.chunks)) {
+		return false;
+	}
+
+	memmove(&img_mgmt_window.chunks[i + 1], &img_mgmt_window.chunks[i],
+		(img_mgmt_window.count - i) * sizeof(img_mgmt_window.chunks[0]));
+	img_mgmt_window.chunks[i].off = off;
+	img_mgmt_window.chunks[i].len = len;
+	img_mgmt_window.count++;
+
+	pos = off % size;
+	part = MIN(len, size - pos);
+	memcpy(&img_mgmt_window.buf[pos], data, part);
+	memcpy(img_mgmt_window.buf, data + part, len - part);
+
+	return true;
+}
+
+/**
+ * Writes the chunks held in the window that follow the data written so far. The
+ * #MGMT_EVT_OP_IMG_MGMT_DFU_CHUNK_WRITE_COMPLETE notification is sent for each chunk once
+ * it has been written, but for the last one of the image.
+ *
+ * @return 0 on success, IMG_MGMT_ERR code on failure.
+ */
+static int img_mgmt_window_flush(void)
+{
+	const size_t size = sizeof(img_mgmt_window.buf);
+	size_t end;
+	size_t len;
+	size_t pos;
+	size_t part;
+	int rc;
+#if defined(CONFIG_MCUMGR_GRP_IMG_STATUS_HOOKS)
+	int32_t err_rc;
+	uint16_t err_group;
+#endif
+
+	while (img_mgmt_window.count > 0 &&
+	       img_mgmt_window.chunks[0].off <= g_img_mgmt_state.off) {
+		end = img_mgmt_window.chunks[0].off + img_mgmt_window.chunks[0].len;
+
+		if (end > g_img_mgmt_state.off) {
+			len = end - g_img_mgmt_state.off;
+			pos = g_img_mgmt_state.off % size;
+			part = MIN(len, size - pos);
+
+			rc = img_mgmt_write_image_data(g_img_mgmt_state.off,
+						       &img_mgmt_window.buf[pos], part,
+						       g_img_mgmt_state.off + part ==
+						       g_img_mgmt_state.size);
+			if (rc == 0 && part < len && img_mgmt_write_image_data_left() == 0) {
+				rc = img_mgmt_write_image_data(g_img_mgmt_state.off + part,
+							       img_mgmt_window.buf, len - part,
+							       end == g_img_mgmt_state.size);
+				part = len;
+			}
+
+			if (rc != 0) {
+				return rc;
+			}
+
+			g_img_mgmt_state.off += part - img_mgmt_write_image_data_left();
+			if (g_img_mgmt_state.off < end) {
+				/* The rest is written once the client sends it again */
+				break;
+			}
+
+#if defined(CONFIG_MCUMGR_GRP_IMG_STATUS_HOOKS)
+			if (g_img_mgmt_state.off != g_img_mgmt_state.size) {
+				(void)mgmt_callback_notify(MGMT_EVT_OP_IMG_MGMT_DFU_CHUNK_WRITE_COMPLETE,
+							   NULL, 0, &err_rc, &err_group);
+			}
+#endif
+		}
+
+		img_mgmt_window.count--;
+		memmove(&img_mgmt_window.chunks[0], &img_mgmt_window.chunks[1],
+			img_mgmt_window.count * sizeof(img_mgmt_window.chunks[0]));
+	}
+
+	return 0;
+}
+#endif
+
+#ifdef CONFIG_IMG_ENABLE_IMAGE_CHECK
+/*
+ * Checks the uploaded image against the SHA-256 hash provided with the upload.
+ */
+static bool img_mgmt_upload_data_match(void)
+{
+	static struct flash_img_context ctx;
+	struct flash_img_check fic = {
+		.match = g_img_mgmt_state.data_sha,
+		.clen = g_img_mgmt_state.size,
+	};
+
+#if defined(CONFIG_IMG_STREAM_IMAGE_CHECK) || defined(CONFIG_MCUMGR_GRP_IMG_DELTA)
+	/* The hash computed as the image was written covers the data now in the slot, reading
+	 * it back would give the same result. The slot of a patch upload holds the image
+	 * resulting from the patch, which the hash of the upload does not apply to.
+	 */
+	if (img_mgmt_written_image_data_checked()) {
+		if (!img_mgmt_written_image_data_match()) {
+			LOG_ERR("Uploaded image sha256 hash verification failed");
+			return false;
+		}
+
+		return true;
+	}
+#endif
+
+	if (flash_img_init_id(&ctx, g_img_mgmt_state.area_id) != 0) {
+		LOG_ERR("Uploaded image sha256 could not be checked");
+		return false;
+	}
+
+	if (flash_img_check(&ctx, &fic, g_img_mgmt_state.area_id) != 0) {
+		LOG_ERR("Uploaded image sha256 hash verification failed");
+		return false;
+	}
+
+	return true;
+}
+#endif
+
 /*
  * Resets upload status to defaults (no upload in progress)
  */
@@ -314,6 +490,9 @@ static void img_mgmt_reset_upload(void)
 	img_mgmt_take_lock();
 	memset(&g_img_mgmt_state, 0, sizeof(g_img_mgmt_state));
 	g_img_mgmt_state.area_id = -1;
+#if defined(CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW)
+	img_mgmt_window_reset();
+#endif
 	img_mgmt_release_lock();
 }
 
@@ -402,6 +581,11 @@ img_mgmt_upload_good_rsp(struct smp_streamer *ctxt)
 	ok = ok && zcbor_tstr_put_lit(zse, "off")		&&
 		   zcbor_size_put(zse, g_img_mgmt_state.off);
 
+#if defined(CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW)
+	ok = ok && zcbor_tstr_put_lit(zse, "win")		&&
+		   zcbor_uint32_put(zse, CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW_SIZE);
+#endif
+
 	return ok ? MGMT_ERR_EOK : MGMT_ERR_EMSGSIZE;
 }
 
@@ -456,6 +640,9 @@ img_mgmt_upload(struct smp_streamer *ctxt)
 	struct img_mgmt_upload_action action;
 	bool last = false;
 	bool reset = false;
+#if defined(CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW)
+	bool held = false;
+#endif
 
 #ifdef CONFIG_IMG_ENABLE_IMAGE_CHECK
 	bool data_match = false;
@@ -520,7 +707,7 @@ defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 		goto end;
 	}
 
-	if (!action.proceed) {
+	if (!action.proceed && !action.ahead) {
 		/* Request specifies incorrect offset.  Respond with a success code and
 		 * the correct offset.
 		 */
@@ -565,6 +752,9 @@ defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 #endif
 
 		g_img_mgmt_state.off = 0;
+#if defined(CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW)
+		img_mgmt_window_reset();
+#endif
 
 #if defined(CONFIG_MCUMGR_GRP_IMG_STATUS_HOOKS)
 		(void)mgmt_callback_notify(MGMT_EVT_OP_IMG_MGMT_DFU_STARTED, NULL, 0, &err_rc,
@@ -616,7 +806,16 @@ defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 #ifndef CONFIG_IMG_ERASE_PROGRESSIVELY
 		/* erase the entire req.size all at once */
 		if (action.erase) {
-			rc = img_mgmt_erase_image_data(0, req.size);
+			size_t erase_size = req.size;
+
+#if defined(CONFIG_MCUMGR_GRP_IMG_DELTA)
+			/* A patch results in an image of another size */
+			if (action.patch_target_size > 0) {
+				erase_size = action.patch_target_size;
+			}
+#endif
+
+			rc = img_mgmt_erase_image_data(0, erase_size);
 			if (rc != 0) {
 				IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(&action,
 					img_mgmt_err_str_flash_erase_failed);
@@ -631,6 +830,14 @@ defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 #endif
 	}
 
+#if defined(CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW)
+	if (action.ahead) {
+		/* Keep the data until what is before it has been received */
+		held = img_mgmt_window_store(req.off, req.img_data.value, req.img_data.len);
+		goto end;
+	}
+#endif
+
 	/* Write the image data to flash. */
 	if (req.img_data.len != 0) {
 		/* If this is the last chunk */
@@ -641,8 +848,16 @@ defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 		rc = img_mgmt_write_image_data(req.off, req.img_data.value, action.write_bytes,
 						    last);
 		if (rc == 0) {
-			g_img_mgmt_state.off += action.write_bytes;
-		} else {
+			/* The client sends the data not written again from the offset */
+			g_img_mgmt_state.off += action.write_bytes -
+						img_mgmt_write_image_data_left();
+#if defined(CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW)
+			rc = img_mgmt_window_flush();
+#endif
+			last = (g_img_mgmt_state.off == g_img_mgmt_state.size);
+		}
+
+		if (rc != 0) {
 			/* Write failed, currently not able to recover from this */
 #if defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 			cmd_status_arg.status = IMG_MGMT_ID_UPLOAD_STATUS_COMPLETE;
@@ -665,22 +880,7 @@ defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 			reset = true;
 
 #ifdef CONFIG_IMG_ENABLE_IMAGE_CHECK
-			static struct flash_img_context ctx;
-
-			if (flash_img_init_id(&ctx, g_img_mgmt_state.area_id) == 0) {
-				struct flash_img_check fic = {
-					.match = g_img_mgmt_state.data_sha,
-					.clen = g_img_mgmt_state.size,
-				};
-
-				if (flash_img_check(&ctx, &fic, g_img_mgmt_state.area_id) == 0) {
-					data_match = true;
-				} else {
-					LOG_ERR("Uploaded image sha256 hash verification failed");
-				}
-			} else {
-				LOG_ERR("Uploaded image sha256 could not be checked");
-			}
+			data_match = img_mgmt_upload_data_match();
 #endif
 
 #if defined(CONFIG_MCUMGR_GRP_IMG_STATUS_HOOKS)
@@ -720,6 +920,13 @@ end:
 		}
 #endif
 
+#if defined(CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW)
+		if (held && rc == MGMT_ERR_EOK) {
+			ok = zcbor_tstr_put_lit(zse, "rcv")	&&
+			     zcbor_bool_put(zse, true);
+		}
+#endif
+
 		if (reset) {
 			/* Reset the upload state struct back to default */
 			img_mgmt_reset_upload();
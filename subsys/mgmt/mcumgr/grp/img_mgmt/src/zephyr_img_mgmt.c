@@ -24,6 +24,11 @@
 #include <zephyr/retention/blinfo.h>
 #endif
 
+#if defined(CONFIG_MCUMGR_GRP_IMG_DELTA)
+#include <zephyr/dfu/flash_img_patch.h>
+#include <zephyr/sys/byteorder.h>
+#endif
+
 LOG_MODULE_DECLARE(mcumgr_img_grp, CONFIG_MCUMGR_GRP_IMG_LOG_LEVEL);
 
 #define SLOT0_PARTITION		slot0_partition
@@ -369,6 +374,182 @@ int img_mgmt_read(int slot, unsigned int offset, void *dst, unsigned int num_byt
 	return 0;
 }
 
+#if defined(CONFIG_IMG_STREAM_IMAGE_CHECK) || defined(CONFIG_MCUMGR_GRP_IMG_DELTA)
+/* Whether the last image written matches the hash given for the upload */
+static bool written_data_match;
+
+bool img_mgmt_written_image_data_match(void)
+{
+	return written_data_match;
+}
+#endif
+
+#if defined(CONFIG_IMG_STREAM_IMAGE_CHECK)
+static void img_mgmt_check_written_image_data(struct flash_img_context *ctx)
+{
+	struct flash_img_check fic = {
+		.match = g_img_mgmt_state.data_sha,
+		.clen = g_img_mgmt_state.size,
+	};
+
+	written_data_match = (g_img_mgmt_state.data_sha_len == IMG_MGMT_DATA_SHA_LEN) &&
+			     (flash_img_check_written(ctx, &fic) == 0);
+}
+#endif
+
+#if defined(CONFIG_MCUMGR_GRP_IMG_DELTA)
+static struct flash_img_patch_context patch_ctx;
+/* Whether the upload in progress is a patch against the image in the other slot */
+static bool delta_upload;
+/* Whether the image resulting from the patch must be newer than the running one */
+static bool delta_upgrade;
+/* Number of bytes given to the last write that the patch has not processed yet */
+static unsigned int delta_left;
+
+/*
+ * Returns the area ID of the slot paired with the one of area_id, holding the image a
+ * patch written to area_id applies to, or -1 if there is none.
+ */
+static int img_mgmt_delta_source_area_id(int area_id)
+{
+	for (int slot = 0; slot < 2 * CONFIG_MCUMGR_GRP_IMG_UPDATABLE_IMAGE_NUMBER; slot++) {
+		if (img_mgmt_flash_area_id(slot) == area_id) {
+			return img_mgmt_flash_area_id(img_mgmt_get_opposite_slot(slot));
+		}
+	}
+
+	return -1;
+}
+
+static bool img_mgmt_is_delta_upload(unsigned int offset, const void *data,
+				     unsigned int num_bytes)
+{
+	if (offset == 0) {
+		delta_upload = flash_img_patch_is_patch(data, num_bytes);
+	}
+
+	return delta_upload;
+}
+
+/*
+ * Runs the checks done on the header of an uploaded image, which a patch does not hold,
+ * on the image resulting from the patch. A rejected image is erased so that it cannot be
+ * marked for test.
+ */
+static int img_mgmt_delta_check_image(void)
+{
+	const struct flash_area *fa;
+	struct image_header hdr;
+	struct image_version cur_ver;
+	int rc;
+
+	rc = flash_area_open(g_img_mgmt_state.area_id, &fa);
+	if (rc != 0) {
+		return IMG_MGMT_ERR_FLASH_OPEN_FAILED;
+	}
+
+	rc = flash_area_read(fa, 0, &hdr, sizeof(hdr));
+	if (rc != 0) {
+		flash_area_close(fa);
+		return IMG_MGMT_ERR_FLASH_READ_FAILED;
+	}
+
+	if (hdr.ih_magic != IMAGE_MAGIC) {
+		LOG_ERR("Patched image has no valid header");
+		rc = IMG_MGMT_ERR_INVALID_IMAGE_HEADER_MAGIC;
+	}
+
+#if defined(CONFIG_MCUMGR_GRP_IMG_REJECT_DIRECT_XIP_MISMATCHED_SLOT)
+	if (rc == 0 && (hdr.ih_flags & IMAGE_F_ROM_FIXED) && fa->fa_off != hdr.ih_load_addr) {
+		LOG_ERR("Patched image load address does not match its slot");
+		rc = IMG_MGMT_ERR_INVALID_FLASH_ADDRESS;
+	}
+#endif
+
+	flash_area_close(fa);
+
+	if (rc == 0 && delta_upgrade) {
+		if (img_mgmt_my_version(&cur_ver) != 0) {
+			rc = IMG_MGMT_ERR_VERSION_GET_FAILED;
+		} else if (img_mgmt_vercmp(&cur_ver, &hdr.ih_ver) >= 0) {
+			LOG_ERR("Patched image is not newer than the running one");
+			rc = IMG_MGMT_ERR_CURRENT_VERSION_IS_NEWER;
+		}
+	}
+
+	if (rc != 0) {
+		(void)img_mgmt_erase_image_data(0, sizeof(hdr));
+	}
+
+	return rc;
+}
+
+static int img_mgmt_write_delta_data(unsigned int offset, const void *data,
+				     unsigned int num_bytes, bool last)
+{
+	int source_id;
+	int rc;
+
+	delta_left = 0;
+
+	if (offset == 0) {
+		written_data_match = false;
+
+		source_id = img_mgmt_delta_source_area_id(g_img_mgmt_state.area_id);
+		if (source_id < 0 ||
+		    flash_img_patch_init(&patch_ctx, source_id, g_img_mgmt_state.area_id) != 0) {
+			return IMG_MGMT_ERR_FLASH_OPEN_FAILED;
+		}
+	}
+
+	rc = flash_img_patch_write(&patch_ctx, data, num_bytes, last);
+	if (rc < 0) {
+		LOG_ERR("Failed to apply image patch: %d", rc);
+		return IMG_MGMT_ERR_FLASH_WRITE_FAILED;
+	}
+
+	/* Long copies from the other slot are split over several requests */
+	delta_left = num_bytes - rc;
+	if (!last || delta_left > 0) {
+		return IMG_MGMT_ERR_OK;
+	}
+
+	rc = img_mgmt_delta_check_image();
+	if (rc != IMG_MGMT_ERR_OK) {
+		return rc;
+	}
+
+	/* The image has been checked against the hash in the patch once it is complete */
+	written_data_match = true;
+
+	return IMG_MGMT_ERR_OK;
+}
+#endif
+
+#if defined(CONFIG_IMG_STREAM_IMAGE_CHECK) || defined(CONFIG_MCUMGR_GRP_IMG_DELTA)
+bool img_mgmt_written_image_data_checked(void)
+{
+#if defined(CONFIG_MCUMGR_GRP_IMG_DELTA)
+	if (delta_upload) {
+		return true;
+	}
+#endif
+
+	return IS_ENABLED(CONFIG_IMG_STREAM_IMAGE_CHECK);
+}
+#endif
+
+unsigned int img_mgmt_write_image_data_left(void)
+{
+#if defined(CONFIG_MCUMGR_GRP_IMG_DELTA)
+	if (delta_upload) {
+		return delta_left;
+	}
+#endif
+
+	return 0;
+}
+
 #if defined(CONFIG_MCUMGR_GRP_IMG_USE_HEAP_FOR_FLASH_IMG_CONTEXT)
 int img_mgmt_write_image_data(unsigned int offset, const void *data, unsigned int num_bytes,
 			      bool last)
@@ -384,6 +565,12 @@ int img_mgmt_write_image_data(unsigned int offset, const void *data, unsigned in
 	int rc = IMG_MGMT_ERR_OK;
 	static struct flash_img_context *ctx;
 
+#if defined(CONFIG_MCUMGR_GRP_IMG_DELTA)
+	if (img_mgmt_is_delta_upload(offset, data, num_bytes)) {
+		return img_mgmt_write_delta_data(offset, data, num_bytes, last);
+	}
+#endif
+
 	if (offset != 0 && ctx == NULL) {
 		return IMG_MGMT_ERR_FLASH_CONTEXT_NOT_SET;
 	}
@@ -402,6 +589,10 @@ int img_mgmt_write_image_data(unsigned int offset, const void *data, unsigned in
 			rc = IMG_MGMT_ERR_FLASH_OPEN_FAILED;
 			goto out;
 		}
+
+#if defined(CONFIG_IMG_STREAM_IMAGE_CHECK)
+		written_data_match = false;
+#endif
 	}
 
 	if (flash_img_buffered_write(ctx, data, num_bytes, last) != 0) {
@@ -409,6 +600,12 @@ int img_mgmt_write_image_data(unsigned int offset, const void *data, unsigned in
 		goto out;
 	}
 
+#if defined(CONFIG_IMG_STREAM_IMAGE_CHECK)
+	if (last) {
+		img_mgmt_check_written_image_data(ctx);
+	}
+#endif
+
 out:
 	if (last || rc != MGMT_ERR_EOK) {
 		k_free(ctx);
@@ -423,16 +620,32 @@ int img_mgmt_write_image_data(unsigned int offset, const void *data, unsigned in
 {
 	static struct flash_img_context ctx;
 
+#if defined(CONFIG_MCUMGR_GRP_IMG_DELTA)
+	if (img_mgmt_is_delta_upload(offset, data, num_bytes)) {
+		return img_mgmt_write_delta_data(offset, data, num_bytes, last);
+	}
+#endif
+
 	if (offset == 0) {
 		if (flash_img_init_id(&ctx, g_img_mgmt_state.area_id) != 0) {
 			return IMG_MGMT_ERR_FLASH_OPEN_FAILED;
 		}
+
+#if defined(CONFIG_IMG_STREAM_IMAGE_CHECK)
+		written_data_match = false;
+#endif
 	}
 
 	if (flash_img_buffered_write(&ctx, data, num_bytes, last) != 0) {
 		return IMG_MGMT_ERR_FLASH_WRITE_FAILED;
 	}
 
+#if defined(CONFIG_IMG_STREAM_IMAGE_CHECK)
+	if (last) {
+		img_mgmt_check_written_image_data(&ctx);
+	}
+#endif
+
 	return IMG_MGMT_ERR_OK;
 }
 #endif
@@ -553,6 +766,8 @@ int img_mgmt_upload_inspect(const struct img_mgmt_upload_req *req,
 {
 	const struct image_header *hdr;
 	struct image_version cur_ver;
+	size_t image_size;
+	bool delta = false;
 	int rc;
 
 	memset(action, 0, sizeof(*action));
@@ -592,9 +807,30 @@ int img_mgmt_upload_inspect(const struct img_mgmt_upload_req *req,
 		}
 
 		action->size = req->size;
+		image_size = req->size;
+
+#if defined(CONFIG_MCUMGR_GRP_IMG_DELTA)
+		delta = flash_img_patch_is_patch(req->img_data.value, req->img_data.len);
+
+		if (delta) {
+			const struct flash_img_patch_header *patch_hdr =
+				(const struct flash_img_patch_header *)req->img_data.value;
+
+			/* The patch header is needed to know the size of the resulting image */
+			if (req->img_data.len < sizeof(*patch_hdr)) {
+				IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(action,
+					img_mgmt_err_str_hdr_malformed);
+				return IMG_MGMT_ERR_INVALID_IMAGE_HEADER;
+			}
+
+			/* The slot holds the image resulting from the patch */
+			action->patch_target_size = sys_le32_to_cpu(patch_hdr->target_size);
+			image_size = action->patch_target_size;
+		}
+#endif
 
 		hdr = (struct image_header *)req->img_data.value;
-		if (hdr->ih_magic != IMAGE_MAGIC) {
+		if (!delta && hdr->ih_magic != IMAGE_MAGIC) {
 			IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(action, img_mgmt_err_str_magic_mismatch);
 			return IMG_MGMT_ERR_INVALID_IMAGE_HEADER_MAGIC;
 		}
@@ -633,11 +869,11 @@ int img_mgmt_upload_inspect(const struct img_mgmt_upload_req *req,
 		}
 
 		/* Check that the area is of sufficient size to store the new image */
-		if (req->size > fa->fa_size) {
+		if (image_size > fa->fa_size) {
 			IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(action,
 				img_mgmt_err_str_image_too_large);
 			flash_area_close(fa);
-			LOG_ERR("Upload too large for slot: %u > %u", req->size, fa->fa_size);
+			LOG_ERR("Upload too large for slot: %u > %u", image_size, fa->fa_size);
 			return IMG_MGMT_ERR_INVALID_IMAGE_TOO_LARGE;
 		}
 
@@ -682,11 +918,11 @@ int img_mgmt_upload_inspect(const struct img_mgmt_upload_req *req,
 			goto skip_size_check;
 		}
 
-		if (req->size > (fa->fa_size - CONFIG_MCUBOOT_UPDATE_FOOTER_SIZE)) {
+		if (image_size > (fa->fa_size - CONFIG_MCUBOOT_UPDATE_FOOTER_SIZE)) {
 			IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(action,
 				img_mgmt_err_str_image_too_large);
 			flash_area_close(fa);
-			LOG_ERR("Upload too large for slot (with end offset): %u > %u", req->size,
+			LOG_ERR("Upload too large for slot (with end offset): %u > %u", image_size,
 				(fa->fa_size - CONFIG_MCUBOOT_UPDATE_FOOTER_SIZE));
 			return IMG_MGMT_ERR_INVALID_IMAGE_TOO_LARGE;
 		}
@@ -697,18 +933,19 @@ skip_size_check:
 				   sizeof(max_image_size));
 
 		if (rc == sizeof(max_image_size) && max_image_size > 0 &&
-		    req->size > max_image_size) {
+		    image_size > max_image_size) {
 			IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(action,
 				img_mgmt_err_str_image_too_large);
 			flash_area_close(fa);
 			LOG_ERR("Upload too large for slot (with max image size): %u > %u",
-				req->size, max_image_size);
+				image_size, max_image_size);
 			return IMG_MGMT_ERR_INVALID_IMAGE_TOO_LARGE;
 		}
 #endif
 
 #if defined(CONFIG_MCUMGR_GRP_IMG_REJECT_DIRECT_XIP_MISMATCHED_SLOT)
-		if (hdr->ih_flags & IMAGE_F_ROM_FIXED) {
+		/* Checked on the image resulting from a patch once it is applied */
+		if (!delta && (hdr->ih_flags & IMAGE_F_ROM_FIXED)) {
 			if (fa->fa_off != hdr->ih_load_addr) {
 				IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(action,
 					img_mgmt_err_str_image_bad_flash_addr);
@@ -720,7 +957,14 @@ skip_size_check:
 
 		flash_area_close(fa);
 
-		if (req->upgrade) {
+#if defined(CONFIG_MCUMGR_GRP_IMG_DELTA)
+		/* The version of the image resulting from a patch is only known once it is
+		 * applied, it is checked then.
+		 */
+		delta_upgrade = req->upgrade;
+#endif
+
+		if (req->upgrade && !delta) {
 			/* User specified upgrade-only. Make sure new image version is
 			 * greater than that of the currently running image.
 			 */
@@ -750,6 +994,15 @@ skip_size_check:
 		action->size = g_img_mgmt_state.size;
 
 		if (req->off != g_img_mgmt_state.off) {
+#if defined(CONFIG_MCUMGR_GRP_IMG_UPLOAD_WINDOW)
+			/*
+			 * Data ahead of the offset can be held until the data before it is
+			 * received, if it is within the image.
+			 */
+			action->ahead = (req->off > g_img_mgmt_state.off) &&
+					(action->area_id != -1) &&
+					((req->off + req->img_data.len) <= action->size);
+#endif
 			/*
 			 * Invalid offset. Drop the data, and respond with the offset we're
 			 * expecting data for.
@@ -41,6 +41,27 @@ static struct mcumgr_image_upload *image_upload_buf;
 static K_SEM_DEFINE(mcumgr_img_client_grp_sem, 0, 1);
 static K_MUTEX_DEFINE(mcumgr_img_client_grp_mutex);
 
+/* Upload request sent without waiting for the response to the previous ones */
+struct image_upload_window_req {
+	/* Image data carried by the request */
+	size_t off;
+	size_t len;
+	/* Upload offset and window size in the response, and whether the data is held
+	 * by the server ahead of the offset
+	 */
+	size_t res_off;
+	uint32_t res_win;
+	bool rcv;
+	int32_t status;
+	bool in_flight;
+};
+
+static struct image_upload_window_req
+	image_upload_window_reqs[CONFIG_MCUMGR_GRP_IMG_CLIENT_UPLOAD_WINDOW];
+/* Requests for which a response has been received, in order of arrival */
+K_MSGQ_DEFINE(image_upload_window_msgq, sizeof(struct image_upload_window_req *),
+	      CONFIG_MCUMGR_GRP_IMG_CLIENT_UPLOAD_WINDOW, sizeof(void *));
+
 static const char smp_images_str[] = "images";
 #define IMAGES_STR_LEN (sizeof(smp_images_str) - 1)
 
@@ -218,6 +239,41 @@ end:
 	return rc;
 }
 
+static int image_upload_window_res_fn(struct net_buf *nb, void *user_data)
+{
+	zcbor_state_t zsd[CONFIG_MCUMGR_SMP_CBOR_MAX_DECODING_LEVELS + 2];
+	struct image_upload_window_req *req = user_data;
+	size_t decoded;
+	int rc;
+
+	struct zcbor_map_decode_key_val upload_res_decode[] = {
+		ZCBOR_MAP_DECODE_KEY_DECODER("off", zcbor_size_decode, &req->res_off),
+		ZCBOR_MAP_DECODE_KEY_DECODER("rc", zcbor_int32_decode, &req->status),
+		ZCBOR_MAP_DECODE_KEY_DECODER("win", zcbor_uint32_decode, &req->res_win),
+		ZCBOR_MAP_DECODE_KEY_DECODER("rcv", zcbor_bool_decode, &req->rcv)};
+
+	req->res_off = SIZE_MAX;
+	req->res_win = 0;
+	req->rcv = false;
+	req->status = MGMT_ERR_EOK;
+
+	if (!nb) {
+		req->status = MGMT_ERR_ETIMEOUT;
+		goto end;
+	}
+
+	zcbor_new_decode_state(zsd, ARRAY_SIZE(zsd), nb->data, nb->len, 1, NULL, 0);
+
+	rc = zcbor_map_decode_bulk(zsd, upload_res_decode, ARRAY_SIZE(upload_res_decode), &decoded);
+	if (rc || (req->status == MGMT_ERR_EOK && req->res_off == SIZE_MAX)) {
+		req->status = MGMT_ERR_EINVAL;
+	}
+end:
+	rc = req->status;
+	(void)k_msgq_put(&image_upload_window_msgq, &req, K_NO_WAIT);
+	return rc;
+}
+
 static int erase_res_fn(struct net_buf *nb, void *user_data)
 {
 	zcbor_state_t zsd[CONFIG_MCUMGR_SMP_CBOR_MAX_DECODING_LEVELS + 2];
@@ -299,6 +355,7 @@ void img_mgmt_client_init(struct img_mgmt_client *client, struct smp_client_obje
 	client->smp_client = smp_client;
 	client->image_list_length = image_list_size;
 	client->image_list = image_list;
+	client->upload.window = CONFIG_MCUMGR_GRP_IMG_CLIENT_UPLOAD_WINDOW;
 }
 
 int img_mgmt_client_upload_init(struct img_mgmt_client *client, size_t image_size,
@@ -310,6 +367,7 @@ int img_mgmt_client_upload_init(struct img_mgmt_client *client, size_t image_siz
 	client->upload.image_size = image_size;
 	client->upload.offset = 0;
 	client->upload.image_num = image_num;
+	client->upload.window_size = 0;
 	if (image_hash) {
 		memcpy(client->upload.sha256, image_hash, IMG_MGMT_DATA_SHA_LEN);
 		client->upload.hash_initialized = true;
@@ -328,16 +386,174 @@ int img_mgmt_client_upload_init(struct img_mgmt_client *client, size_t image_siz
 	return rc;
 }
 
+static struct net_buf *upload_request_alloc(struct img_gr_upload *upload_state, size_t offset,
+					    const uint8_t *data, size_t length)
+{
+	struct net_buf *nb;
+	uint32_t map_count;
+	bool ok;
+	zcbor_state_t zse[CONFIG_MCUMGR_SMP_CBOR_MAX_DECODING_LEVELS + 2];
+
+	nb = smp_client_buf_allocation(active_client->smp_client, MGMT_GROUP_ID_IMAGE,
+				       IMG_MGMT_ID_UPLOAD, MGMT_OP_WRITE, SMP_MCUMGR_VERSION_1);
+	if (!nb) {
+		return NULL;
+	}
+
+	zcbor_new_encode_state(zse, ARRAY_SIZE(zse), nb->data + nb->len, net_buf_tailroom(nb), 0);
+	if (offset) {
+		map_count = 6;
+	} else if (upload_state->hash_initialized) {
+		map_count = 12;
+	} else {
+		map_count = 10;
+	}
+
+	/* Init map start and write image info, data and offset */
+	ok = zcbor_map_start_encode(zse, map_count) && zcbor_tstr_put_lit(zse, "image") &&
+	     zcbor_uint32_put(zse, upload_state->image_num) && zcbor_tstr_put_lit(zse, "data") &&
+	     zcbor_bstr_encode_ptr(zse, data, length) && zcbor_tstr_put_lit(zse, "off") &&
+	     zcbor_size_put(zse, offset);
+	/* Write Len and configured hash when offset is zero */
+	if (ok && !offset) {
+		ok = zcbor_tstr_put_lit(zse, "len") && zcbor_size_put(zse, upload_state->image_size);
+		if (ok && upload_state->hash_initialized) {
+			ok = zcbor_tstr_put_lit(zse, "sha") &&
+			     zcbor_bstr_encode_ptr(zse, upload_state->sha256, IMG_MGMT_DATA_SHA_LEN);
+		}
+	}
+
+	if (ok) {
+		ok = zcbor_map_end_encode(zse, map_count);
+	}
+
+	if (!ok) {
+		LOG_ERR("Failed to encode Image Upload packet");
+		smp_packet_free(nb);
+		return NULL;
+	}
+
+	nb->len = zse->payload - nb->data;
+
+	return nb;
+}
+
+/**
+ * Uploads data with several requests in flight, once the server has reported its upload
+ * window. The data of a request may be dropped by the server, when it is received out of
+ * order and cannot be held, in which case it is sent again.
+ */
+static int image_upload_window(const uint8_t *data, size_t length, size_t max_data_length)
+{
+	struct img_gr_upload *upload = &active_client->upload;
+	struct image_upload_window_req *req;
+	struct net_buf *nb;
+	const size_t base = upload->offset;
+	const size_t end = base + length;
+	size_t next = base;
+	size_t write_length;
+	unsigned int in_flight = 0;
+	unsigned int window;
+	int status = MGMT_ERR_EOK;
+	int rc;
+
+	k_msgq_purge(&image_upload_window_msgq);
+
+	while (status == MGMT_ERR_EOK && upload->offset < end) {
+		/* Only one request is in flight until the server reports its window */
+		window = upload->window_size ? upload->window : 1;
+
+		while (next < end && in_flight < window) {
+			write_length = MIN(end - next, max_data_length);
+
+			if (in_flight > 0 && next + write_length - upload->offset > upload->window_size) {
+				break;
+			}
+
+			for (req = image_upload_window_reqs; req->in_flight; req++) {
+			}
+
+			nb = upload_request_alloc(upload, next, data + (next - base), write_length);
+			if (!nb) {
+				status = MGMT_ERR_ENOMEM;
+				break;
+			}
+
+			req->off = next;
+			req->len = write_length;
+			req->in_flight = true;
+
+			rc = smp_client_send_cmd(active_client->smp_client, nb,
+						 image_upload_window_res_fn, req,
+						 CONFIG_MCUMGR_GRP_IMG_FLASH_OPERATION_TIMEOUT);
+			if (rc) {
+				LOG_ERR("Failed to send SMP Upload packet, err: %d", rc);
+				smp_packet_free(nb);
+				req->in_flight = false;
+				status = rc;
+				break;
+			}
+
+			in_flight++;
+			next += write_length;
+		}
+
+		if (in_flight == 0) {
+			/* All the data has been sent but some was dropped, send it again */
+			next = upload->offset;
+			continue;
+		}
+
+		(void)k_msgq_get(&image_upload_window_msgq, &req, K_FOREVER);
+		req->in_flight = false;
+		in_flight--;
+
+		if (status != MGMT_ERR_EOK) {
+			continue;
+		}
+
+		if (req->status) {
+			LOG_ERR("Upload Fail: %d", req->status);
+			status = req->status;
+			continue;
+		}
+
+		if (req->res_off < base) {
+			/* The server is no longer uploading this image */
+			LOG_ERR("Upload offset moved back to %zu", req->res_off);
+			status = MGMT_ERR_EBADSTATE;
+			continue;
+		}
+
+		upload->window_size = req->res_win;
+		upload->offset = MAX(upload->offset, req->res_off);
+
+		if (req->res_off < req->off + req->len && !req->rcv) {
+			/* Dropped by the server, send it again */
+			next = MIN(next, MAX(req->off, upload->offset));
+		}
+
+		/* Skip data already held by the server when resuming an upload */
+		next = MAX(next, upload->offset);
+	}
+
+	/* Wait for the requests still in flight, which use the request slots */
+	while (in_flight > 0) {
+		(void)k_msgq_get(&image_upload_window_msgq, &req, K_FOREVER);
+		req->in_flight = false;
+		in_flight--;
+	}
+
+	return status;
+}
+
 int img_mgmt_client_upload(struct img_mgmt_client *client, const uint8_t *data, size_t length,
 			   struct mcumgr_image_upload *res_buf)
 {
 	struct net_buf *nb;
 	const uint8_t *write_ptr;
 	int rc;
-	uint32_t map_count;
-	bool ok;
 	size_t write_length, max_data_length, offset_before_send, request_length, wrote_length;
-	zcbor_state_t zse[CONFIG_MCUMGR_SMP_CBOR_MAX_DECODING_LEVELS + 2];
 
 	k_mutex_lock(&mcumgr_img_client_grp_mutex, K_FOREVER);
 	active_client = client;
@@ -356,6 +572,12 @@ int img_mgmt_client_upload(struct img_mgmt_client *client, const uint8_t *data,
 			(max_data_length % CONFIG_MCUMGR_GRP_IMG_UPLOAD_DATA_ALIGNMENT_SIZE);
 	}
 
+	if (active_client->upload.window > 1) {
+		image_upload_buf->status = image_upload_window(data, length, max_data_length);
+		image_upload_buf->image_upload_offset = active_client->upload.offset;
+		goto end;
+	}
+
 	while (request_length != wrote_length) {
 		write_ptr = data + wrote_length;
 		write_length = request_length - wrote_length;
@@ -363,55 +585,14 @@ int img_mgmt_client_upload(struct img_mgmt_client *client, const uint8_t *data,
 			write_length = max_data_length;
 		}
 
-		nb = smp_client_buf_allocation(active_client->smp_client, MGMT_GROUP_ID_IMAGE,
-					       IMG_MGMT_ID_UPLOAD, MGMT_OP_WRITE,
-					       SMP_MCUMGR_VERSION_1);
+		nb = upload_request_alloc(&active_client->upload, active_client->upload.offset,
+					  write_ptr, write_length);
 		if (!nb) {
 			image_upload_buf->status = MGMT_ERR_ENOMEM;
 			goto end;
 		}
 
-		zcbor_new_encode_state(zse, ARRAY_SIZE(zse), nb->data + nb->len,
-				       net_buf_tailroom(nb), 0);
-		if (active_client->upload.offset) {
-			map_count = 6;
-		} else if (active_client->upload.hash_initialized) {
-			map_count = 12;
-		} else {
-			map_count = 10;
-		}
-
-		/* Init map start and write image info, data and offset */
-		ok = zcbor_map_start_encode(zse, map_count) && zcbor_tstr_put_lit(zse, "image") &&
-		     zcbor_uint32_put(zse, active_client->upload.image_num) &&
-		     zcbor_tstr_put_lit(zse, "data") &&
-		     zcbor_bstr_encode_ptr(zse, write_ptr, write_length) &&
-		     zcbor_tstr_put_lit(zse, "off") &&
-		     zcbor_size_put(zse, active_client->upload.offset);
-		/* Write Len and configured hash when offset is zero */
-		if (ok && !active_client->upload.offset) {
-			ok = zcbor_tstr_put_lit(zse, "len") &&
-			     zcbor_size_put(zse, active_client->upload.image_size);
-			if (ok && active_client->upload.hash_initialized) {
-				ok = zcbor_tstr_put_lit(zse, "sha") &&
-				     zcbor_bstr_encode_ptr(zse, active_client->upload.sha256,
-							   IMG_MGMT_DATA_SHA_LEN);
-			}
-		}
-
-		if (ok) {
-			ok = zcbor_map_end_encode(zse, map_count);
-		}
-
-		if (!ok) {
-			LOG_ERR("Failed to encode Image Upload packet");
-			smp_packet_free(nb);
-			image_upload_buf->status = MGMT_ERR_ENOMEM;
-			goto end;
-		}
-
 		offset_before_send = active_client->upload.offset;
-		nb->len = zse->payload - nb->data;
 		k_sem_reset(&mcumgr_img_client_grp_sem);
 
 		image_upload_buf->status = MGMT_ERR_EINVAL;
@@ -449,6 +630,19 @@ end:
 	return rc;
 }
 
+int img_mgmt_client_upload_window_set(struct img_mgmt_client *client, unsigned int window)
+{
+	if (window < 1 || window > CONFIG_MCUMGR_GRP_IMG_CLIENT_UPLOAD_WINDOW) {
+		return MGMT_ERR_EINVAL;
+	}
+
+	k_mutex_lock(&mcumgr_img_client_grp_mutex, K_FOREVER);
+	client->upload.window = window;
+	k_mutex_unlock(&mcumgr_img_client_grp_mutex);
+
+	return MGMT_ERR_EOK;
+}
+
 int img_mgmt_client_state_write(struct img_mgmt_client *client, char *hash, bool confirm,
 				struct mcumgr_image_state *res_buf)
 {
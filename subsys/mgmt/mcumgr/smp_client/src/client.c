@@ -38,6 +38,10 @@ struct smp_client_data_base {
 	struct k_work_delayable work_delay;
 	sys_slist_t cmd_free_list;
 	sys_slist_t cmd_list;
+	/* Protects the command lists, which are accessed from the sending threads, the
+	 * transport receiving responses and the timeout work.
+	 */
+	struct k_mutex lock;
 };
 
 static struct smp_client_cmd_req smp_cmd_req_bufs[CONFIG_SMP_CLIENT_CMD_MAX];
@@ -81,6 +85,8 @@ static void smp_client_transport_work_fn(struct k_work *work)
 	struct smp_client_cmd_req *entry, *tmp;
 	smp_client_res_fn cb;
 	void *user_data;
+	sys_slist_t expired;
+	sys_snode_t *node;
 	int backoff_ms = CONFIG_SMP_CMD_RETRY_TIME;
 	int64_t time_stamp_cmp;
 	int64_t time_stamp_ref;
@@ -88,8 +94,12 @@ static void smp_client_transport_work_fn(struct k_work *work)
 
 	ARG_UNUSED(work);
 
+	sys_slist_init(&expired);
+	k_mutex_lock(&smp_client_data.lock, K_FOREVER);
+
 	if (sys_slist_is_empty(&smp_client_data.cmd_list)) {
 		/* No more packet for Transport */
+		k_mutex_unlock(&smp_client_data.lock);
 		return;
 	}
 
@@ -116,6 +126,20 @@ static void smp_client_transport_work_fn(struct k_work *work)
 			continue;
 		}
 
+		/* Timed out, the callback is called once the lock is released */
+		sys_slist_find_and_remove(&smp_client_data.cmd_list, &entry->node);
+		sys_slist_append(&expired, &entry->node);
+	}
+
+	if (!sys_slist_is_empty(&smp_client_data.cmd_list)) {
+		/* Re-schedule new timeout to next */
+		k_work_reschedule(&smp_client_data.work_delay, K_MSEC(backoff_ms));
+	}
+
+	k_mutex_unlock(&smp_client_data.lock);
+
+	while ((node = sys_slist_get(&expired)) != NULL) {
+		entry = SYS_SLIST_CONTAINER(node, entry, node);
 		cb = entry->cb;
 		user_data = entry->user_data;
 		smp_client_cmd_req_free(entry);
@@ -123,16 +147,12 @@ static void smp_client_transport_work_fn(struct k_work *work)
 			cb(NULL, user_data);
 		}
 	}
-
-	if (!sys_slist_is_empty(&smp_client_data.cmd_list)) {
-		/* Re-schedule new timeout to next */
-		k_work_reschedule(&smp_client_data.work_delay, K_MSEC(backoff_ms));
-	}
 }
 
 static int smp_client_init(void)
 {
 	k_work_init_delayable(&smp_client_data.work_delay, smp_client_transport_work_fn);
+	k_mutex_init(&smp_client_data.lock);
 	sys_slist_init(&smp_client_data.cmd_list);
 	sys_slist_init(&smp_client_data.cmd_free_list);
 	for (int i = 0; i < CONFIG_SMP_CLIENT_CMD_MAX; i++) {
@@ -146,7 +166,9 @@ static struct smp_client_cmd_req *smp_client_cmd_req_allocate(void)
 	sys_snode_t *cmd_node;
 	struct smp_client_cmd_req *req;
 
+	k_mutex_lock(&smp_client_data.lock, K_FOREVER);
 	cmd_node = sys_slist_get(&smp_client_data.cmd_free_list);
+	k_mutex_unlock(&smp_client_data.lock);
 	if (!cmd_node) {
 		return NULL;
 	}
@@ -158,15 +180,18 @@ static struct smp_client_cmd_req *smp_client_cmd_req_allocate(void)
 
 static void smp_cmd_add_to_list(struct smp_client_cmd_req *cmd_req)
 {
+	k_mutex_lock(&smp_client_data.lock, K_FOREVER);
 	if (sys_slist_is_empty(&smp_client_data.cmd_list)) {
 		/* Enable timer */
 		k_work_reschedule(&smp_client_data.work_delay, K_MSEC(CONFIG_SMP_CMD_RETRY_TIME));
 	}
 	sys_slist_append(&smp_client_data.cmd_list, &cmd_req->node);
+	k_mutex_unlock(&smp_client_data.lock);
 }
 
 static void smp_client_cmd_req_free(struct smp_client_cmd_req *cmd_req)
 {
+	k_mutex_lock(&smp_client_data.lock, K_FOREVER);
 	smp_client_buf_free(cmd_req->nb);
 	cmd_req->nb = NULL;
 	sys_slist_find_and_remove(&smp_client_data.cmd_list, &cmd_req->node);
@@ -177,6 +202,7 @@ static void smp_client_cmd_req_free(struct smp_client_cmd_req *cmd_req)
 		/* cancel delay */
 		k_work_cancel_delayable(&smp_client_data.work_delay);
 	}
+	k_mutex_unlock(&smp_client_data.lock);
 }
 
 static struct smp_client_cmd_req *smp_client_response_discover(const struct smp_hdr *res_hdr)
@@ -228,8 +254,15 @@ int smp_client_single_response(struct net_buf *nb, const struct smp_hdr *res_hdr
 	smp_client_res_fn cb;
 	void *user_data;
 
-	/* Discover request for incoming response */
+	/* Discover request for incoming response, and take it out of the list so that it
+	 * is not completed twice.
+	 */
+	k_mutex_lock(&smp_client_data.lock, K_FOREVER);
 	cmd_req = smp_client_response_discover(res_hdr);
+	if (cmd_req) {
+		sys_slist_find_and_remove(&smp_client_data.cmd_list, &cmd_req->node);
+	}
+	k_mutex_unlock(&smp_client_data.lock);
 	LOG_DBG("Response Header len %d, flags %d OP: %d group %d id %d seq %d", res_hdr->nh_len,
 		res_hdr->nh_flags, res_hdr->nh_op, res_hdr->nh_group, res_hdr->nh_id,
 		res_hdr->nh_seq);
@@ -258,8 +291,10 @@ struct net_buf *smp_client_buf_allocation(struct smp_client_object *smp_client,
 
 	if (nb) {
 		/* Write SMP header with payload length 0 */
+		k_mutex_lock(&smp_client_data.lock, K_FOREVER);
 		smp_header_init(&smp_header, group, command_id, op, 0, smp_client->smp_seq++,
 				version);
+		k_mutex_unlock(&smp_client_data.lock);
 		memcpy(nb->data, &smp_header, sizeof(smp_header));
 		nb->len = sizeof(smp_header);
 	}
@@ -120,6 +120,11 @@ LOG_MODULE_REGISTER(net_pkt, CONFIG_NET_PKT_LOG_LEVEL);
 K_MEM_SLAB_DEFINE(rx_pkts, sizeof(struct net_pkt), CONFIG_NET_PKT_RX_COUNT, 4);
 K_MEM_SLAB_DEFINE(tx_pkts, sizeof(struct net_pkt), CONFIG_NET_PKT_TX_COUNT, 4);
 
+#if defined(CONFIG_NET_PKT_CPU_CACHE)
+K_MEM_SLAB_CPU_CACHE_DEFINE(rx_pkts_cache);
+K_MEM_SLAB_CPU_CACHE_DEFINE(tx_pkts_cache);
+#endif
+
 #if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
 
 NET_BUF_POOL_FIXED_DEFINE(rx_bufs, CONFIG_NET_BUF_RX_COUNT, CONFIG_NET_BUF_DATA_SIZE,
@@ -2190,6 +2195,11 @@ int net_pkt_set_data(struct net_pkt *pkt,
 
 void net_pkt_init(void)
 {
+#if defined(CONFIG_NET_PKT_CPU_CACHE)
+	(void)k_mem_slab_cpu_cache_enable(&rx_pkts, rx_pkts_cache);
+	(void)k_mem_slab_cpu_cache_enable(&tx_pkts, tx_pkts_cache);
+#endif
+
 #if CONFIG_NET_PKT_LOG_LEVEL >= LOG_LEVEL_DBG
 	NET_DBG("Allocating %u RX (%zu bytes), %u TX (%zu bytes), "
 		"%d RX data (%u bytes) and %d TX data (%u bytes) buffers",
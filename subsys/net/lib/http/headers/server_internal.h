@@ -37,7 +37,12 @@ int enter_http_done_state(struct http_client_ctx *client);
 
 /* Others */
 struct http_resource_detail *get_resource_detail(const char *path, int *len, bool is_ws);
+void http_server_resource_index_init(void);
 int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t len);
+bool http_server_acquire_resource(struct http_resource_detail_dynamic *dynamic_detail,
+				  struct http_client_ctx *client);
+bool http_server_release_resource(struct http_resource_detail_dynamic *dynamic_detail,
+				  struct http_client_ctx *client);
 void http_client_timer_restart(struct http_client_ctx *client);
 
 /* TODO Could be static, but currently used in tests. */
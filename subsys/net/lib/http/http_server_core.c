@@ -40,21 +40,48 @@ LOG_MODULE_REGISTER(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 #define HTTP_SERVER_MAX_CLIENTS  CONFIG_HTTP_SERVER_MAX_CLIENTS
 #define HTTP_SERVER_SOCK_COUNT (1 + HTTP_SERVER_MAX_SERVICES + HTTP_SERVER_MAX_CLIENTS)
 
+#define HTTP_SERVER_WORKERS CONFIG_HTTP_SERVER_WORKERS
+
 struct http_server_ctx {
-	int num_clients;
+	atomic_t num_clients;
 	int listen_fds; /* max value of 1 + MAX_SERVICES */
 
-	/* First pollfd is eventfd that can be used to stop the server,
+	/* First pollfd is eventfd that can be used to stop the server or
+	 * to wake it up when a worker has finished processing a client,
 	 * then we have the server listen sockets,
 	 * and then the accepted sockets.
 	 */
 	struct zsock_pollfd fds[HTTP_SERVER_SOCK_COUNT];
 	struct http_client_ctx clients[HTTP_SERVER_MAX_CLIENTS];
+
+#if HTTP_SERVER_WORKERS > 0
+	/* Clients currently handed over to a worker thread. Their pollfd
+	 * slot is parked (set to INVALID_SOCK) until the worker is done.
+	 */
+	ATOMIC_DEFINE(busy, HTTP_SERVER_MAX_CLIENTS);
+
+	/* Clients that a worker has finished with and that should be
+	 * polled again by the server thread.
+	 */
+	ATOMIC_DEFINE(rearm, HTTP_SERVER_MAX_CLIENTS);
+#endif
 };
 
 static struct http_server_ctx server_ctx;
 static K_SEM_DEFINE(server_start, 0, 1);
 static bool server_running;
+static atomic_t server_stop_requested;
+static struct k_spinlock resource_lock;
+
+#if HTTP_SERVER_WORKERS > 0
+K_MSGQ_DEFINE(http_server_worker_msgq, sizeof(struct http_client_ctx *),
+	      HTTP_SERVER_MAX_CLIENTS, sizeof(void *));
+static K_THREAD_STACK_ARRAY_DEFINE(http_server_worker_stacks, HTTP_SERVER_WORKERS,
+				   CONFIG_HTTP_SERVER_WORKER_STACK_SIZE);
+static struct k_thread http_server_workers[HTTP_SERVER_WORKERS];
+/* Given by the workers each time they are done with a client */
+static K_SEM_DEFINE(http_server_worker_done, 0, 1);
+#endif
 
 int http_server_init(struct http_server_ctx *ctx)
 {
@@ -82,6 +109,10 @@ int http_server_init(struct http_server_ctx *ctx)
 		ctx->fds[i].fd = INVALID_SOCK;
 	}
 
+	for (i = 0; i < ARRAY_SIZE(ctx->clients); i++) {
+		ctx->clients[i].fd = INVALID_SOCK;
+	}
+
 	/* Create an eventfd that can be used to trigger events during polling */
 	fd = eventfd(0, 0);
 	if (fd < 0) {
@@ -213,7 +244,9 @@ int http_server_init(struct http_server_ctx *ctx)
 	}
 
 	ctx->listen_fds = count;
-	ctx->num_clients = 0;
+	atomic_set(&ctx->num_clients, 0);
+
+	http_server_resource_index_init();
 
 	return 0;
 }
@@ -273,15 +306,13 @@ static void client_release_resources(struct http_client_ctx *client)
 
 			dynamic_detail = (struct http_resource_detail_dynamic *)detail;
 
-			if (dynamic_detail->holder != client) {
-				continue;
-			}
-
 			/* If the client still holds the resource at this point,
 			 * it means the transaction was not complete. Release
 			 * the resource and notify application.
 			 */
-			dynamic_detail->holder = NULL;
+			if (!http_server_release_resource(dynamic_detail, client)) {
+				continue;
+			}
 
 			if (dynamic_detail->cb == NULL) {
 				continue;
@@ -303,7 +334,7 @@ void http_server_release_client(struct http_client_ctx *client)
 	k_work_cancel_delayable_sync(&client->inactivity_timer, &sync);
 	client_release_resources(client);
 
-	server_ctx.num_clients--;
+	atomic_dec(&server_ctx.num_clients);
 
 	for (i = server_ctx.listen_fds; i < ARRAY_SIZE(server_ctx.fds); i++) {
 		if (server_ctx.fds[i].fd == client->fd) {
@@ -462,6 +493,198 @@ static int handle_http_request(struct http_client_ctx *client)
 	return 0;
 }
 
+static void handle_client_data(struct http_client_ctx *client)
+{
+	int ret;
+
+	ret = zsock_recv(client->fd, client->buffer + client->data_len,
+			 sizeof(client->buffer) - client->data_len, 0);
+	if (ret <= 0) {
+		if (ret == 0) {
+			LOG_DBG("Connection closed by peer for client #%d",
+				(int)ARRAY_INDEX(server_ctx.clients, client));
+		} else {
+			ret = -errno;
+			LOG_DBG("ERROR reading from socket (%d)", ret);
+		}
+
+		close_client_connection(client);
+		return;
+	}
+
+	client->data_len += ret;
+
+	http_client_timer_restart(client);
+
+	ret = handle_http_request(client);
+	if (ret < 0 && ret != -EAGAIN) {
+		if (ret == -ENOTCONN) {
+			LOG_DBG("Client closed connection while handling request");
+		} else {
+			LOG_ERR("HTTP request handling error (%d)", ret);
+		}
+		close_client_connection(client);
+	} else if (client->data_len == sizeof(client->buffer)) {
+		/* If the RX buffer is still full after parsing,
+		 * it means we won't be able to handle this request
+		 * with the current buffer size.
+		 */
+		LOG_ERR("RX buffer too small to handle request");
+		close_client_connection(client);
+	}
+}
+
+#if HTTP_SERVER_WORKERS > 0
+static void dispatch_client(struct http_server_ctx *ctx, int idx)
+{
+	int client_idx = idx - ctx->listen_fds;
+	struct http_client_ctx *client = &ctx->clients[client_idx];
+
+	/* Park the pollfd slot so that the socket is not polled while a
+	 * worker owns the client. The slot cannot be reused as the busy
+	 * bit is set.
+	 */
+	atomic_set_bit(ctx->busy, client_idx);
+	ctx->fds[idx].fd = INVALID_SOCK;
+
+	if (k_msgq_put(&http_server_worker_msgq, &client, K_NO_WAIT) < 0) {
+		/* Cannot happen, the queue holds one entry per client. */
+		LOG_ERR("Worker queue full, client #%d dropped", client_idx);
+		atomic_clear_bit(ctx->busy, client_idx);
+		close_client_connection(client);
+	}
+}
+
+static void rearm_clients(struct http_server_ctx *ctx)
+{
+	for (int i = 0; i < ARRAY_SIZE(ctx->clients); i++) {
+		if (!atomic_test_and_clear_bit(ctx->rearm, i)) {
+			continue;
+		}
+
+		ctx->fds[ctx->listen_fds + i].fd = ctx->clients[i].fd;
+		ctx->fds[ctx->listen_fds + i].events = ZSOCK_POLLIN;
+		ctx->fds[ctx->listen_fds + i].revents = 0;
+	}
+}
+
+static bool client_slot_in_use(struct http_server_ctx *ctx, int client_idx)
+{
+	return atomic_test_bit(ctx->busy, client_idx) ||
+	       atomic_test_bit(ctx->rearm, client_idx);
+}
+
+static bool workers_busy(struct http_server_ctx *ctx)
+{
+	ARRAY_FOR_EACH(ctx->clients, i) {
+		if (atomic_test_bit(ctx->busy, i)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void wait_for_workers(struct http_server_ctx *ctx)
+{
+	/* Shut down the sockets owned by workers, so that they finish
+	 * quickly, and wait for them before the client contexts are closed.
+	 */
+	ARRAY_FOR_EACH(ctx->clients, i) {
+		if (atomic_test_bit(ctx->busy, i)) {
+			(void)zsock_shutdown(ctx->clients[i].fd, ZSOCK_SHUT_RD);
+		}
+	}
+
+	/* A worker gives the semaphore after clearing its busy bit, so it
+	 * cannot be missed. It may also have been given before, in which
+	 * case the busy bits are just checked again.
+	 */
+	while (workers_busy(ctx)) {
+		k_sem_take(&http_server_worker_done, K_FOREVER);
+	}
+
+	rearm_clients(ctx);
+}
+
+static void http_server_worker(void *p1, void *p2, void *p3)
+{
+	struct http_server_ctx *ctx = p1;
+	struct http_client_ctx *client;
+	int client_idx;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_msgq_get(&http_server_worker_msgq, &client, K_FOREVER);
+
+		client_idx = ARRAY_INDEX(ctx->clients, client);
+
+		handle_client_data(client);
+
+		/* The client context is owned by this worker until the busy
+		 * bit is cleared, so it is safe to check if the connection
+		 * was closed while processing.
+		 */
+		if (client->fd != INVALID_SOCK) {
+			atomic_set_bit(ctx->rearm, client_idx);
+		}
+
+		eventfd_write(ctx->fds[0].fd, 1);
+		atomic_clear_bit(ctx->busy, client_idx);
+		k_sem_give(&http_server_worker_done);
+	}
+}
+
+static void start_workers(void)
+{
+	static bool started;
+
+	if (started) {
+		return;
+	}
+
+	for (int i = 0; i < HTTP_SERVER_WORKERS; i++) {
+		k_thread_create(&http_server_workers[i], http_server_worker_stacks[i],
+				K_THREAD_STACK_SIZEOF(http_server_worker_stacks[i]),
+				http_server_worker, &server_ctx, NULL, NULL,
+				THREAD_PRIORITY, 0, K_NO_WAIT);
+		k_thread_name_set(&http_server_workers[i], "http_server_worker");
+	}
+
+	started = true;
+}
+#else
+static inline void dispatch_client(struct http_server_ctx *ctx, int idx)
+{
+	ARG_UNUSED(ctx);
+	ARG_UNUSED(idx);
+}
+
+static inline void rearm_clients(struct http_server_ctx *ctx)
+{
+	ARG_UNUSED(ctx);
+}
+
+static inline bool client_slot_in_use(struct http_server_ctx *ctx, int client_idx)
+{
+	ARG_UNUSED(ctx);
+	ARG_UNUSED(client_idx);
+
+	return false;
+}
+
+static inline void wait_for_workers(struct http_server_ctx *ctx)
+{
+	ARG_UNUSED(ctx);
+}
+
+static inline void start_workers(void)
+{
+}
+#endif /* HTTP_SERVER_WORKERS > 0 */
+
 static int http_server_run(struct http_server_ctx *ctx)
 {
 	struct http_client_ctx *client;
@@ -487,10 +710,20 @@ static int http_server_run(struct http_server_ctx *ctx)
 			break;
 		}
 
-		if (ret == 1 && ctx->fds[0].revents) {
+		if (ctx->fds[0].revents) {
 			eventfd_read(ctx->fds[0].fd, &value);
-			LOG_DBG("Received stop event. exiting ..");
-			goto closing;
+
+			if (atomic_cas(&server_stop_requested, 1, 0)) {
+				LOG_DBG("Received stop event. exiting ..");
+				goto closing;
+			}
+
+			/* Woken up by a worker, poll its client again. */
+			rearm_clients(ctx);
+
+			if (ret == 1) {
+				continue;
+			}
 		}
 
 		for (i = 1; i < ARRAY_SIZE(ctx->fds); i++) {
@@ -543,7 +776,8 @@ static int http_server_run(struct http_server_ctx *ctx)
 				found_slot = false;
 
 				for (j = ctx->listen_fds; j < ARRAY_SIZE(ctx->fds); j++) {
-					if (ctx->fds[j].fd != INVALID_SOCK) {
+					if (ctx->fds[j].fd != INVALID_SOCK ||
+					    client_slot_in_use(ctx, j - ctx->listen_fds)) {
 						continue;
 					}
 
@@ -551,7 +785,7 @@ static int http_server_run(struct http_server_ctx *ctx)
 					ctx->fds[j].events = ZSOCK_POLLIN;
 					ctx->fds[j].revents = 0;
 
-					ctx->num_clients++;
+					atomic_inc(&ctx->num_clients);
 
 					LOG_DBG("Init client #%d", j - ctx->listen_fds);
 
@@ -572,47 +806,20 @@ static int http_server_run(struct http_server_ctx *ctx)
 			/* Client sock */
 			client = &ctx->clients[i - ctx->listen_fds];
 
-			ret = zsock_recv(client->fd, client->buffer + client->data_len,
-					 sizeof(client->buffer) - client->data_len, 0);
-			if (ret <= 0) {
-				if (ret == 0) {
-					LOG_DBG("Connection closed by peer for client #%d",
-						i - ctx->listen_fds);
-				} else {
-					ret = -errno;
-					LOG_DBG("ERROR reading from socket (%d)", ret);
-				}
-
-				close_client_connection(client);
+			if (HTTP_SERVER_WORKERS > 0) {
+				dispatch_client(ctx, i);
 				continue;
 			}
 
-			client->data_len += ret;
-
-			http_client_timer_restart(client);
-
-			ret = handle_http_request(client);
-			if (ret < 0 && ret != -EAGAIN) {
-				if (ret == -ENOTCONN) {
-					LOG_DBG("Client closed connection while handling request");
-				} else {
-					LOG_ERR("HTTP request handling error (%d)", ret);
-				}
-				close_client_connection(client);
-			} else if (client->data_len == sizeof(client->buffer)) {
-				/* If the RX buffer is still full after parsing,
-				 * it means we won't be able to handle this request
-				 * with the current buffer size.
-				 */
-				LOG_ERR("RX buffer too small to handle request");
-				close_client_connection(client);
-			}
+			handle_client_data(client);
 		}
 	}
 
 	return 0;
 
 closing:
+	wait_for_workers(ctx);
+
 	/* Close all client connections and the server socket */
 	return close_all_sockets(ctx);
 }
@@ -652,10 +859,189 @@ static bool skip_this(struct http_resource_desc *resource, bool is_websocket)
 	return false;
 }
 
+#if defined(CONFIG_HTTP_SERVER_RESOURCE_INDEX)
+struct resource_index_entry {
+	struct http_resource_desc *resource;
+	/* Length of the literal prefix preceding the first wildcard
+	 * character (wildcard resources only).
+	 */
+	size_t literal_len;
+};
+
+struct resource_index {
+	/* Resources with a literal path first, sorted by path, followed by
+	 * wildcard resources in definition order.
+	 */
+	struct resource_index_entry entries[CONFIG_HTTP_SERVER_RESOURCE_INDEX_SIZE];
+	size_t exact_count;
+	size_t count;
+	bool valid;
+};
+
+static struct resource_index resource_index;
+
+static inline char path_char(char c)
+{
+	/* Query string is not part of the path. */
+	return (c == '?') ? '\0' : c;
+}
+
+/* Same matching rules as compare_strings(), but with ordering. */
+static int compare_paths(const char *s1, const char *s2)
+{
+	while (path_char(*s1) != '\0' && path_char(*s1) == path_char(*s2)) {
+		s1++;
+		s2++;
+	}
+
+	return (unsigned char)path_char(*s1) - (unsigned char)path_char(*s2);
+}
+
+static int compare_index_entries(const void *a, const void *b)
+{
+	const struct resource_index_entry *e1 = a;
+	const struct resource_index_entry *e2 = b;
+	int ret;
+
+	ret = compare_paths(e1->resource->resource, e2->resource->resource);
+	if (ret != 0) {
+		return ret;
+	}
+
+	/* Keep definition order for duplicate paths. */
+	return (e1->resource > e2->resource) - (e1->resource < e2->resource);
+}
+
+static bool is_wildcard_resource(const char *resource)
+{
+	return IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD) &&
+	       strpbrk(resource, "*?[\\") != NULL;
+}
+
+void http_server_resource_index_init(void)
+{
+	struct resource_index_entry *entry;
+	size_t exact = 0;
+	size_t count = 0;
+
+	resource_index.valid = false;
+
+	HTTP_SERVICE_FOREACH(service) {
+		HTTP_SERVICE_FOREACH_RESOURCE(service, resource) {
+			if (!is_wildcard_resource(resource->resource)) {
+				exact++;
+			}
+
+			count++;
+		}
+	}
+
+	if (count > ARRAY_SIZE(resource_index.entries)) {
+		LOG_WRN("Too many resources to index (%zu), "
+			"increase CONFIG_HTTP_SERVER_RESOURCE_INDEX_SIZE", count);
+		return;
+	}
+
+	resource_index.exact_count = 0;
+	resource_index.count = exact;
+
+	HTTP_SERVICE_FOREACH(service) {
+		HTTP_SERVICE_FOREACH_RESOURCE(service, resource) {
+			if (is_wildcard_resource(resource->resource)) {
+				entry = &resource_index.entries[resource_index.count++];
+				entry->literal_len = strcspn(resource->resource, "*?[\\");
+			} else {
+				entry = &resource_index.entries[resource_index.exact_count++];
+				entry->literal_len = 0;
+			}
+
+			entry->resource = resource;
+		}
+	}
+
+	qsort(resource_index.entries, resource_index.exact_count,
+	      sizeof(resource_index.entries[0]), compare_index_entries);
+
+	resource_index.valid = true;
+}
+
+static struct http_resource_desc *resource_index_find(const char *path, bool is_websocket)
+{
+	struct resource_index_entry *entry;
+	size_t low = 0;
+	size_t high = resource_index.exact_count;
+	size_t mid;
+
+	/* Find the first literal resource not lower than the path. */
+	while (low < high) {
+		mid = low + (high - low) / 2;
+
+		if (compare_paths(resource_index.entries[mid].resource->resource, path) < 0) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	for (; low < resource_index.exact_count; low++) {
+		entry = &resource_index.entries[low];
+
+		if (compare_paths(path, entry->resource->resource) != 0) {
+			break;
+		}
+
+		if (!skip_this(entry->resource, is_websocket)) {
+			return entry->resource;
+		}
+	}
+
+	for (size_t i = resource_index.exact_count; i < resource_index.count; i++) {
+		entry = &resource_index.entries[i];
+
+		if (skip_this(entry->resource, is_websocket)) {
+			continue;
+		}
+
+		/* Only patterns whose literal prefix matches are candidates. */
+		if (strncmp(path, entry->resource->resource, entry->literal_len) != 0) {
+			continue;
+		}
+
+		if (fnmatch(entry->resource->resource, path, FNM_PATHNAME) == 0 ||
+		    compare_strings(path, entry->resource->resource) == 0) {
+			return entry->resource;
+		}
+	}
+
+	return NULL;
+}
+#else
+void http_server_resource_index_init(void)
+{
+}
+#endif /* CONFIG_HTTP_SERVER_RESOURCE_INDEX */
+
 struct http_resource_detail *get_resource_detail(const char *path,
 						 int *path_len,
 						 bool is_websocket)
 {
+#if defined(CONFIG_HTTP_SERVER_RESOURCE_INDEX)
+	if (resource_index.valid) {
+		struct http_resource_desc *resource;
+
+		resource = resource_index_find(path, is_websocket);
+		if (resource == NULL) {
+			NET_DBG("No match for %s", path);
+			return NULL;
+		}
+
+		NET_DBG("Got match for %s", resource->resource);
+
+		*path_len = strlen(resource->resource);
+		return resource->detail;
+	}
+#endif
+
 	HTTP_SERVICE_FOREACH(service) {
 		HTTP_SERVICE_FOREACH_RESOURCE(service, resource) {
 			if (skip_this(resource, is_websocket)) {
@@ -686,6 +1072,46 @@ struct http_resource_detail *get_resource_detail(const char *path,
 	return NULL;
 }
 
+bool http_server_acquire_resource(struct http_resource_detail_dynamic *dynamic_detail,
+				  struct http_client_ctx *client)
+{
+	k_spinlock_key_t key;
+	bool acquired = true;
+
+	/* Clients may be processed concurrently by worker threads, so the
+	 * holder has to be checked and set atomically.
+	 */
+	key = k_spin_lock(&resource_lock);
+
+	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+		acquired = false;
+	} else {
+		dynamic_detail->holder = client;
+	}
+
+	k_spin_unlock(&resource_lock, key);
+
+	return acquired;
+}
+
+bool http_server_release_resource(struct http_resource_detail_dynamic *dynamic_detail,
+				  struct http_client_ctx *client)
+{
+	k_spinlock_key_t key;
+	bool released = false;
+
+	key = k_spin_lock(&resource_lock);
+
+	if (dynamic_detail->holder == client) {
+		dynamic_detail->holder = NULL;
+		released = true;
+	}
+
+	k_spin_unlock(&resource_lock, key);
+
+	return released;
+}
+
 int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t len)
 {
 	while (len) {
@@ -728,6 +1154,7 @@ int http_server_stop(void)
 
 	server_running = false;
 	k_sem_reset(&server_start);
+	atomic_set(&server_stop_requested, 1);
 	eventfd_write(server_ctx.fds[0].fd, 1);
 
 	LOG_DBG("Stopping HTTP server");
@@ -743,6 +1170,8 @@ static void http_server_thread(void *p1, void *p2, void *p3)
 	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
+	start_workers();
+
 	while (true) {
 		k_sem_take(&server_start, K_FOREVER);
 
@@ -165,7 +165,7 @@ static int dynamic_get_req(struct http_resource_detail_dynamic *dynamic_detail,
 		break;
 	}
 
-	dynamic_detail->holder = NULL;
+	(void)http_server_release_resource(dynamic_detail, client);
 
 	ret = http_server_sendall(client, final_chunk,
 				  sizeof(final_chunk) - 1);
@@ -248,7 +248,7 @@ static int dynamic_post_req(struct http_resource_detail_dynamic *dynamic_detail,
 			return ret;
 		}
 
-		dynamic_detail->holder = NULL;
+		(void)http_server_release_resource(dynamic_detail, client);
 	}
 
 	return 0;
@@ -271,7 +271,7 @@ static int handle_http1_dynamic_resource(
 		return -ENOPROTOOPT;
 	}
 
-	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+	if (!http_server_acquire_resource(dynamic_detail, client)) {
 		static const char conflict_response[] =
 				"HTTP/1.1 409 Conflict\r\n\r\n";
 
@@ -285,8 +285,6 @@ static int handle_http1_dynamic_resource(
 		return enter_http_done_state(client);
 	}
 
-	dynamic_detail->holder = client;
-
 	switch (client->method) {
 	case HTTP_HEAD:
 		if (user_method & BIT(HTTP_HEAD)) {
@@ -296,7 +294,7 @@ static int handle_http1_dynamic_resource(
 				return ret;
 			}
 
-			dynamic_detail->holder = NULL;
+			(void)http_server_release_resource(dynamic_detail, client);
 
 			return 0;
 		}
@@ -437,7 +437,7 @@ static int dynamic_get_req_v2(struct http_resource_detail_dynamic *dynamic_detai
 			LOG_DBG("Cannot send last frame (%d)", ret);
 		}
 
-		dynamic_detail->holder = NULL;
+		(void)http_server_release_resource(dynamic_detail, client);
 
 		break;
 	}
@@ -537,7 +537,7 @@ static int dynamic_post_req_v2(struct http_resource_detail_dynamic *dynamic_deta
 			client->headers_sent = true;
 		}
 
-		dynamic_detail->holder = NULL;
+		(void)http_server_release_resource(dynamic_detail, client);
 	}
 
 
@@ -561,7 +561,7 @@ static int handle_http2_dynamic_resource(
 		return -ENOPROTOOPT;
 	}
 
-	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+	if (!http_server_acquire_resource(dynamic_detail, client)) {
 		ret = send_http2_409(client, frame);
 		if (ret < 0) {
 			return ret;
@@ -570,8 +570,6 @@ static int handle_http2_dynamic_resource(
 		return enter_http_done_state(client);
 	}
 
-	dynamic_detail->holder = client;
-
 	switch (client->method) {
 	case HTTP_GET:
 		if (user_method & BIT(HTTP_GET)) {
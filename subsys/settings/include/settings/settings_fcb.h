@@ -18,6 +18,11 @@ extern "C" {
 struct settings_fcb {
 	struct settings_store cf_store;
 	struct fcb cf_fcb;
+#ifdef CONFIG_SETTINGS_FCB_INDEX
+	/* Most recent entry for each setting name hash */
+	struct fcb_entry cf_index[CONFIG_SETTINGS_FCB_INDEX_SIZE];
+	bool cf_index_built;
+#endif
 };
 
 extern int settings_fcb_src(struct settings_fcb *cf);
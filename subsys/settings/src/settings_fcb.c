@@ -8,6 +8,7 @@
 #include <errno.h>
 #include <stdbool.h>
 #include <zephyr/fs/fcb.h>
+#include <zephyr/sys/hash_function.h>
 #include <string.h>
 
 #include <zephyr/settings/settings.h>
@@ -86,6 +87,11 @@ int settings_fcb_src(struct settings_fcb *cf)
 		}
 	}
 
+#ifdef CONFIG_SETTINGS_FCB_INDEX
+	/* Built the first time it is needed, once the line I/O is set up */
+	cf->cf_index_built = false;
+#endif
+
 	cf->cf_store.cs_itf = &settings_fcb_itf;
 	settings_src_register(&cf->cf_store);
 
@@ -100,6 +106,161 @@ int settings_fcb_dst(struct settings_fcb *cf)
 	return 0;
 }
 
+#ifdef CONFIG_SETTINGS_FCB_INDEX
+static struct fcb_entry *settings_fcb_index_slot(struct settings_fcb *cf,
+						 const char *name, size_t name_len)
+{
+	return &cf->cf_index[sys_hash32_djb2(name, name_len) % CONFIG_SETTINGS_FCB_INDEX_SIZE];
+}
+
+/**
+ * @brief Build the index if it has not been built yet
+ *
+ * @param cf FCB handler
+ */
+static void settings_fcb_index_build(struct settings_fcb *cf)
+{
+	struct fcb_entry_ctx entry_ctx = {
+		{.fe_sector = NULL, .fe_elem_off = 0},
+		.fap = cf->cf_fcb.fap
+	};
+	char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	size_t name_len;
+
+	if (cf->cf_index_built) {
+		return;
+	}
+
+	(void)memset(cf->cf_index, 0, sizeof(cf->cf_index));
+
+	while (fcb_getnext(&cf->cf_fcb, &entry_ctx.loc) == 0) {
+		if (settings_line_name_read(name, sizeof(name), &name_len,
+					    &entry_ctx)) {
+			continue;
+		}
+
+		*settings_fcb_index_slot(cf, name, name_len) = entry_ctx.loc;
+	}
+
+	cf->cf_index_built = true;
+}
+
+/**
+ * @brief Record a new entry as the most recent one of its setting
+ *
+ * @param cf       FCB handler
+ * @param loc      New entry
+ * @param name     Name of the setting
+ * @param name_len Length of the name
+ */
+static void settings_fcb_index_update(struct settings_fcb *cf,
+				      const struct fcb_entry *loc,
+				      const char *name, size_t name_len)
+{
+	if (cf->cf_index_built) {
+		*settings_fcb_index_slot(cf, name, name_len) = *loc;
+	}
+}
+
+/**
+ * @brief Remove the entries of a sector that is going to be erased
+ *
+ * The most recent entries of a sector are only left when it gets erased if
+ * they are deletion records, so there is no entry anymore for their hash.
+ *
+ * @param cf     FCB handler
+ * @param sector Sector to be erased
+ */
+static void settings_fcb_index_invalidate(struct settings_fcb *cf,
+					  const struct flash_sector *sector)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(cf->cf_index); i++) {
+		if (cf->cf_index[i].fe_sector == sector) {
+			cf->cf_index[i].fe_sector = NULL;
+		}
+	}
+}
+
+/**
+ * @brief Find the most recent entry of a setting in the index
+ *
+ * @param cf       FCB handler
+ * @param name     Name of the setting
+ * @param name_len Length of the name
+ * @param loc      Filled with the most recent entry of the setting
+ *
+ * @retval 0       The most recent entry was found
+ * @retval -ENOENT There is no entry for the setting
+ * @retval -EAGAIN The index can't tell, the entries have to be searched
+ */
+static int settings_fcb_index_find(struct settings_fcb *cf, const char *name,
+				   size_t name_len, struct fcb_entry *loc)
+{
+	struct fcb_entry_ctx last_ctx = {
+		.loc = *settings_fcb_index_slot(cf, name, name_len),
+		.fap = cf->cf_fcb.fap
+	};
+	char last_name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	size_t last_name_len;
+
+	if (!cf->cf_index_built) {
+		return -EAGAIN;
+	}
+
+	if (last_ctx.loc.fe_sector == NULL) {
+		return -ENOENT;
+	}
+
+	/* The most recent entry with the same hash can be another setting */
+	if (settings_line_name_read(last_name, sizeof(last_name), &last_name_len,
+				    &last_ctx) ||
+	    (last_name_len != name_len) || memcmp(last_name, name, name_len)) {
+		return -EAGAIN;
+	}
+
+	*loc = last_ctx.loc;
+
+	return 0;
+}
+
+/**
+ * @brief Check in the index if an entry is the most recent one of its setting
+ *
+ * @param cf       FCB handler
+ * @param loc      Entry to check
+ * @param name     Name of the setting
+ * @param name_len Length of the name
+ *
+ * @retval 1       The entry is the most recent one
+ * @retval 0       There is a more recent entry
+ * @retval -EAGAIN The index can't tell, the entries have to be searched
+ */
+static int settings_fcb_index_is_last(struct settings_fcb *cf,
+				      const struct fcb_entry *loc,
+				      const char *name, size_t name_len)
+{
+	const struct fcb_entry *last = settings_fcb_index_slot(cf, name, name_len);
+	struct fcb_entry found;
+	int rc;
+
+	if (!cf->cf_index_built) {
+		return -EAGAIN;
+	}
+
+	if ((last->fe_sector == loc->fe_sector) &&
+	    (last->fe_elem_off == loc->fe_elem_off)) {
+		return 1;
+	}
+
+	rc = settings_fcb_index_find(cf, name, name_len, &found);
+	if (rc) {
+		return -EAGAIN;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_SETTINGS_FCB_INDEX */
+
 /**
  * @brief Check if there is any duplicate of the current setting
  *
@@ -118,6 +279,14 @@ static bool settings_fcb_check_duplicate(struct settings_fcb *cf,
 {
 	struct fcb_entry_ctx entry2_ctx = *entry_ctx;
 
+#ifdef CONFIG_SETTINGS_FCB_INDEX
+	int rc = settings_fcb_index_is_last(cf, &entry_ctx->loc, name, strlen(name));
+
+	if (rc >= 0) {
+		return !rc;
+	}
+#endif
+
 	while (fcb_getnext(&cf->cf_fcb, &entry2_ctx.loc) == 0) {
 		char name2[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
 		size_t name2_len;
@@ -155,6 +324,10 @@ static int settings_fcb_load_priv(struct settings_store *cs,
 	};
 	int rc;
 
+#ifdef CONFIG_SETTINGS_FCB_INDEX
+	settings_fcb_index_build(cf);
+#endif
+
 	while ((rc = fcb_getnext(&cf->cf_fcb, &entry_ctx.loc)) == 0) {
 		char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
 		size_t name_len;
@@ -224,6 +397,10 @@ static void settings_fcb_compress(struct settings_fcb *cf)
 	int copy;
 	uint8_t rbs;
 
+#ifdef CONFIG_SETTINGS_FCB_INDEX
+	settings_fcb_index_build(cf);
+#endif
+
 	rc = fcb_append_to_scratch(&cf->cf_fcb);
 	if (rc) {
 		return; /* XXX */
@@ -259,7 +436,14 @@ static void settings_fcb_compress(struct settings_fcb *cf)
 		loc2 = loc1;
 		copy = 1;
 
-		while (fcb_getnext(&cf->cf_fcb, &loc2.loc) == 0) {
+#ifdef CONFIG_SETTINGS_FCB_INDEX
+		rc = settings_fcb_index_is_last(cf, &loc1.loc, name1, val1_off);
+		if (rc == 0) {
+			continue;
+		}
+#endif
+
+		while ((rc != 1) && (fcb_getnext(&cf->cf_fcb, &loc2.loc) == 0)) {
 			size_t val2_off;
 
 			rc = settings_line_name_read(name2, sizeof(name2),
@@ -296,7 +480,15 @@ static void settings_fcb_compress(struct settings_fcb *cf)
 		if (rc != 0) {
 			LOG_ERR("Failed to finish fcb_append (%d)", rc);
 		}
+#ifdef CONFIG_SETTINGS_FCB_INDEX
+		else {
+			settings_fcb_index_update(cf, &loc2.loc, name1, val1_off);
+		}
+#endif
 	}
+#ifdef CONFIG_SETTINGS_FCB_INDEX
+	settings_fcb_index_invalidate(cf, cf->cf_fcb.f_oldest);
+#endif
 	rc = fcb_rotate(&cf->cf_fcb);
 
 	if (rc != 0) {
@@ -361,6 +553,12 @@ static int settings_fcb_save_priv(struct settings_store *cs, const char *name,
 			rc = i;
 		}
 	}
+
+#ifdef CONFIG_SETTINGS_FCB_INDEX
+	if (!rc) {
+		settings_fcb_index_update(cf, &loc.loc, name, strlen(name));
+	}
+#endif
 	return rc;
 }
 
@@ -380,7 +578,27 @@ static int settings_fcb_save(struct settings_store *cs, const char *name,
 	cdca.val = (char *)value;
 	cdca.is_dup = 0;
 	cdca.val_len = val_len;
+
+#ifdef CONFIG_SETTINGS_FCB_INDEX
+	struct settings_fcb *cf = CONTAINER_OF(cs, struct settings_fcb, cf_store);
+	struct fcb_entry_ctx last_ctx = {
+		.fap = cf->cf_fcb.fap
+	};
+	size_t name_len = strlen(name);
+	int rc;
+
+	settings_fcb_index_build(cf);
+
+	rc = settings_fcb_index_find(cf, name, name_len, &last_ctx.loc);
+	if (rc == 0) {
+		/* take into account '=' separator after the name */
+		settings_line_dup_check_cb(name, &last_ctx, name_len + 1, &cdca);
+	} else if (rc == -EAGAIN) {
+		settings_fcb_load_priv(cs, settings_line_dup_check_cb, &cdca, false);
+	}
+#else
 	settings_fcb_load_priv(cs, settings_line_dup_check_cb, &cdca, false);
+#endif
 	if (cdca.is_dup == 1) {
 		return 0;
 	}
@@ -16,9 +16,102 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME, CONFIG_STREAM_FLASH_LOG_LEVEL);
 
 #include <zephyr/storage/stream_flash.h>
 
+/* Protects the write progress of the contexts, which the work queue of
+ * asynchronous streams updates while it may be read by the writer.
+ */
+static struct k_spinlock lock;
+
+#ifdef CONFIG_STREAM_FLASH_HASH
+
+#if defined(CONFIG_STREAM_FLASH_HASH_PSA)
+#define HASH_SUCCESS PSA_SUCCESS
+#else
+#define HASH_SUCCESS 0
+#endif
+
+static int hash_start(struct stream_flash_ctx *ctx)
+{
+	int rc;
+
+#if defined(CONFIG_STREAM_FLASH_HASH_PSA)
+	ctx->hash = psa_hash_operation_init();
+	rc = psa_hash_setup(&ctx->hash, PSA_ALG_SHA_256);
+#else /* CONFIG_STREAM_FLASH_HASH_MBEDTLS */
+	mbedtls_sha256_init(&ctx->hash);
+	rc = mbedtls_sha256_starts(&ctx->hash, false);
+#endif
+
+	return rc == HASH_SUCCESS ? 0 : -ESRCH;
+}
+
+static int hash_update(struct stream_flash_ctx *ctx, const uint8_t *data, size_t len)
+{
+	int rc;
+
+#if defined(CONFIG_STREAM_FLASH_HASH_PSA)
+	rc = psa_hash_update(&ctx->hash, data, len);
+#else /* CONFIG_STREAM_FLASH_HASH_MBEDTLS */
+	rc = mbedtls_sha256_update(&ctx->hash, data, len);
+#endif
+	if (rc != HASH_SUCCESS) {
+		LOG_ERR("hash update failed: %d", rc);
+		return -ESRCH;
+	}
+
+	return 0;
+}
+
+static void hash_free(struct stream_flash_ctx *ctx)
+{
+#if defined(CONFIG_STREAM_FLASH_HASH_PSA)
+	(void)psa_hash_abort(&ctx->hash);
+#else /* CONFIG_STREAM_FLASH_HASH_MBEDTLS */
+	mbedtls_sha256_free(&ctx->hash);
+#endif
+}
+
+#endif /* CONFIG_STREAM_FLASH_HASH */
+
 #ifdef CONFIG_STREAM_FLASH_PROGRESS
 #include <zephyr/settings/settings.h>
 
+#ifdef CONFIG_STREAM_FLASH_HASH
+/* Hash the first len bytes of the write area again, read back into the
+ * free part of the write buffer, as the hash state is not saved with the
+ * progress.
+ */
+static int hash_written(struct stream_flash_ctx *ctx, size_t len)
+{
+	uint8_t *buf = ctx->buf + ctx->buf_bytes;
+	size_t buf_len = ctx->buf_len - ctx->buf_bytes;
+	size_t n;
+	int rc;
+
+	hash_free(ctx);
+	rc = hash_start(ctx);
+
+	for (size_t off = 0; off < len && rc == 0; off += n) {
+		n = MIN(buf_len, len - off);
+
+		rc = flash_read(ctx->fdev, ctx->offset + off, buf, n);
+		if (rc != 0) {
+			LOG_ERR("flash read failed: %d", rc);
+			break;
+		}
+
+		rc = hash_update(ctx, buf, n);
+	}
+
+	if (rc != 0) {
+		/* Progress is not loaded, and the stream starts over */
+		hash_free(ctx);
+		(void)hash_start(ctx);
+	}
+
+	return rc;
+}
+#endif
+
 static int settings_direct_loader(const char *key, size_t len,
 				  settings_read_cb read_cb, void *cb_arg,
 				  void *param)
@@ -38,6 +131,13 @@ static int settings_direct_loader(const char *key, size_t len,
 
 		/* Check that loaded progress is not outdated. */
 		if (bytes_written >= ctx->bytes_written) {
+#ifdef CONFIG_STREAM_FLASH_HASH
+			int rc = hash_written(ctx, bytes_written);
+
+			if (rc != 0) {
+				return rc;
+			}
+#endif
 			ctx->bytes_written = bytes_written;
 		} else {
 			LOG_WRN("Loaded outdated bytes_written %zu < %zu",
@@ -65,6 +165,9 @@ static int settings_direct_loader(const char *key, size_t len,
 			ctx->last_erased_page_start_offset = -1;
 		}
 #endif /* CONFIG_STREAM_FLASH_ERASE */
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+		ctx->async.bytes_queued = ctx->bytes_written;
+#endif
 	}
 
 	return 0;
@@ -74,6 +177,17 @@ static int settings_direct_loader(const char *key, size_t len,
 
 #ifdef CONFIG_STREAM_FLASH_ERASE
 
+static off_t stream_flash_last_erased(struct stream_flash_ctx *ctx)
+{
+	off_t off = -1;
+
+	K_SPINLOCK(&lock) {
+		off = ctx->last_erased_page_start_offset;
+	}
+
+	return off;
+}
+
 int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 {
 #if IS_ENABLED(CONFIG_FLASH_HAS_EXPLICIT_ERASE)
@@ -94,7 +208,7 @@ int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 		return rc;
 	}
 
-	if (ctx->last_erased_page_start_offset == page.start_offset) {
+	if (stream_flash_last_erased(ctx) == page.start_offset) {
 		return 0;
 	}
 
@@ -105,7 +219,9 @@ int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 	if (rc != 0) {
 		LOG_ERR("Error %d while erasing page", rc);
 	} else {
-		ctx->last_erased_page_start_offset = page.start_offset;
+		K_SPINLOCK(&lock) {
+			ctx->last_erased_page_start_offset = page.start_offset;
+		}
 	}
 
 	return rc;
@@ -114,9 +230,31 @@ int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 #endif
 }
 
+/* Erase the page to which a given offset belongs unless it, or a page
+ * following it, has already been erased.
+ */
+static int stream_flash_erase_until(struct stream_flash_ctx *ctx, off_t off)
+{
+	int rc;
+	struct flash_pages_info page;
+
+	rc = flash_get_page_info_by_offs(ctx->fdev, off, &page);
+	if (rc != 0) {
+		LOG_ERR("Error %d while getting page info", rc);
+		return rc;
+	}
+
+	if (stream_flash_last_erased(ctx) >= page.start_offset) {
+		return 0;
+	}
+
+	return stream_flash_erase_page(ctx, off);
+}
+
 #endif /* CONFIG_STREAM_FLASH_ERASE */
 
-static int flash_sync(struct stream_flash_ctx *ctx)
+static int flash_sync_buf(struct stream_flash_ctx *ctx, uint8_t *buf,
+			  size_t buf_bytes)
 {
 	int rc = 0;
 	size_t write_addr = ctx->offset + ctx->bytes_written;
@@ -125,33 +263,31 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 	uint8_t filler;
 
 
-	if (ctx->buf_bytes == 0) {
+	if (buf_bytes == 0) {
 		return 0;
 	}
 
-	if (IS_ENABLED(CONFIG_STREAM_FLASH_ERASE)) {
-
-		rc = stream_flash_erase_page(ctx,
-					     write_addr + ctx->buf_bytes - 1);
-		if (rc < 0) {
-			LOG_ERR("stream_flash_erase_page err %d offset=0x%08zx",
-				rc, write_addr);
-			return rc;
-		}
+#ifdef CONFIG_STREAM_FLASH_ERASE
+	rc = stream_flash_erase_until(ctx, write_addr + buf_bytes - 1);
+	if (rc < 0) {
+		LOG_ERR("stream_flash_erase_page err %d offset=0x%08zx",
+			rc, write_addr);
+		return rc;
 	}
+#endif
 
 	fill_length = ctx->write_block_size;
-	if (ctx->buf_bytes % fill_length) {
-		fill_length -= ctx->buf_bytes % fill_length;
+	if (buf_bytes % fill_length) {
+		fill_length -= buf_bytes % fill_length;
 		filler = ctx->erase_value;
 
-		memset(ctx->buf + ctx->buf_bytes, filler, fill_length);
+		memset(buf + buf_bytes, filler, fill_length);
 	} else {
 		fill_length = 0;
 	}
 
-	buf_bytes_aligned = ctx->buf_bytes + fill_length;
-	rc = flash_write(ctx->fdev, write_addr, ctx->buf, buf_bytes_aligned);
+	buf_bytes_aligned = buf_bytes + fill_length;
+	rc = flash_write(ctx->fdev, write_addr, buf, buf_bytes_aligned);
 
 	if (rc != 0) {
 		LOG_ERR("flash_write error %d offset=0x%08zx", rc,
@@ -159,34 +295,172 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 		return rc;
 	}
 
+#ifdef CONFIG_STREAM_FLASH_HASH
+	/* Hash the data before the buffer is reused to read it back */
+	rc = hash_update(ctx, buf, buf_bytes);
+	if (rc != 0) {
+		return rc;
+	}
+#endif
+
 	if (ctx->callback) {
 		/* Invert to ensure that caller is able to discover a faulty
 		 * flash_read() even if no error code is returned.
 		 */
-		for (int i = 0; i < ctx->buf_bytes; i++) {
-			ctx->buf[i] = ~ctx->buf[i];
+		for (int i = 0; i < buf_bytes; i++) {
+			buf[i] = ~buf[i];
 		}
 
-		rc = flash_read(ctx->fdev, write_addr, ctx->buf,
-				ctx->buf_bytes);
+		rc = flash_read(ctx->fdev, write_addr, buf, buf_bytes);
 		if (rc != 0) {
 			LOG_ERR("flash read failed: %d", rc);
 			return rc;
 		}
 
-		rc = ctx->callback(ctx->buf, ctx->buf_bytes, write_addr);
+		rc = ctx->callback(buf, buf_bytes, write_addr);
 		if (rc != 0) {
 			LOG_ERR("callback failed: %d", rc);
 			return rc;
 		}
 	}
 
-	ctx->bytes_written += ctx->buf_bytes;
+	K_SPINLOCK(&lock) {
+		ctx->bytes_written += buf_bytes;
+	}
+
+	return rc;
+}
+
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+
+K_THREAD_STACK_DEFINE(stream_flash_work_queue_stack,
+		      CONFIG_STREAM_FLASH_ASYNC_WORKQUEUE_STACK_SIZE);
+
+static struct k_work_q stream_flash_work_queue;
+
+static const struct k_work_queue_config stream_flash_work_queue_config = {
+	.name = "stream_flash"
+};
+
+static void stream_flash_async_handler(struct k_work *work)
+{
+	struct stream_flash_ctx *ctx =
+		CONTAINER_OF(work, struct stream_flash_ctx, async.work);
+	int rc;
+
+	while (atomic_get(&ctx->async.pending) > 0) {
+		uint8_t *buf = ctx->async.bufs + ctx->async.next * ctx->buf_len;
+
+		/* Buffers queued after a failed write are dropped */
+		if (ctx->async.rc == 0) {
+			rc = flash_sync_buf(ctx, buf, ctx->async.lens[ctx->async.next]);
+			if (rc != 0) {
+				ctx->async.rc = rc;
+			}
+
+			if (ctx->async.progress) {
+				ctx->async.progress(ctx, ctx->bytes_written, rc);
+			}
+
+#ifdef CONFIG_STREAM_FLASH_ASYNC_ERASE_AHEAD
+			if (rc == 0 && ctx->bytes_written < ctx->available) {
+				rc = stream_flash_erase_until(ctx, ctx->offset +
+					MIN(ctx->bytes_written + ctx->buf_len,
+					    ctx->available) - 1);
+				if (rc != 0) {
+					ctx->async.rc = rc;
+				}
+			}
+#endif
+		}
+
+		ctx->async.next = (ctx->async.next + 1) % ctx->async.buf_cnt;
+		atomic_dec(&ctx->async.pending);
+		k_sem_give(&ctx->async.free);
+	}
+}
+
+/* Wait for all the queued buffers to be written. */
+static int stream_flash_async_wait(struct stream_flash_ctx *ctx)
+{
+	struct k_work_sync sync;
+
+	(void)k_work_flush(&ctx->async.work, &sync);
+
+	return ctx->async.rc;
+}
+
+/* Queue the buffer being filled for write and switch to the next one,
+ * waiting for it to be written if needed.
+ */
+static int stream_flash_async_submit(struct stream_flash_ctx *ctx)
+{
+	ctx->async.lens[ctx->async.fill] = ctx->buf_bytes;
+	ctx->async.bytes_queued += ctx->buf_bytes;
+	atomic_inc(&ctx->async.pending);
+	k_work_submit_to_queue(&stream_flash_work_queue, &ctx->async.work);
+
+	ctx->async.fill = (ctx->async.fill + 1) % ctx->async.buf_cnt;
+	ctx->buf = ctx->async.bufs + ctx->async.fill * ctx->buf_len;
 	ctx->buf_bytes = 0U;
 
+	k_sem_take(&ctx->async.free, K_FOREVER);
+
+	/* Let the work queue be done with the stream before reporting the
+	 * error, so that the caller may reuse it at once.
+	 */
+	if (ctx->async.rc != 0) {
+		return stream_flash_async_wait(ctx);
+	}
+
+	return 0;
+}
+
+static int stream_flash_async_init_queue(void)
+{
+	k_work_queue_init(&stream_flash_work_queue);
+
+	k_work_queue_start(&stream_flash_work_queue, stream_flash_work_queue_stack,
+			   K_THREAD_STACK_SIZEOF(stream_flash_work_queue_stack),
+			   CONFIG_STREAM_FLASH_ASYNC_WORKQUEUE_THREAD_PRIO,
+			   &stream_flash_work_queue_config);
+
+	return 0;
+}
+
+SYS_INIT(stream_flash_async_init_queue, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#endif /* CONFIG_STREAM_FLASH_ASYNC */
+
+static int flash_sync(struct stream_flash_ctx *ctx)
+{
+	int rc;
+
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	if (ctx->async.buf_cnt > 0) {
+		return stream_flash_async_submit(ctx);
+	}
+#endif
+
+	rc = flash_sync_buf(ctx, ctx->buf, ctx->buf_bytes);
+	if (rc == 0) {
+		ctx->buf_bytes = 0U;
+	}
+
 	return rc;
 }
 
+static size_t stream_flash_bytes_queued(struct stream_flash_ctx *ctx)
+{
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	if (ctx->async.buf_cnt > 0) {
+		return ctx->async.bytes_queued;
+	}
+#endif
+
+	return ctx->bytes_written;
+}
+
 int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *data,
 				size_t len, bool flush)
 {
@@ -198,10 +472,16 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		return -EFAULT;
 	}
 
-	if (ctx->bytes_written + ctx->buf_bytes + len > ctx->available) {
+	if (stream_flash_bytes_queued(ctx) + ctx->buf_bytes + len > ctx->available) {
 		return -ENOMEM;
 	}
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	if (ctx->async.buf_cnt > 0 && ctx->async.rc != 0) {
+		return stream_flash_async_wait(ctx);
+	}
+#endif
+
 	while ((len - processed) >=
 	       (buf_empty_bytes = ctx->buf_len - ctx->buf_bytes)) {
 		memcpy(ctx->buf + ctx->buf_bytes, data + processed,
@@ -228,13 +508,58 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		rc = flash_sync(ctx);
 	}
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	if (flush && rc == 0 && ctx->async.buf_cnt > 0) {
+		rc = stream_flash_async_wait(ctx);
+	}
+#endif
+
 	return rc;
 }
 
 size_t stream_flash_bytes_written(struct stream_flash_ctx *ctx)
 {
-	return ctx->bytes_written;
+	size_t bytes_written = 0;
+
+	K_SPINLOCK(&lock) {
+		bytes_written = ctx->bytes_written;
+	}
+
+	return bytes_written;
+}
+
+#ifdef CONFIG_STREAM_FLASH_HASH
+int stream_flash_hash_get(struct stream_flash_ctx *ctx, uint8_t *hash)
+{
+#if defined(CONFIG_STREAM_FLASH_HASH_PSA)
+	psa_hash_operation_t hash_ctx = psa_hash_operation_init();
+	size_t hash_len;
+#else /* CONFIG_STREAM_FLASH_HASH_MBEDTLS */
+	mbedtls_sha256_context hash_ctx;
+#endif
+	int rc;
+
+	if (!ctx || !hash) {
+		return -EFAULT;
+	}
+
+	/* Finish a copy, so that the stream can be written further */
+#if defined(CONFIG_STREAM_FLASH_HASH_PSA)
+	rc = psa_hash_clone(&ctx->hash, &hash_ctx);
+	if (rc == PSA_SUCCESS) {
+		rc = psa_hash_finish(&hash_ctx, hash, STREAM_FLASH_HASH_LEN, &hash_len);
+	}
+	(void)psa_hash_abort(&hash_ctx);
+#else /* CONFIG_STREAM_FLASH_HASH_MBEDTLS */
+	mbedtls_sha256_init(&hash_ctx);
+	mbedtls_sha256_clone(&hash_ctx, &ctx->hash);
+	rc = mbedtls_sha256_finish(&hash_ctx, hash);
+	mbedtls_sha256_free(&hash_ctx);
+#endif
+
+	return rc == HASH_SUCCESS ? 0 : -ESRCH;
 }
+#endif
 
 struct _inspect_flash {
 	size_t buf_len;
@@ -266,6 +591,17 @@ int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 		return -EFAULT;
 	}
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	/* The work queue may still be writing a previous asynchronous stream */
+	if (ctx->async.buf_cnt > 0 && ctx->async.work.handler == stream_flash_async_handler) {
+		struct k_work_sync sync;
+
+		/* Drop the buffers queued, only the one being written is waited for */
+		ctx->async.rc = -ECANCELED;
+		(void)k_work_cancel_sync(&ctx->async.work, &sync);
+	}
+#endif
+
 #ifdef CONFIG_STREAM_FLASH_PROGRESS
 	int rc = settings_subsys_init();
 
@@ -318,9 +654,62 @@ int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 #endif
 	ctx->erase_value = params->erase_value;
 
+#ifdef CONFIG_STREAM_FLASH_HASH
+	/* The context may be reused, with the hash of a previous stream started */
+	if (ctx->hash_owner == ctx) {
+		hash_free(ctx);
+		ctx->hash_owner = NULL;
+	}
+
+	if (hash_start(ctx) != 0) {
+		return -ESRCH;
+	}
+
+	ctx->hash_owner = ctx;
+#endif
+
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	ctx->async.buf_cnt = 0;
+#endif
+
+	return 0;
+}
+
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+
+int stream_flash_init_async(struct stream_flash_ctx *ctx, const struct device *fdev,
+			    uint8_t *buf, size_t buf_len, size_t buf_cnt, size_t offset,
+			    size_t size, stream_flash_callback_t cb,
+			    stream_flash_progress_callback_t progress_cb)
+{
+	int rc;
+
+	if (buf_cnt < 2 || buf_cnt > CONFIG_STREAM_FLASH_ASYNC_BUF_COUNT) {
+		LOG_ERR("Incorrect number of buffers");
+		return -EINVAL;
+	}
+
+	rc = stream_flash_init(ctx, fdev, buf, buf_len, offset, size, cb);
+	if (rc != 0) {
+		return rc;
+	}
+
+	ctx->async.bufs = buf;
+	ctx->async.buf_cnt = buf_cnt;
+	ctx->async.fill = 0;
+	ctx->async.next = 0;
+	ctx->async.bytes_queued = 0;
+	atomic_set(&ctx->async.pending, 0);
+	k_sem_init(&ctx->async.free, buf_cnt - 1, buf_cnt - 1);
+	k_work_init(&ctx->async.work, stream_flash_async_handler);
+	ctx->async.progress = progress_cb;
+	ctx->async.rc = 0;
+
 	return 0;
 }
 
+#endif /* CONFIG_STREAM_FLASH_ASYNC */
+
 #ifdef CONFIG_STREAM_FLASH_PROGRESS
 
 int stream_flash_progress_load(struct stream_flash_ctx *ctx,
@@ -330,6 +719,13 @@ int stream_flash_progress_load(struct stream_flash_ctx *ctx,
 		return -EFAULT;
 	}
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	/* The progress is only changed once the work queue is done */
+	if (ctx->async.buf_cnt > 0) {
+		(void)stream_flash_async_wait(ctx);
+	}
+#endif
+
 	int rc = settings_load_subtree_direct(settings_key,
 					      settings_direct_loader,
 					      (void *) ctx);
@@ -349,6 +745,17 @@ int stream_flash_progress_save(struct stream_flash_ctx *ctx,
 		return -EFAULT;
 	}
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+	/* Save the progress of the buffers queued, once they are written */
+	if (ctx->async.buf_cnt > 0) {
+		int err = stream_flash_async_wait(ctx);
+
+		if (err != 0) {
+			return err;
+		}
+	}
+#endif
+
 	int rc = settings_save_one(settings_key,
 				   &ctx->bytes_written,
 				   sizeof(ctx->bytes_written));
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/fs/fcb.h>
+
+#include "storage_perf.h"
+
+#define FCB_LEN     32
+#define FCB_APPENDS 4000
+
+static struct fcb fcb;
+static struct flash_sector fcb_sectors[STORAGE_PERF_MAX_PAGES];
+
+static int fcb_perf_walk_cb(struct fcb_entry_ctx *entry_ctx, void *arg)
+{
+	uint8_t data[FCB_LEN];
+	uint32_t *entries = arg;
+	int rc;
+
+	rc = flash_area_read(entry_ctx->fap, FCB_ENTRY_FA_DATA_OFF(entry_ctx->loc), data,
+			     sizeof(data));
+	zassert_equal(rc, 0, "can't read entry");
+
+	(*entries)++;
+
+	return 0;
+}
+
+ZTEST(storage_perf, test_fcb)
+{
+	uint32_t sector_cnt = ARRAY_SIZE(fcb_sectors);
+	const struct flash_area *fa;
+	struct storage_perf perf;
+	struct fcb_entry loc;
+	uint8_t data[FCB_LEN];
+	uint32_t entries = 0;
+	int rc;
+
+	rc = flash_area_get_sectors(FIXED_PARTITION_ID(fcb_partition), &sector_cnt, fcb_sectors);
+	zassert_equal(rc, 0, "can't get sectors");
+
+	memset(&fcb, 0, sizeof(fcb));
+	fcb.f_magic = 0x12345678;
+	fcb.f_sectors = fcb_sectors;
+	fcb.f_sector_cnt = sector_cnt;
+	fcb.f_scratch_cnt = 1;
+
+	rc = flash_area_open(FIXED_PARTITION_ID(fcb_partition), &fa);
+	zassert_equal(rc, 0, "can't open partition");
+	storage_perf_wipe(fa);
+	flash_area_close(fa);
+
+	rc = fcb_init(FIXED_PARTITION_ID(fcb_partition), &fcb);
+	zassert_equal(rc, 0, "can't init FCB");
+
+	storage_perf_start(&perf, fcb.fap);
+
+	/* Log the entries, dropping the oldest ones once full */
+	for (uint32_t i = 0; i < FCB_APPENDS; i++) {
+		memset(data, i, sizeof(data));
+
+		rc = fcb_append(&fcb, sizeof(data), &loc);
+		if (rc == -ENOSPC) {
+			rc = fcb_rotate(&fcb);
+			zassert_equal(rc, 0, "can't rotate");
+			rc = fcb_append(&fcb, sizeof(data), &loc);
+		}
+		zassert_equal(rc, 0, "can't append");
+
+		rc = flash_area_write(fcb.fap, FCB_ENTRY_FA_DATA_OFF(loc), data, sizeof(data));
+		zassert_equal(rc, 0, "can't write entry");
+
+		rc = fcb_append_finish(&fcb, &loc);
+		zassert_equal(rc, 0, "can't finish append");
+	}
+
+	storage_perf_report(&perf, "FCB append", FCB_APPENDS, FCB_APPENDS * FCB_LEN);
+
+	storage_perf_start(&perf, fcb.fap);
+
+	rc = fcb_walk(&fcb, NULL, fcb_perf_walk_cb, &entries);
+	zassert_equal(rc, 0, "can't walk");
+
+	storage_perf_report(&perf, "FCB walk", entries, 0);
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/fs/littlefs.h>
+
+#include "storage_perf.h"
+
+#define LFS_MNT_POINT   "/lfs"
+#define LFS_FILE        LFS_MNT_POINT "/image"
+#define LFS_CONFIG_FILE LFS_MNT_POINT "/config"
+#define LFS_CHUNK_LEN   256
+#define LFS_FILE_LEN    (64 * 1024)
+#define LFS_CONFIG_LEN  32
+#define LFS_REWRITES    200
+
+FS_LITTLEFS_DECLARE_DEFAULT_CONFIG(lfs_storage);
+
+static struct fs_mount_t lfs_mnt = {
+	.type = FS_LITTLEFS,
+	.fs_data = &lfs_storage,
+	.storage_dev = (void *)FIXED_PARTITION_ID(lfs_partition),
+	.mnt_point = LFS_MNT_POINT,
+};
+
+static uint8_t chunk[LFS_CHUNK_LEN];
+
+ZTEST(storage_perf, test_littlefs)
+{
+	const struct flash_area *fa;
+	struct storage_perf perf;
+	struct fs_file_t file;
+	int rc;
+
+	rc = flash_area_open(FIXED_PARTITION_ID(lfs_partition), &fa);
+	zassert_equal(rc, 0, "can't open partition");
+	storage_perf_wipe(fa);
+
+	rc = fs_mount(&lfs_mnt);
+	zassert_equal(rc, 0, "can't mount littlefs");
+
+	/* Stream a large file, as a DFU or a log would */
+	storage_perf_start(&perf, fa);
+
+	fs_file_t_init(&file);
+	rc = fs_open(&file, LFS_FILE, FS_O_CREATE | FS_O_WRITE);
+	zassert_equal(rc, 0, "can't open file");
+
+	for (uint32_t off = 0; off < LFS_FILE_LEN; off += sizeof(chunk)) {
+		memset(chunk, off / sizeof(chunk), sizeof(chunk));
+
+		rc = fs_write(&file, chunk, sizeof(chunk));
+		zassert_equal(rc, sizeof(chunk), "can't write file");
+	}
+
+	rc = fs_close(&file);
+	zassert_equal(rc, 0, "can't close file");
+
+	storage_perf_report(&perf, "littlefs stream write", LFS_FILE_LEN / LFS_CHUNK_LEN,
+			    LFS_FILE_LEN);
+
+	storage_perf_start(&perf, fa);
+
+	fs_file_t_init(&file);
+	rc = fs_open(&file, LFS_FILE, FS_O_READ);
+	zassert_equal(rc, 0, "can't open file");
+
+	for (uint32_t off = 0; off < LFS_FILE_LEN; off += sizeof(chunk)) {
+		rc = fs_read(&file, chunk, sizeof(chunk));
+		zassert_equal(rc, sizeof(chunk), "can't read file");
+	}
+
+	rc = fs_close(&file);
+	zassert_equal(rc, 0, "can't close file");
+
+	storage_perf_report(&perf, "littlefs stream read", LFS_FILE_LEN / LFS_CHUNK_LEN, 0);
+
+	/* Rewrite a small file, as a configuration would */
+	storage_perf_start(&perf, fa);
+
+	for (uint32_t i = 0; i < LFS_REWRITES; i++) {
+		memset(chunk, i, LFS_CONFIG_LEN);
+
+		fs_file_t_init(&file);
+		rc = fs_open(&file, LFS_CONFIG_FILE, FS_O_CREATE | FS_O_WRITE);
+		zassert_equal(rc, 0, "can't open file");
+
+		rc = fs_write(&file, chunk, LFS_CONFIG_LEN);
+		zassert_equal(rc, LFS_CONFIG_LEN, "can't write file");
+
+		rc = fs_close(&file);
+		zassert_equal(rc, 0, "can't close file");
+	}
+
+	storage_perf_report(&perf, "littlefs small file rewrite", LFS_REWRITES,
+			    LFS_REWRITES * LFS_CONFIG_LEN);
+
+	rc = fs_unmount(&lfs_mnt);
+	zassert_equal(rc, 0, "can't unmount littlefs");
+
+	flash_area_close(fa);
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Runs typical workloads of the storage subsystems on the flash simulator,
+ * with the timings of a real flash, and reports the operations per second
+ * along with the write amplification, i.e. the number of bytes written to
+ * flash for each byte of payload, and the erases done.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/drivers/flash/flash_simulator.h>
+#include <zephyr/stats/stats.h>
+
+#include "storage_perf.h"
+
+static uint32_t seed;
+
+struct stat_find {
+	const char *name;
+	uint32_t value;
+};
+
+static int stat_find_cb(struct stats_hdr *hdr, void *arg, const char *name, uint16_t off)
+{
+	struct stat_find *find = arg;
+
+	if (!strcmp(name, find->name)) {
+		find->value = *(uint32_t *)((uint8_t *)hdr + off);
+	}
+
+	return 0;
+}
+
+static uint32_t stat_get(const char *name)
+{
+	struct stats_hdr *hdr = stats_group_find("flash_sim_stats");
+	struct stat_find find = {
+		.name = name,
+	};
+
+	zassert_not_null(hdr, "flash simulator statistics not found");
+	stats_walk(hdr, stat_find_cb, &find);
+
+	return find.value;
+}
+
+static uint32_t erase_cycles_get(const struct flash_area *fa, uint32_t page)
+{
+	uint32_t cycles;
+	int rc;
+
+	rc = flash_simulator_get_erase_cycles(fa->fa_dev,
+					      fa->fa_off + (page * STORAGE_PERF_PAGE_SIZE),
+					      &cycles);
+	zassert_equal(rc, 0, "can't get erase cycles");
+
+	return cycles;
+}
+
+static uint32_t page_count(const struct flash_area *fa)
+{
+	uint32_t count = fa->fa_size / STORAGE_PERF_PAGE_SIZE;
+
+	zassert_true(count <= STORAGE_PERF_MAX_PAGES, "partition too large");
+
+	return count;
+}
+
+void storage_perf_wipe(const struct flash_area *fa)
+{
+	int rc;
+
+	rc = flash_area_flatten(fa, 0, fa->fa_size);
+	zassert_equal(rc, 0, "can't wipe partition");
+}
+
+void storage_perf_start(struct storage_perf *perf, const struct flash_area *fa)
+{
+	perf->fa = fa;
+
+	for (uint32_t i = 0; i < page_count(fa); i++) {
+		perf->erase_cycles[i] = erase_cycles_get(fa, i);
+	}
+
+	perf->bytes_written = stat_get("bytes_written");
+	perf->bytes_read = stat_get("bytes_read");
+	perf->start = k_uptime_ticks();
+}
+
+void storage_perf_report(struct storage_perf *perf, const char *name, uint32_t ops,
+			 size_t payload_bytes)
+{
+	uint32_t elapsed_us = (uint32_t)k_ticks_to_us_floor64(k_uptime_ticks() - perf->start);
+	uint32_t written = stat_get("bytes_written") - perf->bytes_written;
+	uint32_t read = stat_get("bytes_read") - perf->bytes_read;
+	uint32_t erases = 0;
+	uint32_t max_erases = 0;
+	uint32_t amplification;
+
+	for (uint32_t i = 0; i < page_count(perf->fa); i++) {
+		uint32_t page_erases = erase_cycles_get(perf->fa, i) - perf->erase_cycles[i];
+
+		erases += page_erases;
+		max_erases = MAX(max_erases, page_erases);
+	}
+
+	amplification = payload_bytes ? (uint32_t)((written * 100ULL) / payload_bytes) : 0;
+
+	TC_PRINT("%s: %u ops in %u us, %u ops/s\n", name, ops, elapsed_us,
+		 elapsed_us ? (uint32_t)((ops * 1000000ULL) / elapsed_us) : 0);
+	TC_PRINT("  %zu payload bytes, %u bytes written (x%u.%02u), %u bytes read\n",
+		 payload_bytes, written, amplification / 100, amplification % 100, read);
+	TC_PRINT("  %u pages erased, at most %u times\n", erases, max_erases);
+}
+
+uint32_t storage_perf_rand(void)
+{
+	seed = (seed * 1103515245U) + 12345U;
+
+	return seed >> 8;
+}
+
+static void storage_perf_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	seed = 1U;
+}
+
+ZTEST_SUITE(storage_perf, NULL, NULL, storage_perf_before, NULL, NULL);
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/fs/nvs.h>
+
+#include "storage_perf.h"
+
+#define NVS_IDS    64
+#define NVS_LEN    32
+#define NVS_WRITES 2000
+
+static struct nvs_fs fs;
+
+ZTEST(storage_perf, test_nvs)
+{
+	const struct flash_area *fa;
+	struct storage_perf perf;
+	uint8_t data[NVS_LEN];
+	int rc;
+
+	rc = flash_area_open(FIXED_PARTITION_ID(nvs_partition), &fa);
+	zassert_equal(rc, 0, "can't open partition");
+	storage_perf_wipe(fa);
+
+	fs.flash_device = fa->fa_dev;
+	fs.offset = fa->fa_off;
+	fs.sector_size = STORAGE_PERF_PAGE_SIZE;
+	fs.sector_count = fa->fa_size / STORAGE_PERF_PAGE_SIZE;
+
+	rc = nvs_mount(&fs);
+	zassert_equal(rc, 0, "can't mount NVS");
+
+	storage_perf_start(&perf, fa);
+
+	for (uint32_t i = 0; i < NVS_WRITES; i++) {
+		memset(data, i, sizeof(data));
+
+		rc = nvs_write(&fs, storage_perf_rand() % NVS_IDS, data, sizeof(data));
+		zassert_equal(rc, sizeof(data), "can't write");
+	}
+
+	storage_perf_report(&perf, "NVS write", NVS_WRITES, NVS_WRITES * NVS_LEN);
+
+	storage_perf_start(&perf, fa);
+
+	for (uint32_t id = 0; id < NVS_IDS; id++) {
+		rc = nvs_read(&fs, id, data, sizeof(data));
+		zassert_equal(rc, sizeof(data), "can't read");
+	}
+
+	storage_perf_report(&perf, "NVS read", NVS_IDS, 0);
+
+	storage_perf_start(&perf, fa);
+
+	rc = nvs_mount(&fs);
+	zassert_equal(rc, 0, "can't mount NVS");
+
+	storage_perf_report(&perf, "NVS mount", 1, 0);
+
+	flash_area_close(fa);
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/settings/settings.h>
+
+#include "storage_perf.h"
+
+#define SETTINGS_KEYS  32
+#define SETTINGS_LEN   16
+#define SETTINGS_SAVES 1000
+
+static uint32_t loaded;
+
+static int perf_handle_set(const char *name, size_t len, settings_read_cb read_cb,
+			   void *cb_arg)
+{
+	uint8_t data[SETTINGS_LEN];
+
+	if (read_cb(cb_arg, data, sizeof(data)) == sizeof(data)) {
+		loaded++;
+	}
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(perf, "perf", NULL, perf_handle_set, NULL, NULL);
+
+ZTEST(storage_perf, test_settings)
+{
+	const struct flash_area *fa;
+	struct storage_perf perf;
+	uint8_t data[SETTINGS_LEN];
+	char name[16];
+	int rc;
+
+	rc = flash_area_open(DT_FIXED_PARTITION_ID(DT_CHOSEN(zephyr_settings_partition)), &fa);
+	zassert_equal(rc, 0, "can't open partition");
+	storage_perf_wipe(fa);
+
+	rc = settings_subsys_init();
+	zassert_equal(rc, 0, "can't initialize settings");
+
+	storage_perf_start(&perf, fa);
+
+	for (uint32_t i = 0; i < SETTINGS_SAVES; i++) {
+		snprintf(name, sizeof(name), "perf/%u", storage_perf_rand() % SETTINGS_KEYS);
+		memset(data, i, sizeof(data));
+
+		rc = settings_save_one(name, data, sizeof(data));
+		zassert_equal(rc, 0, "can't save");
+	}
+
+	storage_perf_report(&perf, "settings save", SETTINGS_SAVES,
+			    SETTINGS_SAVES * SETTINGS_LEN);
+
+	storage_perf_start(&perf, fa);
+
+	loaded = 0;
+	rc = settings_load_subtree("perf");
+	zassert_equal(rc, 0, "can't load");
+	zassert_equal(loaded, SETTINGS_KEYS, "all the keys should be loaded");
+
+	storage_perf_report(&perf, "settings load", loaded, 0);
+
+	flash_area_close(fa);
+}
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef STORAGE_PERF_H
+#define STORAGE_PERF_H
+
+#include <zephyr/kernel.h>
+#include <zephyr/storage/flash_map.h>
+
+#define STORAGE_PERF_PAGE_SIZE 4096
+#define STORAGE_PERF_MAX_PAGES 64
+
+/* Flash usage and time at the start of a workload */
+struct storage_perf {
+	const struct flash_area *fa;
+	int64_t start;
+	uint32_t bytes_written;
+	uint32_t bytes_read;
+	uint32_t erase_cycles[STORAGE_PERF_MAX_PAGES];
+};
+
+void storage_perf_wipe(const struct flash_area *fa);
+void storage_perf_start(struct storage_perf *perf, const struct flash_area *fa);
+void storage_perf_report(struct storage_perf *perf, const char *name, uint32_t ops,
+			 size_t payload_bytes);
+uint32_t storage_perf_rand(void);
+
+#endif /* STORAGE_PERF_H */
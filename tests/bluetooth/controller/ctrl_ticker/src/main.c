@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <time.h>
+
+#include <zephyr/types.h>
+#include <zephyr/ztest.h>
+
+#define DEBUG_TICKER_ISR(flag)
+#define DEBUG_TICKER_JOB(flag)
+#define DEBUG_TICKER_TASK(flag)
+
+#include "ticker/ticker.c"
+
+/*
+ * Runs the ticker on a simulated counter, with hundreds of ticker nodes
+ * started, expiring and being restarted. Expirations are checked against
+ * the period of each ticker node, and the execution time of ticker_job is
+ * reported.
+ */
+
+#define TEST_INSTANCE  0
+#define TEST_USER      0
+#define TEST_NODES     (TICKER_NULL - 1)
+#define TEST_USER_OPS  8
+#define TEST_SAMPLES   20000
+
+static struct ticker_node nodes[TEST_NODES];
+static struct ticker_user users[1];
+static struct ticker_user_op user_ops[TEST_USER_OPS];
+static struct ticker_ext ext_data[TEST_NODES];
+
+static uint32_t cntr;
+static uint32_t cmp;
+static bool worker_pending;
+static bool job_pending;
+
+static struct {
+	uint32_t ticks_periodic;
+	uint32_t ticks_at_expire;
+	uint32_t expired;
+	bool started;
+	bool check;
+} tickers[TEST_NODES];
+
+static uint32_t job_ns[TEST_SAMPLES];
+static uint32_t job_count;
+static uint32_t seed;
+
+uint32_t cntr_cnt_get(void)
+{
+	return cntr;
+}
+
+uint32_t cntr_start(void)
+{
+	return 0;
+}
+
+uint32_t cntr_stop(void)
+{
+	return 0;
+}
+
+static uint32_t test_rand(void)
+{
+	seed = (seed * 1103515245U) + 12345U;
+
+	return seed >> 8;
+}
+
+static uint32_t time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint32_t)((ts.tv_sec * 1000000000ULL) + ts.tv_nsec);
+}
+
+static uint8_t caller_id_get(uint8_t user_id)
+{
+	return TICKER_CALL_ID_PROGRAM;
+}
+
+static void sched(uint8_t caller_id, uint8_t callee_id, uint8_t chain,
+		  void *instance)
+{
+	if (callee_id == TICKER_CALL_ID_WORKER) {
+		worker_pending = true;
+	} else if (callee_id == TICKER_CALL_ID_JOB) {
+		job_pending = true;
+	}
+}
+
+static void trigger_set(uint32_t value)
+{
+	cmp = value;
+}
+
+static void ticker_check(void)
+{
+#if defined(CONFIG_BT_TICKER_SKIP_LIST)
+	struct ticker_instance *instance = &_instance[TEST_INSTANCE];
+
+	for (uint8_t level = 0U; level < TICKER_SKIP_LEVELS; level++) {
+		uint8_t lane = instance->skip_head[level];
+		uint32_t ticks_lane = instance->skip_head_ticks[level];
+		uint8_t id = instance->ticker_id_head;
+		uint32_t ticks = 0U;
+
+		/* Every node of the list linked in this lane must be the
+		 * next one in the lane, at the same distance.
+		 */
+		while (id != TICKER_NULL) {
+			ticks += nodes[id].ticks_to_expire;
+
+			if (nodes[id].skip_level > level) {
+				zassert_equal(lane, id, "Lane %u out of order", level);
+				zassert_equal(ticks_lane, ticks, "Lane %u span mismatch", level);
+
+				ticks_lane = nodes[id].skip_ticks[level];
+				lane = nodes[id].skip_next[level];
+				ticks = 0U;
+			}
+
+			id = nodes[id].next;
+		}
+
+		zassert_equal(lane, TICKER_NULL, "Lane %u longer than list", level);
+	}
+#endif /* CONFIG_BT_TICKER_SKIP_LIST */
+}
+
+static void run(void)
+{
+	while (worker_pending || job_pending) {
+		uint32_t start;
+
+		if (worker_pending) {
+			worker_pending = false;
+			ticker_worker(&_instance[TEST_INSTANCE]);
+			continue;
+		}
+
+		job_pending = false;
+
+		start = time_ns();
+		ticker_job(&_instance[TEST_INSTANCE]);
+		if (job_count < TEST_SAMPLES) {
+			job_ns[job_count++] = time_ns() - start;
+		}
+
+		ticker_check();
+	}
+}
+
+static void expire(void)
+{
+	cntr = cmp;
+	ticker_trigger(TEST_INSTANCE);
+	run();
+}
+
+static void timeout(uint32_t ticks_at_expire, uint32_t ticks_drift,
+		    uint32_t remainder, uint16_t lazy, uint8_t force,
+		    void *context)
+{
+	uint8_t id = (uint8_t)(uintptr_t)context;
+	uint32_t expected;
+
+	expected = tickers[id].ticks_at_expire +
+		   (tickers[id].ticks_periodic * (lazy + 1U));
+
+	if (tickers[id].check) {
+		zassert_equal(ticks_at_expire, expected & HAL_TICKER_CNTR_MASK,
+			      "Ticker %u expired at %u instead of %u", id,
+			      ticks_at_expire, expected & HAL_TICKER_CNTR_MASK);
+	}
+
+	tickers[id].ticks_at_expire = ticks_at_expire;
+	tickers[id].expired++;
+}
+
+static void op_done(uint32_t status, void *op_context)
+{
+	zassert_equal(status, TICKER_STATUS_SUCCESS, "Operation failed");
+}
+
+static void start(uint8_t id, uint32_t ticks_slot, uint32_t ticks_slot_window)
+{
+	uint32_t ticks_first = 1000U + (test_rand() % 32768U);
+	uint32_t ticks_periodic = 1000U + (test_rand() % 32768U);
+	uint32_t ret;
+
+	tickers[id].ticks_periodic = ticks_periodic;
+	tickers[id].ticks_at_expire = (cntr + ticks_first - ticks_periodic) &
+				      HAL_TICKER_CNTR_MASK;
+	tickers[id].check = (ticks_slot_window == 0U);
+	tickers[id].started = true;
+
+	ext_data[id].ticks_slot_window = ticks_slot_window;
+
+	ret = ticker_start_ext(TEST_INSTANCE, TEST_USER, id, cntr, ticks_first,
+			       ticks_periodic, TICKER_NULL_REMAINDER, TICKER_NULL_LAZY,
+			       ticks_slot, timeout, (void *)(uintptr_t)id, op_done,
+			       NULL, &ext_data[id]);
+	zassert_true(ret == TICKER_STATUS_SUCCESS || ret == TICKER_STATUS_BUSY, "Start failed");
+
+	run();
+}
+
+static void stop(uint8_t id)
+{
+	uint32_t ret;
+
+	ret = ticker_stop(TEST_INSTANCE, TEST_USER, id, op_done, NULL);
+	zassert_true(ret == TICKER_STATUS_SUCCESS || ret == TICKER_STATUS_BUSY, "Stop failed");
+
+	tickers[id].started = false;
+
+	run();
+}
+
+static int compare_u32(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+static void report(const char *name)
+{
+	uint64_t sum = 0U;
+
+	zassert_true(job_count > 0U, "ticker_job never ran");
+
+	qsort(job_ns, job_count, sizeof(job_ns[0]), compare_u32);
+
+	for (uint32_t i = 0U; i < job_count; i++) {
+		sum += job_ns[i];
+	}
+
+	TC_PRINT("%s: %u ticker_job runs, %u nodes, skip list %s\n", name, job_count,
+		 TEST_NODES, IS_ENABLED(CONFIG_BT_TICKER_SKIP_LIST) ? "on" : "off");
+	TC_PRINT("  ns: min %u, mean %u, p50 %u, p90 %u, p99 %u, max %u\n", job_ns[0],
+		 (uint32_t)(sum / job_count), job_ns[job_count / 2],
+		 job_ns[(job_count * 9U) / 10U], job_ns[(job_count * 99U) / 100U],
+		 job_ns[job_count - 1U]);
+}
+
+/* Starts all ticker nodes, then runs for the given number of expirations,
+ * restarting a random ticker node with new parameters at each one.
+ */
+static void simulate(uint32_t ticks_slot, uint32_t ticks_slot_window,
+		     uint32_t expirations)
+{
+	for (uint8_t id = 0U; id < TEST_NODES; id++) {
+		start(id, ticks_slot, ticks_slot_window);
+	}
+
+	job_count = 0U;
+
+	for (uint32_t i = 0U; i < expirations; i++) {
+		uint8_t id = test_rand() % TEST_NODES;
+
+		expire();
+
+		stop(id);
+		start(id, ticks_slot, ticks_slot_window);
+	}
+
+	for (uint8_t id = 0U; id < TEST_NODES; id++) {
+		zassert_true(tickers[id].expired > 0U, "Ticker %u never expired", id);
+		stop(id);
+	}
+
+	zassert_equal(_instance[TEST_INSTANCE].ticker_id_head, TICKER_NULL,
+		      "Tickers left active");
+}
+
+static void ticker_setup(void *f)
+{
+	uint32_t ret;
+
+	memset(nodes, 0, sizeof(nodes));
+	memset(tickers, 0, sizeof(tickers));
+	memset(ext_data, 0, sizeof(ext_data));
+
+	seed = 1U;
+	cntr = 0U;
+	worker_pending = false;
+	job_pending = false;
+
+	users[0].count_user_op = TEST_USER_OPS;
+
+	ret = ticker_init(TEST_INSTANCE, TEST_NODES, nodes, ARRAY_SIZE(users), users,
+			  TEST_USER_OPS, user_ops, caller_id_get, sched, trigger_set);
+	zassert_equal(ret, TICKER_STATUS_SUCCESS, "Init failed");
+}
+
+ZTEST(ticker, test_expire_in_order)
+{
+	simulate(0U, 0U, 20000U);
+	report("No reservation");
+}
+
+ZTEST(ticker, test_expire_with_collisions)
+{
+	simulate(HAL_TICKER_US_TO_TICKS(1250), 0U, 20000U);
+	report("Reservations");
+}
+
+ZTEST(ticker, test_reschedule_in_window)
+{
+	simulate(HAL_TICKER_US_TO_TICKS(1250), HAL_TICKER_US_TO_TICKS(10000), 20000U);
+	report("Reservations in window");
+}
+
+ZTEST_SUITE(ticker, NULL, NULL, ticker_setup, NULL, NULL);
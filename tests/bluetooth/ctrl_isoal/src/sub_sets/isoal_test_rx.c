@@ -910,6 +910,92 @@ ZTEST(test_rx_unframed, test_rx_unframed_single_pdu)
 		      FSM_TO_STR(ISOAL_START));
 }
 
+/**
+ * Test Suite  :   RX unframed PDU reassembly
+ *
+ * Tests reassembly of a single valid RX PDU into an SDU written in place,
+ * without an SDU write callback
+ */
+ZTEST(test_rx_unframed, test_rx_unframed_single_pdu_in_place)
+{
+	struct rx_pdu_meta_buffer rx_pdu_meta_buf;
+	struct rx_sdu_frag_buffer rx_sdu_frag_buf;
+	struct isoal_sdu_buffer sdu_buffer;
+	isoal_sink_handle_t sink_hdl;
+	uint32_t stream_sync_delay;
+	uint32_t group_sync_delay;
+	uint8_t iso_interval_int;
+	uint32_t sdu_interval;
+	uint8_t testdata[23];
+	isoal_status_t err;
+	uint8_t role;
+	uint8_t BN;
+	uint8_t FT;
+
+	/* Settings */
+	role = ISOAL_ROLE_PERIPHERAL;
+	iso_interval_int = 1;
+	sdu_interval = ISO_INT_UNIT_US;
+	BN = 1;
+	FT = 1;
+	stream_sync_delay = (iso_interval_int * ISO_INT_UNIT_US) - 200;
+	group_sync_delay = (iso_interval_int * ISO_INT_UNIT_US) - 50;
+
+	/* PDU 0 -------------------------------------------------------------*/
+	isoal_test_init_rx_pdu_buffer(&rx_pdu_meta_buf);
+	isoal_test_init_rx_sdu_buffer(&rx_sdu_frag_buf);
+	init_test_data_buffer(testdata, 23);
+	sdu_buffer.dbuf = &rx_sdu_frag_buf.sdu[0];
+	sdu_buffer.size = TEST_RX_SDU_FRAG_PAYLOAD_MAX;
+
+	ztest_set_assert_valid(false);
+
+	err = isoal_init();
+	zassert_equal(err, ISOAL_STATUS_OK, "err = 0x%02x", err);
+
+	err = isoal_reset();
+	zassert_equal(err, ISOAL_STATUS_OK, "err = 0x%02x", err);
+
+	/* Create a sink without SDU write callback */
+	err = isoal_sink_create(0xADAD, role, false, BN, FT, sdu_interval, iso_interval_int,
+				stream_sync_delay, group_sync_delay, sink_sdu_alloc_test,
+				sink_sdu_emit_test, NULL, &sink_hdl);
+	zassert_equal(err, ISOAL_STATUS_OK, "err = 0x%02x", err);
+
+	isoal_sink_enable(sink_hdl);
+
+	/* Send SDU in a single PDU */
+	isoal_test_create_unframed_pdu(PDU_BIS_LLID_COMPLETE_END,
+				       &testdata[0],
+				       23,
+				       2000,
+				       9249,
+				       ISOAL_PDU_STATUS_VALID,
+				       &rx_pdu_meta_buf.pdu_meta);
+
+	/* Set callback function return values */
+	push_custom_sink_sdu_alloc_test_output_buffer(&sdu_buffer);
+	sink_sdu_alloc_test_fake.return_val = ISOAL_STATUS_OK;
+	sink_sdu_emit_test_fake.return_val = ISOAL_STATUS_OK;
+
+	err = isoal_rx_pdu_recombine(sink_hdl, &rx_pdu_meta_buf.pdu_meta);
+
+	zassert_equal(err, ISOAL_STATUS_OK, "err = 0x%02x", err);
+
+	/* SDU 0 -------------------------------------------------------------*/
+	/* Test recombine (Black Box) */
+	ZASSERT_ISOAL_SDU_ALLOC_TEST_CALL_COUNT(1);
+	ZASSERT_ISOAL_SDU_WRITE_TEST_CALL_COUNT(0);
+	ZASSERT_ISOAL_SDU_EMIT_TEST_CALL_COUNT(1);
+
+	zassert_equal(sink_sdu_emit_test_handler_fake.arg1_val.sdu_frag_size, 23,
+		      "Expected SDU frag of size 23, got %u.",
+		      sink_sdu_emit_test_handler_fake.arg1_val.sdu_frag_size);
+
+	/* PDU payload should have been written to the SDU buffer in place */
+	zassert_mem_equal(&rx_sdu_frag_buf.sdu[0], &testdata[0], 23, "SDU contents differ");
+}
+
 /**
  * Test Suite  :   RX unframed PDU reassembly
  *
@@ -5046,6 +5046,162 @@ ZTEST(test_tx_framed, test_tx_framed_1_sdu_3_frag_2_pdu)
 	ZASSERT_PDU_RELEASE_TEST_CALL_COUNT(0);
 }
 
+/* PDU buffer with room for the complete PDU payload */
+struct tx_pdu_write_buffer {
+	struct node_tx_iso node_tx;
+	uint8_t pdu[TEST_TX_PDU_SIZE];
+};
+
+static uint32_t tx_pdu_write_copy_count;
+
+/**
+ * PDU writer copying SDU payload to the PDU, as the LL data path did before
+ * writing in place
+ */
+static isoal_status_t tx_pdu_write_copy(struct isoal_pdu_buffer *pdu_buffer,
+					const size_t pdu_offset,
+					const uint8_t *sdu_payload,
+					const size_t consume_len)
+{
+	zassert_false((pdu_offset + consume_len) > pdu_buffer->size,
+		      "Write size of %u at offset %u exceeds buffer!",
+		      consume_len,
+		      pdu_offset);
+
+	memcpy(&pdu_buffer->pdu->payload[pdu_offset], sdu_payload, consume_len);
+	tx_pdu_write_copy_count++;
+
+	return ISOAL_STATUS_OK;
+}
+
+/**
+ * Segments one SDU of three fragments into two framed PDUs using the given
+ * PDU writer
+ * @param pdu_write       PDU writer or NULL to write in place
+ * @param tx_pdu_buf      Two PDU buffers
+ * @param testdata        SDU contents
+ * @param testdata_size   SDU size
+ */
+static void tx_framed_write_run(isoal_source_pdu_write_cb pdu_write,
+				struct tx_pdu_write_buffer *tx_pdu_buf,
+				uint8_t *testdata,
+				uint16_t testdata_size)
+{
+	struct tx_sdu_frag_buffer tx_sdu_frag_buf;
+	struct isoal_pdu_buffer pdu_buffer[2];
+	isoal_source_handle_t source_hdl;
+	uint16_t testdata_indx;
+	uint32_t sdu_timestamp;
+	uint16_t frag_size;
+	isoal_status_t err;
+	uint32_t ref_point;
+
+	isoal_test_tx_common_before(NULL);
+
+	err = isoal_init();
+	zassert_equal(err, ISOAL_STATUS_OK, "err = 0x%02x", err);
+
+	err = isoal_reset();
+	zassert_equal(err, ISOAL_STATUS_OK, "err = 0x%02x", err);
+
+	err = isoal_source_create(0xADAD, ISOAL_ROLE_PERIPHERAL, true, 2, 1,
+				  TEST_TX_PDU_PAYLOAD_MAX + 5, ISO_INT_UNIT_US + 50, 1,
+				  ISO_INT_UNIT_US - 200, ISO_INT_UNIT_US - 50,
+				  source_pdu_alloc_test, pdu_write, source_pdu_emit_test,
+				  source_pdu_release_test, &source_hdl);
+	zassert_equal(err, ISOAL_STATUS_OK, "err = 0x%02x", err);
+
+	isoal_source_enable(source_hdl);
+
+	for (int i = 0; i < 2; i++) {
+		(void)memset(&tx_pdu_buf[i], 0, sizeof(tx_pdu_buf[i]));
+		pdu_buffer[i].handle = (void *)&tx_pdu_buf[i].node_tx;
+		pdu_buffer[i].pdu = (struct pdu_iso *)tx_pdu_buf[i].node_tx.pdu;
+		pdu_buffer[i].size = TEST_TX_PDU_PAYLOAD_MAX;
+		SET_NEXT_PDU_ALLOC_BUFFER(&pdu_buffer[i]);
+	}
+
+	PDU_ALLOC_TEST_RETURNS(ISOAL_STATUS_OK);
+	PDU_EMIT_TEST_RETURNS(ISOAL_STATUS_OK);
+	PDU_RELEASE_TEST_RETURNS(ISOAL_STATUS_OK);
+
+	sdu_timestamp = 9249;
+	ref_point = sdu_timestamp + ISO_INT_UNIT_US - 50;
+	frag_size = testdata_size / 3;
+
+	for (testdata_indx = 0; testdata_indx < testdata_size; testdata_indx += frag_size) {
+		uint8_t sdu_state;
+
+		if (testdata_indx == 0) {
+			sdu_state = BT_ISO_START;
+		} else if ((testdata_size - testdata_indx) <= (2 * frag_size)) {
+			sdu_state = BT_ISO_END;
+			frag_size = testdata_size - testdata_indx;
+		} else {
+			sdu_state = BT_ISO_CONT;
+		}
+
+		isoal_test_init_tx_sdu_buffer(&tx_sdu_frag_buf);
+		isoal_test_create_sdu_fagment(sdu_state,
+					      &testdata[testdata_indx],
+					      frag_size,
+					      testdata_size,
+					      2000,
+					      sdu_timestamp,
+					      sdu_timestamp,
+					      ref_point,
+					      2000,
+					      &tx_sdu_frag_buf.sdu_tx);
+
+		err = isoal_tx_sdu_fragment(source_hdl, &tx_sdu_frag_buf.sdu_tx);
+		zassert_equal(err, ISOAL_STATUS_OK, "err = 0x%02x", err);
+
+		sdu_timestamp += 10;
+	}
+
+	isoal_source_destroy(source_hdl);
+}
+
+/**
+ * Test Suite  :   TX framed SDU segmentation
+ *
+ * Tests that segmentation of a single SDU contained in three fragments into
+ * two PDUs, written in place without a PDU write callback, produces the same
+ * PDUs as with a copying PDU write callback
+ */
+ZTEST(test_tx_framed, test_tx_framed_1_sdu_3_frag_2_pdu_in_place)
+{
+	struct tx_pdu_write_buffer tx_pdu_buf_copy[2];
+	struct tx_pdu_write_buffer tx_pdu_buf[2];
+	uint8_t testdata[MAX_FRAMED_PDU_PAYLOAD(2)];
+	uint32_t emit_count;
+
+	init_test_data_buffer(testdata, sizeof(testdata));
+
+	tx_pdu_write_copy_count = 0;
+	tx_framed_write_run(tx_pdu_write_copy, tx_pdu_buf_copy, testdata, sizeof(testdata));
+	emit_count = source_pdu_emit_test_fake.call_count;
+
+	tx_framed_write_run(NULL, tx_pdu_buf, testdata, sizeof(testdata));
+
+	/* Same PDUs expected, without any write callback */
+	ZASSERT_PDU_EMIT_TEST_CALL_COUNT(emit_count);
+	zassert_true(tx_pdu_write_copy_count > 0, "PDU writer not called");
+
+	for (int i = 0; i < 2; i++) {
+		struct pdu_iso *pdu_copy = (struct pdu_iso *)tx_pdu_buf_copy[i].node_tx.pdu;
+		struct pdu_iso *pdu = (struct pdu_iso *)tx_pdu_buf[i].node_tx.pdu;
+
+		zassert_equal(pdu->ll_id, pdu_copy->ll_id, "PDU %d LLID differs", i);
+		zassert_equal(pdu->len, pdu_copy->len, "PDU %d length differs", i);
+		zassert_mem_equal(pdu->payload, pdu_copy->payload, TEST_TX_PDU_PAYLOAD_MAX,
+				  "PDU %d payload differs", i);
+	}
+
+	TC_PRINT("%u PDU write callbacks for %u SDU bytes avoided\n",
+		 tx_pdu_write_copy_count, (uint32_t)sizeof(testdata));
+}
+
 /**
  * Test Suite  :   TX framed SDU segmentation
  *
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/util.h>
+
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/gatt.h>
+
+#define NUM_CHRC 100
+#define HIGH_HANDLE 0x0300
+#define BENCH_ROUNDS 20
+
+static const struct bt_uuid_128 big_uuid = BT_UUID_INIT_128(
+	0x01, 0xde, 0xbc, 0x9a, 0x78, 0x56, 0x34, 0x12,
+	0x78, 0x56, 0x34, 0x12, 0x78, 0x56, 0x34, 0x12);
+
+static const struct bt_uuid_128 big_chrc_uuid = BT_UUID_INIT_128(
+	0x02, 0xde, 0xbc, 0x9a, 0x78, 0x56, 0x34, 0x12,
+	0x78, 0x56, 0x34, 0x12, 0x78, 0x56, 0x34, 0x12);
+
+static const struct bt_uuid_128 high_uuid = BT_UUID_INIT_128(
+	0x03, 0xde, 0xbc, 0x9a, 0x78, 0x56, 0x34, 0x12,
+	0x78, 0x56, 0x34, 0x12, 0x78, 0x56, 0x34, 0x12);
+
+static uint8_t chrc_value;
+
+#define BIG_CHRC(i, _) \
+	BT_GATT_CHARACTERISTIC(&big_chrc_uuid.uuid, BT_GATT_CHRC_READ, \
+			       BT_GATT_PERM_READ, NULL, NULL, &chrc_value)
+
+static struct bt_gatt_attr big_attrs[] = {
+	BT_GATT_PRIMARY_SERVICE(&big_uuid),
+	LISTIFY(NUM_CHRC, BIG_CHRC, (,)),
+};
+
+static struct bt_gatt_service big_svc = BT_GATT_SERVICE(big_attrs);
+
+static struct bt_gatt_attr high_attrs[] = {
+	BT_GATT_PRIMARY_SERVICE(&high_uuid),
+	BT_GATT_CHARACTERISTIC(&big_chrc_uuid.uuid, BT_GATT_CHRC_READ,
+			       BT_GATT_PERM_READ, NULL, NULL, &chrc_value),
+};
+
+static struct bt_gatt_service high_svc = BT_GATT_SERVICE(high_attrs);
+
+struct found {
+	const struct bt_gatt_attr *attr;
+	uint16_t handle;
+	uint16_t count;
+};
+
+static uint8_t found_attr(const struct bt_gatt_attr *attr, uint16_t handle,
+			  void *user_data)
+{
+	struct found *found = user_data;
+
+	if (!found->attr) {
+		found->attr = attr;
+		found->handle = handle;
+	}
+
+	found->count++;
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+static const struct bt_gatt_attr *lookup(uint16_t handle)
+{
+	struct found found = { 0 };
+
+	bt_gatt_foreach_attr(handle, handle, found_attr, &found);
+
+	zassert_true(found.count <= 1, "Several attributes with handle 0x%04x",
+		     handle);
+
+	return found.attr;
+}
+
+ZTEST(gatt_index, test_lookup_by_handle)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(big_attrs); i++) {
+		zassert_equal_ptr(lookup(big_attrs[i].handle), &big_attrs[i],
+				  "Wrong attribute for handle 0x%04x",
+				  big_attrs[i].handle);
+	}
+
+	/* Nothing is registered past the service */
+	zassert_is_null(lookup(big_attrs[ARRAY_SIZE(big_attrs) - 1].handle + 1));
+	zassert_is_null(lookup(0xffff));
+}
+
+ZTEST(gatt_index, test_lookup_by_type)
+{
+	struct found found = { 0 };
+	uint16_t start = big_attrs[0].handle;
+	uint16_t end = big_attrs[ARRAY_SIZE(big_attrs) - 1].handle;
+
+	bt_gatt_foreach_attr_type(start, end, BT_UUID_GATT_CHRC, NULL, 0,
+				  found_attr, &found);
+	zassert_equal(found.count, NUM_CHRC);
+	zassert_equal_ptr(found.attr, &big_attrs[1]);
+	zassert_equal(found.handle, big_attrs[1].handle);
+
+	/* Start in the middle of a characteristic, stop on first match */
+	(void)memset(&found, 0, sizeof(found));
+	bt_gatt_foreach_attr_type(big_attrs[4].handle, end, BT_UUID_GATT_CHRC,
+				  NULL, 1, found_attr, &found);
+	zassert_equal(found.count, 1);
+	zassert_equal_ptr(found.attr, &big_attrs[5]);
+
+	/* The service is found among the other primary services */
+	(void)memset(&found, 0, sizeof(found));
+	bt_gatt_foreach_attr_type(0x0001, 0xffff, BT_UUID_GATT_PRIMARY,
+				  big_attrs[0].user_data, 0, found_attr, &found);
+	zassert_equal(found.count, 1);
+	zassert_equal_ptr(found.attr, &big_attrs[0]);
+
+	/* Characteristic values are not indexed by type */
+	(void)memset(&found, 0, sizeof(found));
+	bt_gatt_foreach_attr_type(start, end, &big_chrc_uuid.uuid, NULL, 0,
+				  found_attr, &found);
+	zassert_equal(found.count, NUM_CHRC);
+	zassert_equal_ptr(found.attr, &big_attrs[2]);
+}
+
+ZTEST(gatt_index, test_high_handles)
+{
+	struct found found = { 0 };
+
+	for (size_t i = 0; i < ARRAY_SIZE(high_attrs); i++) {
+		high_attrs[i].handle = HIGH_HANDLE + i;
+	}
+
+	zassert_ok(bt_gatt_service_register(&high_svc));
+
+	for (size_t i = 0; i < ARRAY_SIZE(high_attrs); i++) {
+		zassert_equal_ptr(lookup(HIGH_HANDLE + i), &high_attrs[i]);
+	}
+
+	/* Iteration spans both attributes below and above the index */
+	bt_gatt_foreach_attr_type(big_attrs[0].handle, 0xffff, BT_UUID_GATT_CHRC,
+				  NULL, 0, found_attr, &found);
+	zassert_equal(found.count, NUM_CHRC + 1);
+
+	zassert_ok(bt_gatt_service_unregister(&high_svc));
+	zassert_is_null(lookup(HIGH_HANDLE));
+}
+
+ZTEST(gatt_index, test_unregister)
+{
+	uint16_t handle = big_attrs[1].handle;
+
+	zassert_ok(bt_gatt_service_unregister(&big_svc));
+	zassert_is_null(lookup(handle));
+
+	zassert_ok(bt_gatt_service_register(&big_svc));
+	zassert_equal_ptr(lookup(handle), &big_attrs[1]);
+}
+
+ZTEST(gatt_index, test_benchmark)
+{
+	uint16_t end = big_attrs[ARRAY_SIZE(big_attrs) - 1].handle;
+	uint32_t start, cycles;
+	struct found found;
+
+	start = k_cycle_get_32();
+
+	for (int round = 0; round < BENCH_ROUNDS; round++) {
+		for (uint16_t handle = 1; handle <= end; handle++) {
+			(void)lookup(handle);
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	TC_PRINT("%u attributes%s: %u ns per lookup by handle\n", end,
+		 IS_ENABLED(CONFIG_BT_GATT_ATTR_INDEX) ? " indexed" : "",
+		 (uint32_t)(k_cyc_to_ns_floor64(cycles) / (BENCH_ROUNDS * end)));
+
+	start = k_cycle_get_32();
+
+	for (int round = 0; round < BENCH_ROUNDS; round++) {
+		(void)memset(&found, 0, sizeof(found));
+		bt_gatt_foreach_attr_type(0x0001, 0xffff, BT_UUID_GATT_CHRC, NULL, 0,
+					  found_attr, &found);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	TC_PRINT("%u attributes%s: %u ns per characteristic discovery\n", end,
+		 IS_ENABLED(CONFIG_BT_GATT_ATTR_INDEX) ? " indexed" : "",
+		 (uint32_t)(k_cyc_to_ns_floor64(cycles) / BENCH_ROUNDS));
+}
+
+static void *gatt_index_setup(void)
+{
+	zassert_ok(bt_gatt_service_register(&big_svc));
+
+	return NULL;
+}
+
+static void gatt_index_teardown(void *fixture)
+{
+	zassert_ok(bt_gatt_service_unregister(&big_svc));
+}
+
+ZTEST_SUITE(gatt_index, NULL, gatt_index_setup, NULL, NULL, gatt_index_teardown);
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/bluetooth/mesh.h>
+
+#include "msg_cache.h"
+
+#define CACHE_SIZE CONFIG_BT_MESH_MSG_CACHE_SIZE
+
+/* Source address and sequence number of the i-th message of a test */
+static uint16_t msg_src(uint32_t i)
+{
+	return 0x0001 + (i % 7);
+}
+
+static uint32_t msg_seq(uint32_t i)
+{
+	return 0x100 + i;
+}
+
+static void add_msgs(uint32_t first, uint32_t count)
+{
+	for (uint32_t i = first; i < first + count; i++) {
+		bt_mesh_msg_cache_add(msg_src(i), msg_seq(i));
+	}
+}
+
+static void check_msgs(uint32_t first, uint32_t count, bool match)
+{
+	for (uint32_t i = first; i < first + count; i++) {
+		zassert_equal(bt_mesh_msg_cache_match(msg_src(i), msg_seq(i)), match,
+			      "Message %u expected to%s match", i, match ? "" : " not");
+	}
+}
+
+ZTEST(bt_mesh_msg_cache, test_match)
+{
+	zassert_false(bt_mesh_msg_cache_match(msg_src(0), msg_seq(0)));
+
+	add_msgs(0, CACHE_SIZE);
+	check_msgs(0, CACHE_SIZE, true);
+	check_msgs(CACHE_SIZE, CACHE_SIZE, false);
+
+	/* Same source with another sequence number, and the other way round */
+	zassert_false(bt_mesh_msg_cache_match(msg_src(0), msg_seq(CACHE_SIZE) + 7));
+	zassert_false(bt_mesh_msg_cache_match(0x7fff, msg_seq(0)));
+}
+
+ZTEST(bt_mesh_msg_cache, test_seq_bits)
+{
+	/* Only the 17 least significant bits of the sequence number are cached */
+	bt_mesh_msg_cache_add(0x0042, 0x000123);
+
+	zassert_true(bt_mesh_msg_cache_match(0x0042, 0x020123));
+	zassert_true(bt_mesh_msg_cache_match(0x0042, 0xfe0123));
+	zassert_false(bt_mesh_msg_cache_match(0x0042, 0x010123));
+}
+
+ZTEST(bt_mesh_msg_cache, test_eviction)
+{
+	/* Wrap around the cache several times */
+	for (uint32_t i = 0; i < 3 * CACHE_SIZE; i++) {
+		add_msgs(i, 1);
+		check_msgs(i + 1 > CACHE_SIZE ? i + 1 - CACHE_SIZE : 0, MIN(i + 1, CACHE_SIZE),
+			   true);
+
+		if (i >= CACHE_SIZE) {
+			check_msgs(i - CACHE_SIZE, 1, false);
+		}
+	}
+}
+
+ZTEST(bt_mesh_msg_cache, test_rewind)
+{
+	add_msgs(0, CACHE_SIZE + 1);
+
+	bt_mesh_msg_cache_rewind();
+	check_msgs(CACHE_SIZE, 1, false);
+	check_msgs(1, CACHE_SIZE - 1, true);
+
+	/* The entry rewound is used again */
+	add_msgs(CACHE_SIZE + 1, 1);
+	check_msgs(CACHE_SIZE + 1, 1, true);
+	check_msgs(1, CACHE_SIZE - 1, true);
+}
+
+ZTEST(bt_mesh_msg_cache, test_clear)
+{
+	add_msgs(0, CACHE_SIZE);
+
+	bt_mesh_msg_cache_clear();
+	check_msgs(0, CACHE_SIZE, false);
+
+	add_msgs(0, 1);
+	check_msgs(0, 1, true);
+}
+
+static void msg_cache_before(void *f)
+{
+	bt_mesh_msg_cache_clear();
+}
+
+ZTEST_SUITE(bt_mesh_msg_cache, NULL, NULL, msg_cache_before, NULL, NULL);
@@ -469,3 +469,113 @@ ZTEST(bt_mesh_rpl_reset, test_rpl_check_on_save_new_entry)
 	zassert_true(bt_mesh_rpl_check(&msg, NULL));
 	check_empty_entries(EMPTY_ENTRIES_CNT - 1);
 }
+
+/**** Lookup tests ****/
+
+#define BENCH_ROUNDS 100
+
+static void fill_rpl(void)
+{
+	for (int i = 0; i < CONFIG_BT_MESH_CRPL; i++) {
+		struct bt_mesh_net_rx msg = {
+			.local_match = true,
+			.ctx.addr = 1 + i * 7,
+			.old_iv = false,
+			.seq = 100 + i,
+		};
+
+		ztest_expect_value(bt_mesh_settings_store_schedule, flag,
+				   BT_MESH_SETTINGS_RPL_PENDING);
+		zassert_false(bt_mesh_rpl_check(&msg, NULL));
+	}
+}
+
+ZTEST_SUITE(bt_mesh_rpl_lookup, NULL, NULL, setup, NULL, NULL);
+
+/** Test that every entry of a full RPL is found. */
+ZTEST(bt_mesh_rpl_lookup, test_full_list)
+{
+	struct bt_mesh_rpl *match;
+
+	fill_rpl();
+
+	for (int i = 0; i < CONFIG_BT_MESH_CRPL; i++) {
+		struct bt_mesh_net_rx msg = {
+			.local_match = true,
+			.ctx.addr = 1 + i * 7,
+			.old_iv = false,
+			.seq = 100 + i,
+		};
+
+		/* Same sequence number is a replay. */
+		zassert_true(bt_mesh_rpl_check(&msg, &match), "src 0x%04x", msg.ctx.addr);
+
+		/* Higher sequence number is accepted in the entry of the source. */
+		msg.seq++;
+		match = NULL;
+		zassert_false(bt_mesh_rpl_check(&msg, &match), "src 0x%04x", msg.ctx.addr);
+		zassert_not_null(match);
+		zassert_equal(match->src, msg.ctx.addr);
+	}
+
+	/* Unknown sources are rejected once the list is full. */
+	struct bt_mesh_net_rx msg = {
+		.local_match = true,
+		.ctx.addr = 0x7fff,
+		.old_iv = false,
+		.seq = 1,
+	};
+
+	zassert_true(bt_mesh_rpl_check(&msg, &match));
+}
+
+/** Test that the RPL is usable again after being cleared. */
+ZTEST(bt_mesh_rpl_lookup, test_clear_full_list)
+{
+	fill_rpl();
+
+	skip_delete = true;
+	ztest_expect_value(bt_mesh_settings_store_schedule, flag, BT_MESH_SETTINGS_RPL_PENDING);
+	bt_mesh_rpl_clear();
+	bt_mesh_rpl_pending_store(BT_MESH_ADDR_ALL_NODES);
+	skip_delete = false;
+
+	/* Previously seen sequence numbers are accepted again. */
+	fill_rpl();
+}
+
+/** Measure the number of messages checked per second with a full RPL. */
+ZTEST(bt_mesh_rpl_lookup, test_benchmark)
+{
+	struct bt_mesh_rpl *match;
+	uint32_t start, cycles;
+
+	/* Code takes no simulated time on the POSIX architecture */
+	if (IS_ENABLED(CONFIG_ARCH_POSIX)) {
+		ztest_test_skip();
+	}
+
+	fill_rpl();
+
+	start = k_cycle_get_32();
+
+	for (int round = 0; round < BENCH_ROUNDS; round++) {
+		for (int i = 0; i < CONFIG_BT_MESH_CRPL; i++) {
+			struct bt_mesh_net_rx msg = {
+				.local_match = true,
+				.ctx.addr = 1 + i * 7,
+				.old_iv = false,
+				.seq = 100 + i + round,
+			};
+
+			(void)bt_mesh_rpl_check(&msg, &match);
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	TC_PRINT("CRPL %u%s: %u checks/s\n", CONFIG_BT_MESH_CRPL,
+		 IS_ENABLED(CONFIG_BT_MESH_RPL_HASH) ? " (hash)" : "",
+		 (uint32_t)((uint64_t)CONFIG_BT_MESH_CRPL * BENCH_ROUNDS * NSEC_PER_SEC /
+			    MAX(1, k_cyc_to_ns_floor64(cycles))));
+}
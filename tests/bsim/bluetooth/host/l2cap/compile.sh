@@ -15,6 +15,8 @@ app=tests/bsim/bluetooth/host/l2cap/userdata compile
 app=tests/bsim/bluetooth/host/l2cap/stress compile
 app=tests/bsim/bluetooth/host/l2cap/stress conf_file=prj_nofrag.conf compile
 app=tests/bsim/bluetooth/host/l2cap/stress conf_file=prj_syswq.conf compile
+app=tests/bsim/bluetooth/host/l2cap/stress conf_file=prj_drr.conf compile
+app=tests/bsim/bluetooth/host/l2cap/stress conf_file=prj_rx_chain.conf compile
 app=tests/bsim/bluetooth/host/l2cap/split/dut compile
 app=tests/bsim/bluetooth/host/l2cap/split/tester compile
 app=tests/bsim/bluetooth/host/l2cap/ecred/dut compile
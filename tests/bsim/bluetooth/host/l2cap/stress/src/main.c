@@ -132,22 +132,31 @@ void sent_cb(struct bt_l2cap_chan *chan)
 
 int recv_cb(struct bt_l2cap_chan *chan, struct net_buf *buf)
 {
-	LOG_DBG("len %d", buf->len);
+	size_t offset = 0;
+
+	LOG_DBG("len %zu", net_buf_frags_len(buf));
 	rx_cnt++;
 
-	/* Verify SDU data matches TX'd data. */
-	int pos = memcmp(buf->data, tx_data, buf->len);
+	ASSERT(net_buf_frags_len(buf) <= sizeof(tx_data), "RX SDU too long\n");
+
+	/* Verify SDU data matches TX'd data. The SDU may be fragmented. */
+	for (struct net_buf *frag = buf; frag; frag = frag->frags) {
+		int pos = memcmp(frag->data, &tx_data[offset], frag->len);
 
-	if (pos != 0) {
-		LOG_ERR("RX data doesn't match TX: pos %d", pos);
-		LOG_HEXDUMP_ERR(buf->data, buf->len, "RX data");
-		LOG_HEXDUMP_INF(tx_data, buf->len, "TX data");
+		if (pos != 0) {
+			LOG_ERR("RX data doesn't match TX: pos %d", pos);
+			LOG_HEXDUMP_ERR(frag->data, frag->len, "RX data");
+			LOG_HEXDUMP_INF(&tx_data[offset], frag->len, "TX data");
 
-		for (uint16_t p = 0; p < buf->len; p++) {
-			__ASSERT(buf->data[p] == tx_data[p],
-				 "Failed rx[%d]=%x != expect[%d]=%x",
-				 p, buf->data[p], p, tx_data[p]);
+			for (uint16_t p = 0; p < frag->len; p++) {
+				__ASSERT(frag->data[p] == tx_data[offset + p],
+					 "Failed rx[%zu]=%x != expect[%zu]=%x",
+					 offset + p, frag->data[p], offset + p,
+					 tx_data[offset + p]);
+			}
 		}
+
+		offset += frag->len;
 	}
 
 	return 0;
@@ -411,9 +420,34 @@ static void connect_l2cap_channel(struct bt_conn *conn, void *data)
 	WAIT_FOR_FLAG_SET(flag_l2cap_connected);
 }
 
+#if defined(CONFIG_BT_CONN_TX_STATS)
+static void check_tx_progress(struct bt_conn *conn, void *data)
+{
+	struct bt_conn_tx_stats stats;
+	int err;
+
+	err = bt_conn_get_tx_stats(conn, &stats);
+	if (err) {
+		/* The peripheral may already have disconnected */
+		return;
+	}
+
+	LOG_INF("conn %u: %u bytes in %u frags, %u bps, %u queued",
+		bt_conn_index(conn), stats.bytes, stats.frags,
+		(uint32_t)(((uint64_t)stats.bytes * 8U * MSEC_PER_SEC) /
+			   MAX(stats.elapsed_ms, 1U)),
+		stats.in_ll);
+
+	/* When the first link is done, no other link should have been starved */
+	ASSERT(stats.bytes > 0, "conn %u did not get to send\n", bt_conn_index(conn));
+}
+#endif /* CONFIG_BT_CONN_TX_STATS */
+
 static void test_central_main(void)
 {
 	LOG_DBG("*L2CAP STRESS Central started*");
+	uint32_t elapsed_ms;
+	uint32_t start_ms;
 	int err;
 
 	/* Prepare tx_data */
@@ -435,6 +469,7 @@ static void test_central_main(void)
 	bt_conn_foreach(BT_CONN_TYPE_LE, connect_l2cap_channel, NULL);
 
 	/* Send SDU_NUM SDUs to each peripheral */
+	start_ms = k_uptime_get_32();
 	for (int i = 0; i < NUM_PERIPHERALS; i++) {
 		contexts[i].tx_left = SDU_NUM;
 		l2cap_chan_send(&contexts[i].le_chan.chan, tx_data, sizeof(tx_data));
@@ -442,6 +477,7 @@ static void test_central_main(void)
 
 	LOG_DBG("Wait until all transfers are completed.");
 	int remaining_tx_total;
+	__maybe_unused bool progress_checked = false;
 
 	do {
 		k_msleep(100);
@@ -449,9 +485,24 @@ static void test_central_main(void)
 		remaining_tx_total = 0;
 		for (int i = 0; i < L2CAP_CHANS; i++) {
 			remaining_tx_total += contexts[i].tx_left;
+
+#if defined(CONFIG_BT_CONN_TX_STATS)
+			if (!progress_checked && contexts[i].tx_left == 0) {
+				bt_conn_foreach(BT_CONN_TYPE_LE, check_tx_progress, NULL);
+				progress_checked = true;
+			}
+#endif /* CONFIG_BT_CONN_TX_STATS */
 		}
 	} while (remaining_tx_total);
 
+	/* Throughput as seen by the sender, which the credits granted by the
+	 * peripherals keep close to the rate at which they receive.
+	 */
+	elapsed_ms = MAX(k_uptime_get_32() - start_ms, 1U);
+	LOG_INF("Sent %u bytes in %u ms: %u bps", NUM_PERIPHERALS * SDU_NUM * SDU_LEN,
+		elapsed_ms, (uint32_t)(NUM_PERIPHERALS * SDU_NUM * SDU_LEN * 8ULL * 1000U /
+				       elapsed_ms));
+
 	LOG_DBG("Waiting until all peripherals are disconnected..");
 	while (disconnect_counter < NUM_PERIPHERALS) {
 		k_msleep(100);
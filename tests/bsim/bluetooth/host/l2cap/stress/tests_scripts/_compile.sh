@@ -10,5 +10,7 @@ source ${ZEPHYR_BASE}/tests/bsim/compile.source
 app="$(guess_test_relpath)" compile
 app="$(guess_test_relpath)" conf_file=prj_nofrag.conf compile
 app="$(guess_test_relpath)" conf_file=prj_syswq.conf compile
+app="$(guess_test_relpath)" conf_file=prj_drr.conf compile
+app="$(guess_test_relpath)" conf_file=prj_rx_chain.conf compile
 
 wait_for_background_jobs
@@ -210,6 +210,8 @@ static void test_friend_msg(void)
  */
 static void test_friend_overflow(void)
 {
+	struct bt_mesh_friend_stats stats;
+
 	bt_mesh_test_setup();
 	bt_mesh_test_friendship_init(CONFIG_BT_MESH_FRIEND_LPN_COUNT);
 	bt_mesh_friend_set(BT_MESH_FEATURE_ENABLED);
@@ -233,6 +235,11 @@ static void test_friend_overflow(void)
 	 */
 	bt_mesh_test_send(bt_mesh_test_friendship_addr_get(), NULL, 5, 0, K_NO_WAIT);
 
+	ASSERT_OK(bt_mesh_friend_stats_get(bt_mesh_test_friendship_addr_get(), &stats));
+	ASSERT_EQUAL(CONFIG_BT_MESH_FRIEND_QUEUE_SIZE, stats.queue_size);
+	ASSERT_EQUAL(CONFIG_BT_MESH_FRIEND_QUEUE_SIZE, stats.queue_max);
+	ASSERT_TRUE(stats.dropped >= 1);
+
 	ASSERT_OK_MSG(bt_mesh_test_friendship_evt_wait(BT_MESH_TEST_FRIEND_POLLED,
 						       K_SECONDS(35)),
 		      "Friend never polled");
@@ -12,3 +12,8 @@ overlay=overlay_psa_conf
 RunTest mesh_prov_pb_adv_on_oob_psa \
 	prov_device_pb_adv_no_oob \
 	prov_provisioner_pb_adv_no_oob
+
+overlay=overlay_dhkey_workq_conf
+RunTest mesh_prov_pb_adv_on_oob_dhkey_workq \
+	prov_device_pb_adv_no_oob \
+	prov_provisioner_pb_adv_no_oob
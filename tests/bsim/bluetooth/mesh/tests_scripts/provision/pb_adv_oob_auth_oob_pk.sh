@@ -11,3 +11,7 @@ RunTest mesh_prov_pb_adv_oob_public_key \
 overlay=overlay_psa_conf
 RunTest mesh_prov_pb_adv_oob_public_key_psa \
 	prov_device_pb_adv_oob_public_key prov_provisioner_pb_adv_oob_public_key
+
+overlay=overlay_dhkey_workq_conf
+RunTest mesh_prov_pb_adv_oob_public_key_dhkey_workq \
+	prov_device_pb_adv_oob_public_key prov_provisioner_pb_adv_oob_public_key
@@ -12,3 +12,8 @@ overlay=overlay_psa_conf
 RunTest mesh_prov_pb_adv_repr_psa \
 	prov_device_pb_adv_reprovision \
 	prov_provisioner_pb_adv_reprovision
+
+overlay=overlay_dhkey_workq_conf
+RunTest mesh_prov_pb_adv_repr_dhkey_workq \
+	prov_device_pb_adv_reprovision \
+	prov_provisioner_pb_adv_reprovision
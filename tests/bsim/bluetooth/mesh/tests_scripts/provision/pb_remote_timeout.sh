@@ -34,3 +34,9 @@ RunTest mesh_prov_pb_remote_provisioning_timeout_psa \
 	prov_provisioner_pb_remote_client_provision_timeout \
 	prov_device_pb_remote_server_unproved_unresponsive \
 	prov_device_unresponsive
+
+overlay=overlay_dhkey_workq_conf
+RunTest mesh_prov_pb_remote_provisioning_timeout_dhkey_workq \
+	prov_provisioner_pb_remote_client_provision_timeout \
+	prov_device_pb_remote_server_unproved_unresponsive \
+	prov_device_unresponsive
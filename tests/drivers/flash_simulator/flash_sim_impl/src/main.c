@@ -576,6 +576,72 @@ ZTEST(flash_sim_api, test_get_mock)
 #endif
 }
 
+ZTEST(flash_sim_api, test_get_erase_cycles)
+{
+#ifdef CONFIG_FLASH_SIMULATOR_ERASE_CYCLES
+	off_t last = TEST_SIM_FLASH_END - FLASH_SIMULATOR_ERASE_UNIT;
+	uint32_t first_cycles, last_cycles, cycles;
+	int rc;
+
+	rc = flash_simulator_get_erase_cycles(flash_dev, FLASH_SIMULATOR_BASE_OFFSET,
+					      &first_cycles);
+	zassert_equal(0, rc, "flash_simulator_get_erase_cycles should succeed");
+	rc = flash_simulator_get_erase_cycles(flash_dev, last, &last_cycles);
+	zassert_equal(0, rc, "flash_simulator_get_erase_cycles should succeed");
+
+	rc = flash_erase(flash_dev, last, FLASH_SIMULATOR_ERASE_UNIT);
+	zassert_equal(0, rc, "flash_erase should succeed");
+	rc = flash_erase(flash_dev, last, FLASH_SIMULATOR_ERASE_UNIT);
+	zassert_equal(0, rc, "flash_erase should succeed");
+
+	rc = flash_simulator_get_erase_cycles(flash_dev, last + 1, &cycles);
+	zassert_equal(0, rc, "flash_simulator_get_erase_cycles should succeed");
+	zassert_equal(last_cycles + 2, cycles, "Expected 2 more erase cycles");
+
+	rc = flash_simulator_get_erase_cycles(flash_dev, FLASH_SIMULATOR_BASE_OFFSET,
+					      &cycles);
+	zassert_equal(0, rc, "flash_simulator_get_erase_cycles should succeed");
+	zassert_equal(first_cycles, cycles, "Expected other units not to be erased");
+
+	rc = flash_simulator_get_erase_cycles(flash_dev, TEST_SIM_FLASH_END, &cycles);
+	zassert_equal(-EINVAL, rc, "Expected out of bounds error");
+#else
+	ztest_test_skip();
+#endif
+}
+
+ZTEST(flash_sim_api, test_timing)
+{
+#ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
+	size_t len = FLASH_SIMULATOR_ERASE_UNIT;
+	uint32_t write_us = CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US +
+		((len / FLASH_SIMULATOR_PROG_UNIT) * CONFIG_FLASH_SIMULATOR_WRITE_UNIT_TIME_NS) /
+		NSEC_PER_USEC;
+	uint32_t erase_us = CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US +
+		(2 * CONFIG_FLASH_SIMULATOR_ERASE_UNIT_TIME_US);
+	int64_t start;
+	uint32_t elapsed_us;
+	int rc;
+
+	start = k_uptime_ticks();
+	rc = flash_erase(flash_dev, FLASH_SIMULATOR_BASE_OFFSET,
+			 2 * FLASH_SIMULATOR_ERASE_UNIT);
+	elapsed_us = k_ticks_to_us_floor32(k_uptime_ticks() - start);
+	zassert_equal(0, rc, "flash_erase should succeed");
+	zassert_true(elapsed_us + k_ticks_to_us_ceil32(1) >= erase_us,
+		     "Erase took %u us, expected %u us", elapsed_us, erase_us);
+
+	start = k_uptime_ticks();
+	rc = flash_write(flash_dev, FLASH_SIMULATOR_BASE_OFFSET, test_read_buf, len);
+	elapsed_us = k_ticks_to_us_floor32(k_uptime_ticks() - start);
+	zassert_equal(0, rc, "flash_write should succeed");
+	zassert_true(elapsed_us + k_ticks_to_us_ceil32(1) >= write_us,
+		     "Write took %u us, expected %u us", elapsed_us, write_us);
+#else
+	ztest_test_skip();
+#endif
+}
+
 void *flash_sim_setup(void)
 {
 	test_init();
@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define BLK_SZ 64
+#define NUM_BLOCKS 8
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+#define BENCH_THREADS 4
+#define BENCH_BLOCKS 64
+#define BENCH_ITERATIONS 20000
+
+K_MEM_SLAB_DEFINE(bulk_slab, BLK_SZ, NUM_BLOCKS, 4);
+K_MEM_SLAB_DEFINE(cache_slab, BLK_SZ, NUM_BLOCKS, 4);
+K_MEM_SLAB_DEFINE(bench_slab, BLK_SZ, BENCH_BLOCKS, 4);
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+K_MEM_SLAB_CPU_CACHE_DEFINE(cache_slab_cache);
+K_MEM_SLAB_CPU_CACHE_DEFINE(bench_slab_cache);
+#endif
+
+static K_THREAD_STACK_DEFINE(waiter_stack, STACK_SIZE);
+static struct k_thread waiter_thread;
+
+static K_THREAD_STACK_ARRAY_DEFINE(bench_stacks, BENCH_THREADS, STACK_SIZE);
+static struct k_thread bench_threads[BENCH_THREADS];
+
+static void *waiter_block;
+static int waiter_result;
+
+static void waiter_entry(void *p1, void *p2, void *p3)
+{
+	struct k_mem_slab *slab = p1;
+
+	waiter_result = k_mem_slab_alloc(slab, &waiter_block, K_FOREVER);
+}
+
+static void start_waiter(struct k_mem_slab *slab)
+{
+	waiter_block = NULL;
+	waiter_result = -1;
+
+	k_thread_create(&waiter_thread, waiter_stack, STACK_SIZE, waiter_entry,
+			slab, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	/* Let it block on the empty slab */
+	k_msleep(10);
+	zassert_equal(waiter_result, -1, "Waiter did not block");
+}
+
+ZTEST(mslab_bulk, test_alloc_free_bulk)
+{
+	void *blocks[NUM_BLOCKS];
+	void *block;
+
+	zassert_equal(k_mem_slab_alloc_bulk(&bulk_slab, blocks, 5), 5);
+	zassert_equal(k_mem_slab_num_used_get(&bulk_slab), 5);
+
+	/* Only what is left is allocated */
+	zassert_equal(k_mem_slab_alloc_bulk(&bulk_slab, &blocks[5], 5), 3);
+	zassert_equal(k_mem_slab_num_free_get(&bulk_slab), 0);
+	zassert_equal(k_mem_slab_alloc(&bulk_slab, &block, K_NO_WAIT), -ENOMEM);
+
+	for (int i = 0; i < NUM_BLOCKS; i++) {
+		for (int j = i + 1; j < NUM_BLOCKS; j++) {
+			zassert_not_equal(blocks[i], blocks[j], "Block allocated twice");
+		}
+	}
+
+	k_mem_slab_free_bulk(&bulk_slab, blocks, NUM_BLOCKS);
+	zassert_equal(k_mem_slab_num_used_get(&bulk_slab), 0);
+
+	zassert_equal(k_mem_slab_alloc_bulk(&bulk_slab, blocks, NUM_BLOCKS), NUM_BLOCKS);
+	k_mem_slab_free_bulk(&bulk_slab, blocks, NUM_BLOCKS);
+}
+
+ZTEST(mslab_bulk, test_free_bulk_wakes_waiter)
+{
+	void *blocks[NUM_BLOCKS];
+
+	zassert_equal(k_mem_slab_alloc_bulk(&bulk_slab, blocks, NUM_BLOCKS), NUM_BLOCKS);
+
+	start_waiter(&bulk_slab);
+
+	/* The first block goes to the waiter, the others to the slab */
+	k_mem_slab_free_bulk(&bulk_slab, blocks, NUM_BLOCKS);
+	k_thread_join(&waiter_thread, K_FOREVER);
+
+	zassert_ok(waiter_result);
+	zassert_equal(waiter_block, blocks[0]);
+	zassert_equal(k_mem_slab_num_used_get(&bulk_slab), 1);
+
+	k_mem_slab_free(&bulk_slab, waiter_block);
+}
+
+ZTEST(mslab_bulk, test_cpu_cache)
+{
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	void *blocks[NUM_BLOCKS];
+
+	zassert_equal(k_mem_slab_cpu_cache_enable(&cache_slab, cache_slab_cache), -EALREADY);
+
+	/* Blocks held in caches are reclaimed, none is lost */
+	for (int round = 0; round < 3; round++) {
+		for (int i = 0; i < NUM_BLOCKS; i++) {
+			zassert_ok(k_mem_slab_alloc(&cache_slab, &blocks[i], K_NO_WAIT),
+				   "Allocation %d of round %d failed", i, round);
+		}
+
+		zassert_equal(k_mem_slab_alloc(&cache_slab, &blocks[0], K_NO_WAIT), -ENOMEM);
+
+		for (int i = 0; i < NUM_BLOCKS; i++) {
+			k_mem_slab_free(&cache_slab, blocks[i]);
+		}
+	}
+
+	zassert_equal(k_mem_slab_alloc_bulk(&cache_slab, blocks, NUM_BLOCKS), NUM_BLOCKS);
+	k_mem_slab_free_bulk(&cache_slab, blocks, NUM_BLOCKS);
+	zassert_equal(k_mem_slab_num_used_get(&cache_slab), 0);
+#else
+	ztest_test_skip();
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+}
+
+ZTEST(mslab_bulk, test_cpu_cache_wakes_waiter)
+{
+	void *blocks[NUM_BLOCKS];
+
+	for (int i = 0; i < NUM_BLOCKS; i++) {
+		zassert_ok(k_mem_slab_alloc(&cache_slab, &blocks[i], K_NO_WAIT));
+	}
+
+	start_waiter(&cache_slab);
+
+	/* The block must reach the waiter rather than a cache */
+	k_mem_slab_free(&cache_slab, blocks[0]);
+	k_thread_join(&waiter_thread, K_FOREVER);
+
+	zassert_ok(waiter_result);
+	zassert_equal(waiter_block, blocks[0]);
+
+	k_mem_slab_free(&cache_slab, waiter_block);
+
+	for (int i = 1; i < NUM_BLOCKS; i++) {
+		k_mem_slab_free(&cache_slab, blocks[i]);
+	}
+}
+
+/* Benchmark */
+
+static atomic_t bench_ops;
+
+static void bench_entry(void *p1, void *p2, void *p3)
+{
+	void *blocks[BENCH_BLOCKS / BENCH_THREADS];
+
+	for (int i = 0; i < BENCH_ITERATIONS; i++) {
+		/* Allocate a few blocks per packet, like a packet and its
+		 * fragments, then release them.
+		 */
+		for (int j = 0; j < ARRAY_SIZE(blocks); j++) {
+			zassert_ok(k_mem_slab_alloc(&bench_slab, &blocks[j], K_FOREVER));
+		}
+
+		for (int j = ARRAY_SIZE(blocks) - 1; j >= 0; j--) {
+			k_mem_slab_free(&bench_slab, blocks[j]);
+		}
+	}
+
+	(void)atomic_add(&bench_ops, BENCH_ITERATIONS * ARRAY_SIZE(blocks));
+}
+
+ZTEST(mslab_bulk, test_benchmark)
+{
+	unsigned int num_threads = MIN(BENCH_THREADS, arch_num_cpus() * 2);
+	uint32_t start, cycles;
+
+	atomic_set(&bench_ops, 0);
+
+	start = k_cycle_get_32();
+
+	for (unsigned int i = 0; i < num_threads; i++) {
+		k_thread_create(&bench_threads[i], bench_stacks[i], STACK_SIZE, bench_entry,
+				NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (unsigned int i = 0; i < num_threads; i++) {
+		k_thread_join(&bench_threads[i], K_FOREVER);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	TC_PRINT("%u threads on %u CPUs%s: %u alloc/free pairs/s\n", num_threads,
+		 arch_num_cpus(), IS_ENABLED(CONFIG_MEM_SLAB_CPU_CACHE) ? " with caches" : "",
+		 (uint32_t)((uint64_t)atomic_get(&bench_ops) * NSEC_PER_SEC /
+			    MAX(1, k_cyc_to_ns_floor64(cycles))));
+
+	zassert_equal(k_mem_slab_num_free_get(&bench_slab) +
+		      k_mem_slab_num_used_get(&bench_slab), BENCH_BLOCKS);
+}
+
+static void *mslab_bulk_setup(void)
+{
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	zassert_ok(k_mem_slab_cpu_cache_enable(&cache_slab, cache_slab_cache));
+	zassert_ok(k_mem_slab_cpu_cache_enable(&bench_slab, bench_slab_cache));
+#endif
+
+	return NULL;
+}
+
+ZTEST_SUITE(mslab_bulk, NULL, mslab_bulk_setup, NULL, NULL, NULL);
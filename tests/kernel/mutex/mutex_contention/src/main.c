@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Mutex contention tests and benchmarks
+ *
+ * Several threads, spread over all CPUs on SMP platforms, repeatedly lock
+ * the same mutex around a short critical section. The tests check mutual
+ * exclusion and report the lock throughput, which depends on whether
+ * contended threads spin (CONFIG_MUTEX_ADAPTIVE_SPIN) or pend. The cost of
+ * uncontended lock/unlock pairs is also reported, for sys_mutex from user
+ * mode this shows the effect of CONFIG_SYS_MUTEX_FAST_PATH.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/mutex.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define NUM_THREADS 4
+#define ITERATIONS 2000
+#define CRITICAL_SECTION_LOOPS 50
+#define UNCONTENDED_ITERATIONS 10000
+
+#ifdef CONFIG_USERSPACE
+#define ZTEST_USER_OR_NOT ZTEST_USER
+#else
+#define ZTEST_USER_OR_NOT ZTEST
+#endif
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_THREADS, STACK_SIZE);
+static struct k_thread threads[NUM_THREADS];
+
+static K_MUTEX_DEFINE(contended_mutex);
+static K_MUTEX_DEFINE(uncontended_mutex);
+ZTEST_BMEM SYS_MUTEX_DEFINE(user_mutex);
+
+static volatile uint32_t counter;
+static volatile bool in_critical_section;
+static bool overlap;
+
+static void critical_section(void)
+{
+	uint32_t value = counter;
+
+	if (in_critical_section) {
+		overlap = true;
+	}
+
+	in_critical_section = true;
+
+	for (volatile int i = 0; i < CRITICAL_SECTION_LOOPS; i++) {
+	}
+
+	counter = value + 1;
+	in_critical_section = false;
+}
+
+static void contender(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		zassert_ok(k_mutex_lock(&contended_mutex, K_FOREVER));
+		critical_section();
+		zassert_ok(k_mutex_unlock(&contended_mutex));
+	}
+}
+
+ZTEST(mutex_contention, test_contended_lock)
+{
+	uint32_t start, cycles;
+
+	counter = 0;
+	overlap = false;
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < NUM_THREADS; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, contender,
+				NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < NUM_THREADS; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	zassert_false(overlap, "critical sections overlapped");
+	zassert_equal(counter, NUM_THREADS * ITERATIONS, "lost updates");
+
+	TC_PRINT("%u CPUs, %d threads, adaptive spin %s: %u locks/s\n",
+		 arch_num_cpus(), NUM_THREADS,
+		 IS_ENABLED(CONFIG_MUTEX_ADAPTIVE_SPIN) ? "on" : "off",
+		 (uint32_t)((uint64_t)NUM_THREADS * ITERATIONS * NSEC_PER_SEC /
+			    MAX(1, k_cyc_to_ns_floor64(cycles))));
+}
+
+ZTEST(mutex_contention, test_uncontended_k_mutex)
+{
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < UNCONTENDED_ITERATIONS; i++) {
+		k_mutex_lock(&uncontended_mutex, K_FOREVER);
+		k_mutex_unlock(&uncontended_mutex);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	TC_PRINT("k_mutex lock/unlock: %u ns\n",
+		 (uint32_t)(k_cyc_to_ns_floor64(cycles) / UNCONTENDED_ITERATIONS));
+}
+
+ZTEST_USER_OR_NOT(mutex_contention, test_uncontended_sys_mutex)
+{
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < UNCONTENDED_ITERATIONS; i++) {
+		zassert_ok(sys_mutex_lock(&user_mutex, K_FOREVER));
+		zassert_ok(sys_mutex_unlock(&user_mutex));
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	TC_PRINT("sys_mutex lock/unlock from %s mode, fast path %s: %u ns\n",
+		 k_is_user_context() ? "user" : "supervisor",
+		 IS_ENABLED(CONFIG_SYS_MUTEX_FAST_PATH) ? "on" : "off",
+		 (uint32_t)(k_cyc_to_ns_floor64(cycles) / UNCONTENDED_ITERATIONS));
+}
+
+ZTEST_SUITE(mutex_contention, NULL, NULL, NULL, NULL, NULL);
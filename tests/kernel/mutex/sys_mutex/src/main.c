@@ -67,6 +67,7 @@ static SYS_MUTEX_DEFINE(no_access_mutex);
 #endif
 static ZTEST_BMEM SYS_MUTEX_DEFINE(not_my_mutex);
 static ZTEST_BMEM SYS_MUTEX_DEFINE(bad_count_mutex);
+static ZTEST_BMEM SYS_MUTEX_DEFINE(fast_mutex);
 
 #ifdef CONFIG_USERSPACE
 #define ZTEST_USER_OR_NOT ZTEST_USER
@@ -470,15 +471,164 @@ ZTEST_USER_OR_NOT(mutex_complex, test_user_access)
 #ifdef CONFIG_USERSPACE
 	int rv;
 
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	/* The fast path accesses the mutex memory directly, which faults,
+	 * check the system calls it falls back to instead.
+	 */
+	rv = z_sys_mutex_kernel_lock(&no_access_mutex, K_NO_WAIT);
+	zassert_true(rv == -EACCES, "accessed mutex not in memory domain");
+	rv = z_sys_mutex_kernel_unlock(&no_access_mutex);
+	zassert_true(rv == -EACCES, "accessed mutex not in memory domain");
+#else
 	rv = sys_mutex_lock(&no_access_mutex, K_NO_WAIT);
 	zassert_true(rv == -EACCES, "accessed mutex not in memory domain");
 	rv = sys_mutex_unlock(&no_access_mutex);
 	zassert_true(rv == -EACCES, "accessed mutex not in memory domain");
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
 #else
 	ztest_test_skip();
 #endif /* CONFIG_USERSPACE */
 }
 
+ZTEST_USER_OR_NOT(mutex_complex, test_fast_path)
+{
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	atomic_val_t self = (atomic_val_t)k_current_get();
+
+	zassert_ok(sys_mutex_lock(&fast_mutex, K_NO_WAIT));
+	zassert_equal(atomic_get(&fast_mutex.val), self,
+		      "uncontended mutex not locked with atomic ops");
+
+	zassert_ok(sys_mutex_lock(&fast_mutex, K_NO_WAIT));
+	zassert_equal(atomic_get(&fast_mutex.val), self | Z_SYS_MUTEX_KERNEL,
+		      "recursive lock not handed over to the kernel");
+
+	zassert_ok(sys_mutex_unlock(&fast_mutex));
+	zassert_ok(sys_mutex_unlock(&fast_mutex));
+	zassert_equal(atomic_get(&fast_mutex.val), 0, "mutex not released");
+	zassert_equal(sys_mutex_unlock(&fast_mutex), -EINVAL);
+
+	/* Back to the fast path once released by the kernel */
+	zassert_ok(sys_mutex_lock(&fast_mutex, K_NO_WAIT));
+	zassert_equal(atomic_get(&fast_mutex.val), self);
+	zassert_ok(sys_mutex_unlock(&fast_mutex));
+#else
+	ztest_test_skip();
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
+}
+
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+static K_THREAD_STACK_DEFINE(forger_stack, STACKSIZE);
+static struct k_thread forger_thread;
+static K_THREAD_STACK_DEFINE(forged_owner_stack, STACKSIZE);
+static struct k_thread forged_owner_thread;
+static ZTEST_BMEM SYS_MUTEX_DEFINE(forged_mutex);
+static ZTEST_BMEM int forger_rv;
+
+static void forged_owner(void *p1, void *p2, void *p3)
+{
+}
+
+static void forger(void *p1, void *p2, void *p3)
+{
+	/* Pretend that a thread this one has no permission on holds the
+	 * mutex, to get it boosted to our priority.
+	 */
+	atomic_set(&forged_mutex.val, (atomic_val_t)&forged_owner_thread);
+
+	forger_rv = sys_mutex_lock(&forged_mutex, K_MSEC(200));
+}
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
+
+ZTEST(mutex_complex, test_forged_owner)
+{
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	int prio = K_LOWEST_APPLICATION_THREAD_PRIO;
+
+	k_thread_create(&forged_owner_thread, forged_owner_stack,
+			K_THREAD_STACK_SIZEOF(forged_owner_stack), forged_owner,
+			NULL, NULL, NULL, prio, 0, K_FOREVER);
+	k_thread_create(&forger_thread, forger_stack,
+			K_THREAD_STACK_SIZEOF(forger_stack), forger,
+			NULL, NULL, NULL, 5, K_USER | K_INHERIT_PERMS, K_NO_WAIT);
+
+	k_msleep(100);
+	zassert_equal(atomic_get(&forged_mutex.val),
+		      (atomic_val_t)&forged_owner_thread | Z_SYS_MUTEX_KERNEL,
+		      "forged owner not marked");
+	zassert_equal(k_thread_priority_get(&forged_owner_thread), prio,
+		      "forged owner priority boosted");
+
+	k_thread_join(&forger_thread, K_FOREVER);
+	zassert_equal(forger_rv, -EAGAIN, "forged mutex locked");
+	zassert_equal(k_thread_priority_get(&forged_owner_thread), prio,
+		      "forged owner priority changed");
+
+	k_thread_abort(&forged_owner_thread);
+#else
+	ztest_test_skip();
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
+}
+
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+static K_THREAD_STACK_DEFINE(boosted_owner_stack, STACKSIZE);
+static struct k_thread boosted_owner_thread;
+static K_THREAD_STACK_DEFINE(booster_stack, STACKSIZE);
+static struct k_thread booster_thread;
+static ZTEST_BMEM SYS_MUTEX_DEFINE(boost_mutex);
+static ZTEST_BMEM int boosted_prio;
+static ZTEST_BMEM int restored_prio;
+static ZTEST_BMEM int boosted_owner_rv;
+
+static void boosted_owner(void *p1, void *p2, void *p3)
+{
+	zassert_ok(sys_mutex_lock(&boost_mutex, K_NO_WAIT));
+
+	/* Let the booster wait on the mutex */
+	k_msleep(100);
+	boosted_prio = k_thread_priority_get(k_current_get());
+
+	/* Try to keep the inherited priority, the kernel must not trust
+	 * anything but the owner in the state word.
+	 */
+	atomic_or(&boost_mutex.val, BIT(1));
+
+	boosted_owner_rv = sys_mutex_unlock(&boost_mutex);
+	restored_prio = k_thread_priority_get(k_current_get());
+}
+
+static void booster(void *p1, void *p2, void *p3)
+{
+	zassert_ok(sys_mutex_lock(&boost_mutex, K_FOREVER));
+	zassert_ok(sys_mutex_unlock(&boost_mutex));
+}
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
+
+ZTEST(mutex_complex, test_boosted_owner_restored)
+{
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	int prio = 10;
+
+	k_thread_create(&boosted_owner_thread, boosted_owner_stack,
+			K_THREAD_STACK_SIZEOF(boosted_owner_stack),
+			boosted_owner, NULL, NULL, NULL, prio,
+			K_USER | K_INHERIT_PERMS, K_NO_WAIT);
+	k_thread_create(&booster_thread, booster_stack,
+			K_THREAD_STACK_SIZEOF(booster_stack), booster,
+			NULL, NULL, NULL, 5, 0, K_MSEC(20));
+
+	k_thread_join(&boosted_owner_thread, K_FOREVER);
+	k_thread_join(&booster_thread, K_FOREVER);
+
+	zassert_equal(boosted_prio, 5, "owner priority not boosted");
+	zassert_ok(boosted_owner_rv, "boosted owner failed to unlock");
+	zassert_equal(restored_prio, prio, "owner priority not restored");
+	zassert_equal(atomic_get(&boost_mutex.val), 0, "mutex not released");
+#else
+	ztest_test_skip();
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
+}
+
 /*test case main entry*/
 static void *sys_mutex_tests_setup(void)
 {
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Read-side cost of the synchronization primitives suitable for a table
+ * that is read far more often than it is updated, with one reader thread
+ * per CPU.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/rcu.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define MAX_READERS CONFIG_MP_MAX_NUM_CPUS
+#define READ_ITERATIONS 10000
+
+enum bench_lock {
+	BENCH_MUTEX,
+	BENCH_RWLOCK,
+	BENCH_RCU,
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(bench_stacks, MAX_READERS, STACK_SIZE);
+static struct k_thread bench_threads[MAX_READERS];
+
+static K_MUTEX_DEFINE(bench_mutex);
+K_RWLOCK_DEFINE(bench_rwlock);
+static SYS_RCU_DEFINE(bench_rcu);
+
+static uint32_t table[16];
+static atomic_ptr_t table_ptr = ATOMIC_PTR_INIT(table);
+static atomic_t sink;
+
+static void bench_reader(void *p1, void *p2, void *p3)
+{
+	enum bench_lock type = POINTER_TO_INT(p1);
+	uint32_t sum = 0;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < READ_ITERATIONS; i++) {
+		int idx;
+
+		switch (type) {
+		case BENCH_MUTEX:
+			k_mutex_lock(&bench_mutex, K_FOREVER);
+			sum += table[i % ARRAY_SIZE(table)];
+			k_mutex_unlock(&bench_mutex);
+			break;
+		case BENCH_RWLOCK:
+			k_rwlock_read_lock(&bench_rwlock, K_FOREVER);
+			sum += table[i % ARRAY_SIZE(table)];
+			k_rwlock_read_unlock(&bench_rwlock);
+			break;
+		case BENCH_RCU:
+			idx = sys_rcu_read_lock(&bench_rcu);
+			sum += ((uint32_t *)sys_rcu_dereference(&table_ptr))[i % ARRAY_SIZE(table)];
+			sys_rcu_read_unlock(&bench_rcu, idx);
+			break;
+		}
+	}
+
+	atomic_add(&sink, sum);
+}
+
+static uint32_t run_readers(enum bench_lock type)
+{
+	unsigned int num_readers = arch_num_cpus();
+	uint32_t start = k_cycle_get_32();
+
+	for (unsigned int i = 0; i < num_readers; i++) {
+		k_thread_create(&bench_threads[i], bench_stacks[i], STACK_SIZE, bench_reader,
+				INT_TO_POINTER(type), NULL, NULL, K_PRIO_PREEMPT(5), 0,
+				K_NO_WAIT);
+	}
+
+	for (unsigned int i = 0; i < num_readers; i++) {
+		k_thread_join(&bench_threads[i], K_FOREVER);
+	}
+
+	return k_cyc_to_ns_floor64(k_cycle_get_32() - start) /
+	       (num_readers * READ_ITERATIONS);
+}
+
+ZTEST(rwlock_bench, test_read_side_cost)
+{
+	TC_PRINT("%u reader threads, read-side cost per lookup:\n", arch_num_cpus());
+	TC_PRINT(" k_mutex:  %u ns\n", run_readers(BENCH_MUTEX));
+	TC_PRINT(" k_rwlock: %u ns\n", run_readers(BENCH_RWLOCK));
+	TC_PRINT(" sys_rcu:  %u ns\n", run_readers(BENCH_RCU));
+}
+
+ZTEST_SUITE(rwlock_bench, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/rcu.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define NUM_HELPERS 3
+#define HELPER_PRIO K_PRIO_PREEMPT(5)
+
+enum {
+	READ,
+	WRITE,
+};
+
+struct helper {
+	struct k_thread thread;
+	int op;
+	k_timeout_t timeout;
+	int hold_ms;
+	int ret;
+	int order;
+	int prio_after;
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_HELPERS, STACK_SIZE);
+static struct helper helpers[NUM_HELPERS];
+static atomic_t order;
+
+K_RWLOCK_DEFINE(rwlock);
+K_RWLOCK_DEFINE(user_rwlock);
+
+static void helper_fn(void *p1, void *p2, void *p3)
+{
+	struct helper *h = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	h->ret = (h->op == READ) ? k_rwlock_read_lock(&rwlock, h->timeout) :
+				   k_rwlock_write_lock(&rwlock, h->timeout);
+	if (h->ret != 0) {
+		return;
+	}
+
+	h->order = atomic_inc(&order);
+	k_msleep(h->hold_ms);
+
+	if (h->op == READ) {
+		zassert_ok(k_rwlock_read_unlock(&rwlock));
+	} else {
+		zassert_ok(k_rwlock_write_unlock(&rwlock));
+	}
+
+	h->prio_after = k_thread_priority_get(k_current_get());
+}
+
+static void helper_start(int i, int op, k_timeout_t timeout, int hold_ms, int prio)
+{
+	struct helper *h = &helpers[i];
+
+	h->op = op;
+	h->timeout = timeout;
+	h->hold_ms = hold_ms;
+	h->ret = 1;
+	h->order = -1;
+
+	k_thread_create(&h->thread, stacks[i], STACK_SIZE, helper_fn, h, NULL, NULL,
+			prio, 0, K_NO_WAIT);
+}
+
+static void helper_join(int i)
+{
+	zassert_ok(k_thread_join(&helpers[i].thread, K_SECONDS(1)),
+		   "helper %d did not complete", i);
+}
+
+ZTEST(rwlock, test_concurrent_readers)
+{
+	zassert_ok(k_rwlock_read_lock(&rwlock, K_NO_WAIT));
+
+	helper_start(0, READ, K_NO_WAIT, 0, HELPER_PRIO);
+	helper_join(0);
+	zassert_ok(helpers[0].ret, "readers should share the lock");
+
+	zassert_ok(k_rwlock_read_unlock(&rwlock));
+}
+
+ZTEST(rwlock, test_writer_exclusive)
+{
+	zassert_ok(k_rwlock_write_lock(&rwlock, K_NO_WAIT));
+
+	helper_start(0, READ, K_NO_WAIT, 0, HELPER_PRIO);
+	helper_start(1, WRITE, K_NO_WAIT, 0, HELPER_PRIO);
+	helper_join(0);
+	helper_join(1);
+	zassert_equal(helpers[0].ret, -EBUSY);
+	zassert_equal(helpers[1].ret, -EBUSY);
+
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_NO_WAIT), -EDEADLK);
+	zassert_equal(k_rwlock_read_lock(&rwlock, K_NO_WAIT), -EBUSY);
+
+	zassert_ok(k_rwlock_write_unlock(&rwlock));
+}
+
+ZTEST(rwlock, test_writer_preference)
+{
+	zassert_ok(k_rwlock_read_lock(&rwlock, K_NO_WAIT));
+
+	helper_start(0, WRITE, K_FOREVER, 10, HELPER_PRIO);
+	k_msleep(20);
+
+	/* A waiting writer keeps new readers out */
+	helper_start(1, READ, K_NO_WAIT, 0, HELPER_PRIO);
+	helper_join(1);
+	zassert_equal(helpers[1].ret, -EBUSY);
+
+	zassert_ok(k_rwlock_read_unlock(&rwlock));
+	helper_join(0);
+	zassert_ok(helpers[0].ret);
+}
+
+ZTEST(rwlock, test_readers_before_next_writer)
+{
+	atomic_set(&order, 0);
+
+	zassert_ok(k_rwlock_write_lock(&rwlock, K_NO_WAIT));
+
+	/* The writer has the highest priority, yet waiting readers go
+	 * first so that they are not starved.
+	 */
+	helper_start(0, WRITE, K_FOREVER, 0, HELPER_PRIO - 1);
+	helper_start(1, READ, K_FOREVER, 10, HELPER_PRIO);
+	helper_start(2, READ, K_FOREVER, 10, HELPER_PRIO);
+	k_msleep(20);
+
+	zassert_ok(k_rwlock_write_unlock(&rwlock));
+
+	for (int i = 0; i < 3; i++) {
+		helper_join(i);
+		zassert_ok(helpers[i].ret);
+	}
+
+	zassert_equal(helpers[0].order, 2, "writer got the lock before readers");
+}
+
+ZTEST(rwlock, test_writer_timeout_admits_readers)
+{
+	zassert_ok(k_rwlock_read_lock(&rwlock, K_NO_WAIT));
+
+	helper_start(0, WRITE, K_MSEC(50), 0, HELPER_PRIO);
+	k_msleep(10);
+	helper_start(1, READ, K_FOREVER, 0, HELPER_PRIO);
+	k_msleep(100);
+
+	helper_join(0);
+	zassert_equal(helpers[0].ret, -EAGAIN);
+
+	/* The reader was only held back by the writer */
+	helper_join(1);
+	zassert_ok(helpers[1].ret);
+
+	zassert_ok(k_rwlock_read_unlock(&rwlock));
+}
+
+ZTEST(rwlock, test_priority_inheritance)
+{
+	int low = K_PRIO_PREEMPT(10);
+	int high = K_PRIO_PREEMPT(2);
+
+	helper_start(0, WRITE, K_FOREVER, 100, low);
+	k_msleep(10);
+	zassert_ok(helpers[0].ret);
+
+	helper_start(1, READ, K_FOREVER, 0, high);
+	k_msleep(10);
+
+	zassert_equal(k_thread_priority_get(&helpers[0].thread), high,
+		      "writer not boosted by waiting reader");
+
+	helper_join(0);
+	helper_join(1);
+	zassert_ok(helpers[1].ret);
+	zassert_equal(helpers[0].prio_after, low, "writer priority not restored");
+}
+
+ZTEST(rwlock, test_errors)
+{
+	zassert_equal(k_rwlock_read_unlock(&rwlock), -EINVAL);
+	zassert_equal(k_rwlock_write_unlock(&rwlock), -EINVAL);
+
+	helper_start(0, WRITE, K_NO_WAIT, 50, HELPER_PRIO);
+	k_msleep(10);
+	zassert_equal(k_rwlock_write_unlock(&rwlock), -EPERM);
+	helper_join(0);
+}
+
+ZTEST_USER(rwlock, test_user_mode)
+{
+	zassert_ok(k_rwlock_init(&user_rwlock));
+	zassert_ok(k_rwlock_read_lock(&user_rwlock, K_NO_WAIT));
+	zassert_ok(k_rwlock_read_lock(&user_rwlock, K_NO_WAIT));
+	zassert_equal(k_rwlock_write_lock(&user_rwlock, K_NO_WAIT), -EBUSY);
+	zassert_ok(k_rwlock_read_unlock(&user_rwlock));
+	zassert_ok(k_rwlock_read_unlock(&user_rwlock));
+	zassert_ok(k_rwlock_write_lock(&user_rwlock, K_NO_WAIT));
+	zassert_ok(k_rwlock_write_unlock(&user_rwlock));
+}
+
+/* Read-mostly helper */
+
+#define RCU_MAGIC_VALID 0x600dda7a
+#define RCU_MAGIC_FREED 0xdeadbeef
+#define RCU_READER_LOOPS 2000
+#define RCU_UPDATES 20
+
+struct rcu_table {
+	uint32_t magic;
+	uint32_t generation;
+};
+
+static SYS_RCU_DEFINE(rcu);
+static struct rcu_table tables[2];
+static atomic_ptr_t current_table;
+static atomic_t rcu_errors;
+
+static void rcu_reader(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < RCU_READER_LOOPS; i++) {
+		int idx = sys_rcu_read_lock(&rcu);
+		struct rcu_table *table = sys_rcu_dereference(&current_table);
+
+		if (table->magic != RCU_MAGIC_VALID) {
+			atomic_inc(&rcu_errors);
+		}
+
+		k_busy_wait(5);
+
+		if (table->magic != RCU_MAGIC_VALID) {
+			atomic_inc(&rcu_errors);
+		}
+
+		sys_rcu_read_unlock(&rcu, idx);
+
+		if ((i % 100) == 0) {
+			k_yield();
+		}
+	}
+}
+
+ZTEST(rwlock, test_rcu_update)
+{
+	struct rcu_table *old;
+
+	tables[0].magic = RCU_MAGIC_VALID;
+	tables[1].magic = RCU_MAGIC_FREED;
+	atomic_ptr_set(&current_table, &tables[0]);
+	atomic_set(&rcu_errors, 0);
+
+	for (int i = 0; i < NUM_HELPERS; i++) {
+		k_thread_create(&helpers[i].thread, stacks[i], STACK_SIZE, rcu_reader,
+				NULL, NULL, NULL, HELPER_PRIO, 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < RCU_UPDATES; i++) {
+		struct rcu_table *next = &tables[(i + 1) % 2];
+
+		next->generation = i;
+		next->magic = RCU_MAGIC_VALID;
+
+		old = sys_rcu_assign_pointer(&current_table, next);
+		sys_rcu_synchronize(&rcu);
+
+		/* No reader may still see the previous table */
+		old->magic = RCU_MAGIC_FREED;
+		k_msleep(1);
+	}
+
+	for (int i = 0; i < NUM_HELPERS; i++) {
+		zassert_ok(k_thread_join(&helpers[i].thread, K_FOREVER));
+	}
+
+	zassert_equal(atomic_get(&rcu_errors), 0, "reader saw released data");
+}
+
+static void rcu_long_reader(void *p1, void *p2, void *p3)
+{
+	int idx = sys_rcu_read_lock(&rcu);
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_msleep(50);
+	sys_rcu_read_unlock(&rcu, idx);
+}
+
+ZTEST(rwlock, test_rcu_synchronize_waits)
+{
+	int64_t start;
+
+	k_thread_create(&helpers[0].thread, stacks[0], STACK_SIZE, rcu_long_reader,
+			NULL, NULL, NULL, HELPER_PRIO, 0, K_NO_WAIT);
+	k_msleep(10);
+
+	start = k_uptime_get();
+	sys_rcu_synchronize(&rcu);
+	zassert_true(k_uptime_get() - start >= 30, "did not wait for the reader");
+
+	helper_join(0);
+
+	/* Without readers, synchronizing does not wait */
+	start = k_uptime_get();
+	sys_rcu_synchronize(&rcu);
+	zassert_true(k_uptime_get() - start < 10);
+}
+
+static void *rwlock_setup(void)
+{
+#ifdef CONFIG_USERSPACE
+	k_object_access_grant(&user_rwlock, k_current_get());
+#endif
+
+	return NULL;
+}
+
+ZTEST_SUITE(rwlock, NULL, rwlock_setup, NULL, NULL, NULL);
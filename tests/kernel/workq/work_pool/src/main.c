@@ -0,0 +1,354 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define WORKQ_PRIORITY K_PRIO_PREEMPT(1)
+#define POOL_THREADS 3
+#define NUM_ITEMS (POOL_THREADS + 1)
+#define ITEM_SLEEP_MS 50
+
+#define BENCH_ITEMS 64
+#define BENCH_ROUNDS 50
+
+static K_THREAD_STACK_DEFINE(single_stack, STACK_SIZE);
+static struct k_work_q single_queue;
+
+static K_THREAD_STACK_DEFINE(pool_stack, STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(pool_stacks, POOL_THREADS, STACK_SIZE);
+static struct k_work_q_thread pool_threads[POOL_THREADS];
+static struct k_work_q pool_queue;
+
+static struct k_work items[NUM_ITEMS];
+static struct k_work_delayable ditem;
+
+/* Work synchronization objects must be in cache-coherent memory,
+ * which excludes stacks on some architectures.
+ */
+static struct k_work_sync work_sync;
+
+static atomic_t completed;
+static atomic_t running;
+static atomic_t max_running;
+static atomic_t resubmits;
+
+static K_SEM_DEFINE(release_sem, 0, NUM_ITEMS);
+
+static void release_timer_expiry(struct k_timer *timer)
+{
+	k_sem_give(&release_sem);
+}
+
+static K_TIMER_DEFINE(release_timer, release_timer_expiry, NULL);
+
+static void track_running_start(void)
+{
+	atomic_val_t now = atomic_inc(&running) + 1;
+	atomic_val_t max = atomic_get(&max_running);
+
+	while ((now > max) && !atomic_cas(&max_running, max, now)) {
+		max = atomic_get(&max_running);
+	}
+}
+
+static void sleep_handler(struct k_work *work)
+{
+	track_running_start();
+	k_msleep(ITEM_SLEEP_MS);
+	atomic_dec(&running);
+	atomic_inc(&completed);
+}
+
+static void blocking_handler(struct k_work *work)
+{
+	k_sem_take(&release_sem, K_FOREVER);
+	atomic_inc(&completed);
+}
+
+static void resubmit_handler(struct k_work *work)
+{
+	track_running_start();
+
+	if (atomic_dec(&resubmits) > 0) {
+		/* Resubmit while running: another thread of the pool must
+		 * not pick the item up before this invocation completes.
+		 */
+		zassert_equal(k_work_submit_to_queue(&pool_queue, work), 2);
+	}
+
+	k_msleep(1);
+	atomic_dec(&running);
+	atomic_inc(&completed);
+}
+
+/* Queue the items of current_handler() are submitted to */
+static struct k_work_q *current_queue;
+static atomic_t not_current;
+
+static void current_handler(struct k_work *work)
+{
+	track_running_start();
+
+	if (!k_work_queue_is_current(current_queue) ||
+	    k_work_queue_is_current(&single_queue)) {
+		atomic_inc(&not_current);
+	}
+
+	k_msleep(ITEM_SLEEP_MS);
+	atomic_dec(&running);
+	atomic_inc(&completed);
+}
+
+static void reset_counters(void)
+{
+	atomic_set(&completed, 0);
+	atomic_set(&running, 0);
+	atomic_set(&max_running, 0);
+	atomic_set(&not_current, 0);
+	k_sem_reset(&release_sem);
+}
+
+/* Runs items on all the threads of a queue at once, checking that each of
+ * them is seen as a thread of the queue.
+ */
+static void check_queue_is_current(struct k_work_q *queue, int threads)
+{
+	reset_counters();
+	current_queue = queue;
+
+	for (int i = 0; i < threads; i++) {
+		k_work_init(&items[i], current_handler);
+		zassert_equal(k_work_submit_to_queue(queue, &items[i]), 1);
+	}
+
+	zassert_true(k_work_queue_drain(queue, false) >= 0);
+
+	zassert_equal(atomic_get(&completed), threads);
+	zassert_equal(atomic_get(&max_running), threads,
+		      "Items were not processed in parallel");
+	zassert_equal(atomic_get(&not_current), 0,
+		      "Thread of the queue not seen as current");
+	zassert_false(k_work_queue_is_current(queue));
+}
+
+ZTEST(work_pool, test_thread_add_unstarted)
+{
+	static struct k_work_q unstarted;
+	static struct k_work_q_thread wthread;
+
+	k_work_queue_init(&unstarted);
+
+	zassert_equal(k_work_queue_thread_add(&unstarted, &wthread, pool_stacks[0],
+					      K_THREAD_STACK_SIZEOF(pool_stacks[0]),
+					      WORKQ_PRIORITY, -1),
+		      -ENODEV);
+}
+
+ZTEST(work_pool, test_parallel_items)
+{
+	int64_t start = k_uptime_get();
+
+	reset_counters();
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		k_work_init(&items[i], sleep_handler);
+		zassert_equal(k_work_submit_to_queue(&pool_queue, &items[i]), 1);
+	}
+
+	zassert_true(k_work_queue_drain(&pool_queue, false) >= 0);
+
+	zassert_equal(atomic_get(&completed), NUM_ITEMS);
+	zassert_equal(atomic_get(&max_running), NUM_ITEMS,
+		      "Items were not processed in parallel");
+	zassert_true(k_uptime_get() - start < NUM_ITEMS * ITEM_SLEEP_MS);
+}
+
+ZTEST(work_pool, test_no_reentrancy)
+{
+	reset_counters();
+	atomic_set(&resubmits, 10);
+
+	k_work_init(&items[0], resubmit_handler);
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &items[0]), 1);
+
+	zassert_true(k_work_queue_drain(&pool_queue, false) >= 0);
+
+	zassert_equal(atomic_get(&completed), 11);
+	zassert_equal(atomic_get(&max_running), 1, "Handler was re-entered");
+}
+
+ZTEST(work_pool, test_running_flush)
+{
+	reset_counters();
+
+	k_work_init(&items[0], blocking_handler);
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &items[0]), 1);
+
+	/* Let the item start, then release it a bit later. */
+	k_msleep(10);
+	zassert_equal(k_work_busy_get(&items[0]), K_WORK_RUNNING);
+
+	k_timer_start(&release_timer, K_MSEC(20), K_NO_WAIT);
+
+	/* The flusher may be picked by an idle thread of the pool, but must
+	 * not complete before the item does.
+	 */
+	zassert_true(k_work_flush(&items[0], &work_sync));
+	zassert_equal(atomic_get(&completed), 1);
+	zassert_equal(k_work_busy_get(&items[0]), 0);
+}
+
+ZTEST(work_pool, test_running_cancel_sync)
+{
+	reset_counters();
+
+	k_work_init(&items[0], blocking_handler);
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &items[0]), 1);
+
+	k_msleep(10);
+	zassert_equal(k_work_busy_get(&items[0]), K_WORK_RUNNING);
+
+	k_timer_start(&release_timer, K_MSEC(20), K_NO_WAIT);
+
+	zassert_true(k_work_cancel_sync(&items[0], &work_sync));
+	zassert_equal(atomic_get(&completed), 1);
+	zassert_equal(k_work_busy_get(&items[0]), 0);
+}
+
+ZTEST(work_pool, test_delayable)
+{
+	reset_counters();
+
+	k_work_init_delayable(&ditem, sleep_handler);
+	zassert_equal(k_work_schedule_for_queue(&pool_queue, &ditem, K_MSEC(10)), 1);
+
+	zassert_true(k_work_flush_delayable(&ditem, &work_sync));
+	zassert_equal(atomic_get(&completed), 1);
+}
+
+ZTEST(work_pool, test_drain_waits_for_all_threads)
+{
+	reset_counters();
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		k_work_init(&items[i], sleep_handler);
+		zassert_equal(k_work_submit_to_queue(&pool_queue, &items[i]), 1);
+	}
+
+	/* Draining must not complete while any of the threads is still
+	 * processing an item.
+	 */
+	zassert_equal(k_work_queue_drain(&pool_queue, true), 1);
+	zassert_equal(atomic_get(&completed), NUM_ITEMS);
+
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &items[0]), -EBUSY);
+	zassert_ok(k_work_queue_unplug(&pool_queue));
+}
+
+ZTEST(work_pool, test_is_current)
+{
+	check_queue_is_current(&pool_queue, POOL_THREADS + 1);
+}
+
+BUILD_ASSERT(CONFIG_SYSTEM_WORKQUEUE_POOL_THREADS < NUM_ITEMS);
+
+ZTEST(work_pool, test_sys_work_q_pool)
+{
+	if (CONFIG_SYSTEM_WORKQUEUE_POOL_THREADS == 0) {
+		ztest_test_skip();
+	}
+
+	check_queue_is_current(&k_sys_work_q, CONFIG_SYSTEM_WORKQUEUE_POOL_THREADS + 1);
+}
+
+/* Benchmark */
+
+static uint32_t submit_cycles[BENCH_ITEMS];
+static uint64_t latency_total;
+static uint32_t latency_max;
+static struct k_work bench_items[BENCH_ITEMS];
+
+static void bench_handler(struct k_work *work)
+{
+	uint32_t delta = k_cycle_get_32() - submit_cycles[ARRAY_INDEX(bench_items, work)];
+	unsigned int key = irq_lock();
+
+	latency_total += delta;
+	latency_max = MAX(latency_max, delta);
+
+	irq_unlock(key);
+}
+
+static void run_benchmark(struct k_work_q *queue, const char *name)
+{
+	uint32_t start, cycles;
+
+	latency_total = 0;
+	latency_max = 0;
+
+	for (int i = 0; i < BENCH_ITEMS; i++) {
+		k_work_init(&bench_items[i], bench_handler);
+	}
+
+	start = k_cycle_get_32();
+
+	for (int round = 0; round < BENCH_ROUNDS; round++) {
+		for (int i = 0; i < BENCH_ITEMS; i++) {
+			submit_cycles[i] = k_cycle_get_32();
+			(void)k_work_submit_to_queue(queue, &bench_items[i]);
+		}
+
+		(void)k_work_queue_drain(queue, false);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	TC_PRINT("%s: %u items/s, submit->run latency avg %u ns max %u ns\n", name,
+		 (uint32_t)((uint64_t)BENCH_ITEMS * BENCH_ROUNDS * NSEC_PER_SEC /
+			    MAX(1, k_cyc_to_ns_floor64(cycles))),
+		 (uint32_t)k_cyc_to_ns_floor64(latency_total / (BENCH_ITEMS * BENCH_ROUNDS)),
+		 (uint32_t)k_cyc_to_ns_floor64(latency_max));
+}
+
+ZTEST(work_pool, test_benchmark)
+{
+	run_benchmark(&single_queue, "single thread queue");
+	run_benchmark(&pool_queue, "pooled queue");
+}
+
+static void *work_pool_setup(void)
+{
+	struct k_work_queue_config cfg = {
+		.name = "pool",
+	};
+
+	k_work_queue_init(&single_queue);
+	k_work_queue_start(&single_queue, single_stack, K_THREAD_STACK_SIZEOF(single_stack),
+			   WORKQ_PRIORITY, NULL);
+
+	k_work_queue_init(&pool_queue);
+	k_work_queue_start(&pool_queue, pool_stack, K_THREAD_STACK_SIZEOF(pool_stack),
+			   WORKQ_PRIORITY, &cfg);
+
+	for (int i = 0; i < POOL_THREADS; i++) {
+		int cpu = -1;
+
+#ifdef CONFIG_SCHED_CPU_MASK
+		cpu = (i + 1) % arch_num_cpus();
+#endif
+
+		zassert_ok(k_work_queue_thread_add(&pool_queue, &pool_threads[i],
+						   pool_stacks[i],
+						   K_THREAD_STACK_SIZEOF(pool_stacks[i]),
+						   WORKQ_PRIORITY, cpu));
+	}
+
+	return NULL;
+}
+
+ZTEST_SUITE(work_pool, NULL, work_pool_setup, NULL, NULL, NULL);
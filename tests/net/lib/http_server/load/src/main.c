@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/http/service.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#define MY_IPV4_ADDR        "127.0.0.1"
+#define SERVER_PORT         8080
+#define MAX_CONCURRENCY     4
+#define REQUESTS_PER_CLIENT 20
+#define SLOW_HANDLER_MS     500
+#define CLIENT_STACK_SIZE   2048
+#define CLIENT_PRIORITY     K_PRIO_PREEMPT(5)
+
+static const char fast_request[] =
+	"GET / HTTP/1.1\r\n"
+	"Host: 127.0.0.1:8080\r\n"
+	"\r\n";
+
+static const char slow_request[] =
+	"GET /slow HTTP/1.1\r\n"
+	"Host: 127.0.0.1:8080\r\n"
+	"\r\n";
+
+static uint16_t test_http_service_port = SERVER_PORT;
+HTTP_SERVICE_DEFINE(test_http_service, MY_IPV4_ADDR,
+		    &test_http_service_port, 1, 10, NULL);
+
+static const char index_html[] = "Hello, World!";
+static struct http_resource_detail_static index_html_resource_detail = {
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_STATIC,
+			.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+		},
+	.static_data = index_html,
+	.static_data_len = sizeof(index_html) - 1,
+};
+
+HTTP_RESOURCE_DEFINE(index_html_resource, test_http_service, "/",
+		     &index_html_resource_detail);
+
+static int slow_handler(struct http_client_ctx *client, enum http_data_status status,
+			uint8_t *buffer, size_t len, void *user_data)
+{
+	ARG_UNUSED(client);
+	ARG_UNUSED(buffer);
+	ARG_UNUSED(len);
+	ARG_UNUSED(user_data);
+
+	if (status == HTTP_SERVER_DATA_FINAL) {
+		/* Simulate a handler blocking on some slow operation. */
+		k_msleep(SLOW_HANDLER_MS);
+	}
+
+	return 0;
+}
+
+static uint8_t slow_buffer[32];
+static struct http_resource_detail_dynamic slow_resource_detail = {
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+			.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+		},
+	.cb = slow_handler,
+	.data_buffer = slow_buffer,
+	.data_buffer_len = sizeof(slow_buffer),
+};
+
+HTTP_RESOURCE_DEFINE(slow_resource, test_http_service, "/slow",
+		     &slow_resource_detail);
+
+static K_THREAD_STACK_ARRAY_DEFINE(client_stacks, MAX_CONCURRENCY, CLIENT_STACK_SIZE);
+static struct k_thread client_threads[MAX_CONCURRENCY];
+
+/* Request latencies in microseconds, for all clients of a run. */
+static uint32_t latencies[MAX_CONCURRENCY * REQUESTS_PER_CLIENT];
+static atomic_t failures;
+
+static int do_request(const char *request, size_t request_len, uint32_t *latency_us)
+{
+	struct sockaddr_in sa = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	uint8_t buf[128];
+	size_t received = 0;
+	int64_t start;
+	int fd;
+	int ret;
+
+	ret = zsock_inet_pton(AF_INET, MY_IPV4_ADDR, &sa.sin_addr);
+	if (ret != 1) {
+		return -EINVAL;
+	}
+
+	fd = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (fd < 0) {
+		return -errno;
+	}
+
+	start = k_uptime_ticks();
+
+	ret = zsock_connect(fd, (struct sockaddr *)&sa, sizeof(sa));
+	if (ret < 0) {
+		ret = -errno;
+		goto out;
+	}
+
+	ret = zsock_send(fd, request, request_len, 0);
+	if (ret < 0) {
+		ret = -errno;
+		goto out;
+	}
+
+	/* The server closes HTTP/1.1 connections after each response. */
+	do {
+		ret = zsock_recv(fd, buf, sizeof(buf), 0);
+		if (ret < 0) {
+			ret = -errno;
+			goto out;
+		}
+
+		received += ret;
+	} while (ret > 0);
+
+	if (received == 0) {
+		ret = -ENODATA;
+		goto out;
+	}
+
+	if (latency_us != NULL) {
+		*latency_us = k_ticks_to_us_ceil32(k_uptime_ticks() - start);
+	}
+
+out:
+	zsock_close(fd);
+
+	return ret;
+}
+
+static void client_thread(void *p1, void *p2, void *p3)
+{
+	uint32_t *results = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < REQUESTS_PER_CLIENT; i++) {
+		if (do_request(fast_request, sizeof(fast_request) - 1, &results[i]) < 0) {
+			atomic_inc(&failures);
+			results[i] = 0;
+		}
+	}
+}
+
+static int compare_u32(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+static void run_load(int concurrency)
+{
+	size_t count = concurrency * REQUESTS_PER_CLIENT;
+	int64_t start;
+	uint32_t elapsed_ms;
+
+	atomic_set(&failures, 0);
+	memset(latencies, 0, sizeof(latencies));
+
+	start = k_uptime_get();
+
+	for (int i = 0; i < concurrency; i++) {
+		k_thread_create(&client_threads[i], client_stacks[i],
+				K_THREAD_STACK_SIZEOF(client_stacks[i]),
+				client_thread, &latencies[i * REQUESTS_PER_CLIENT],
+				NULL, NULL, CLIENT_PRIORITY, 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < concurrency; i++) {
+		k_thread_join(&client_threads[i], K_FOREVER);
+	}
+
+	elapsed_ms = MAX(1, (uint32_t)(k_uptime_get() - start));
+
+	zassert_equal(atomic_get(&failures), 0, "%ld requests failed",
+		      atomic_get(&failures));
+
+	qsort(latencies, count, sizeof(latencies[0]), compare_u32);
+
+	TC_PRINT("workers %d concurrency %d: %u req/s, latency p50 %u us "
+		 "p99 %u us max %u us\n",
+		 CONFIG_HTTP_SERVER_WORKERS, concurrency,
+		 (uint32_t)(count * MSEC_PER_SEC / elapsed_ms),
+		 latencies[count / 2], latencies[(count * 99) / 100],
+		 latencies[count - 1]);
+}
+
+ZTEST(server_load_tests, test_throughput)
+{
+	for (int concurrency = 1; concurrency <= MAX_CONCURRENCY; concurrency *= 2) {
+		run_load(concurrency);
+	}
+}
+
+static void slow_client_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	if (do_request(slow_request, sizeof(slow_request) - 1, NULL) < 0) {
+		atomic_inc(&failures);
+	}
+}
+
+ZTEST(server_load_tests, test_slow_handler_isolation)
+{
+	uint32_t latency;
+	int ret;
+
+	atomic_set(&failures, 0);
+
+	k_thread_create(&client_threads[0], client_stacks[0],
+			K_THREAD_STACK_SIZEOF(client_stacks[0]),
+			slow_client_thread, NULL, NULL, NULL,
+			CLIENT_PRIORITY, 0, K_NO_WAIT);
+
+	/* Let the slow request reach the resource handler. */
+	k_msleep(SLOW_HANDLER_MS / 5);
+
+	ret = do_request(fast_request, sizeof(fast_request) - 1, &latency);
+	zassert_ok(ret, "Fast request failed (%d)", ret);
+
+	TC_PRINT("workers %d: fast request latency with a blocked handler %u us\n",
+		 CONFIG_HTTP_SERVER_WORKERS, latency);
+
+	k_thread_join(&client_threads[0], K_FOREVER);
+	zassert_equal(atomic_get(&failures), 0, "Slow request failed");
+
+	if (CONFIG_HTTP_SERVER_WORKERS > 1) {
+		zassert_true(latency < SLOW_HANDLER_MS * USEC_PER_MSEC / 2,
+			     "Fast request was blocked by the slow handler");
+	}
+}
+
+static void *setup(void)
+{
+	zassert_ok(http_server_start(), "Failed to start the server");
+
+	return NULL;
+}
+
+static void teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	zassert_ok(http_server_stop(), "Failed to stop the server");
+}
+
+ZTEST_SUITE(server_load_tests, NULL, setup, NULL, NULL, teardown);
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "server_internal.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/http/service.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#define RESOURCE_COUNT CONFIG_TEST_RESOURCE_COUNT
+#define LOOKUP_ITERATIONS 1000
+
+static struct http_resource_detail static_detail = {
+	.type = HTTP_RESOURCE_TYPE_STATIC,
+	.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+};
+
+static struct http_resource_detail wildcard_detail = {
+	.type = HTTP_RESOURCE_TYPE_STATIC,
+	.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+};
+
+static struct http_resource_detail status_detail = {
+	.type = HTTP_RESOURCE_TYPE_STATIC,
+	.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+};
+
+static struct http_resource_detail ws_detail = {
+	.type = HTTP_RESOURCE_TYPE_WEBSOCKET,
+	.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+};
+
+static struct http_resource_detail item_detail[RESOURCE_COUNT];
+
+static uint16_t test_http_service_port = 8080;
+HTTP_SERVICE_DEFINE(test_http_service, "127.0.0.1", &test_http_service_port, 1, 10, NULL);
+
+HTTP_RESOURCE_DEFINE(files_resource, test_http_service, "/files/*", &wildcard_detail);
+HTTP_RESOURCE_DEFINE(status_resource, test_http_service, "/api/v1/*/status", &status_detail);
+HTTP_RESOURCE_DEFINE(ws_resource, test_http_service, "/ws", &ws_detail);
+HTTP_RESOURCE_DEFINE(ws_page_resource, test_http_service, "/ws", &static_detail);
+HTTP_RESOURCE_DEFINE(root_resource, test_http_service, "/", &static_detail);
+
+#define ITEM_RESOURCE_DEFINE(n, _)						\
+	HTTP_RESOURCE_DEFINE(item_resource_##n, test_http_service,		\
+			     "/api/v1/item" STRINGIFY(n), &item_detail[n])
+
+LISTIFY(RESOURCE_COUNT, ITEM_RESOURCE_DEFINE, (;), _);
+
+static struct http_resource_detail *lookup(const char *path, bool is_websocket)
+{
+	int path_len;
+
+	return get_resource_detail(path, &path_len, is_websocket);
+}
+
+ZTEST(http_server_routes, test_exact_match)
+{
+	char path[32];
+
+	zassert_equal_ptr(lookup("/", false), &static_detail);
+	zassert_equal_ptr(lookup("/api/v1/item0", false), &item_detail[0]);
+
+	snprintf(path, sizeof(path), "/api/v1/item%d", RESOURCE_COUNT - 1);
+	zassert_equal_ptr(lookup(path, false), &item_detail[RESOURCE_COUNT - 1]);
+
+	snprintf(path, sizeof(path), "/api/v1/item%d?id=1", RESOURCE_COUNT / 2);
+	zassert_equal_ptr(lookup(path, false), &item_detail[RESOURCE_COUNT / 2],
+			  "Query string should not be part of the path");
+}
+
+ZTEST(http_server_routes, test_no_match)
+{
+	zassert_is_null(lookup("/api/v1/item", false));
+	zassert_is_null(lookup("/api/v1/itemX", false));
+	zassert_is_null(lookup("/api/v2/item0", false));
+	zassert_is_null(lookup("/index.html", false));
+}
+
+ZTEST(http_server_routes, test_websocket)
+{
+	zassert_equal_ptr(lookup("/ws", true), &ws_detail);
+	zassert_equal_ptr(lookup("/ws", false), &static_detail);
+	zassert_is_null(lookup("/", true));
+}
+
+ZTEST(http_server_routes, test_wildcard)
+{
+	zassert_equal_ptr(lookup("/files/image.png", false), &wildcard_detail);
+	zassert_equal_ptr(lookup("/api/v1/item0/status", false), &status_detail);
+	zassert_is_null(lookup("/files/dir/image.png", false),
+			"Wildcard should not match across path separators");
+	zassert_equal_ptr(lookup("/api/v1/item0", false), &item_detail[0],
+			  "Exact match expected");
+}
+
+static uint32_t measure_lookup(const char *path)
+{
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < LOOKUP_ITERATIONS; i++) {
+		(void)lookup(path, false);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	return k_cyc_to_ns_floor64(cycles) / LOOKUP_ITERATIONS;
+}
+
+ZTEST(http_server_routes, test_lookup_benchmark)
+{
+	char last[32];
+
+	snprintf(last, sizeof(last), "/api/v1/item%d", RESOURCE_COUNT - 1);
+
+	TC_PRINT("%d resources, index %s:\n", RESOURCE_COUNT,
+		 IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_INDEX) ? "on" : "off");
+	TC_PRINT(" first resource:    %u ns\n", measure_lookup("/api/v1/item0"));
+	TC_PRINT(" last resource:     %u ns\n", measure_lookup(last));
+	TC_PRINT(" wildcard resource: %u ns\n", measure_lookup("/files/image.png"));
+	TC_PRINT(" no match:          %u ns\n", measure_lookup("/not/found"));
+}
+
+static void *setup(void)
+{
+	/* The index is normally built when the server starts. */
+	http_server_resource_index_init();
+
+	return NULL;
+}
+
+ZTEST_SUITE(http_server_routes, NULL, setup, NULL, NULL, NULL);
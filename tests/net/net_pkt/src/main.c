@@ -1283,4 +1283,57 @@ ZTEST(net_pkt_test_suite, test_net_pkt_shallow_clone_append_buf_2)
 	test_net_pkt_shallow_clone_append_buf(2);
 }
 
+#define BENCH_MAX_THREADS 4
+#define BENCH_PACKETS 2000
+#define BENCH_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_ARRAY_DEFINE(bench_stacks, BENCH_MAX_THREADS, BENCH_STACK_SIZE);
+static struct k_thread bench_threads[BENCH_MAX_THREADS];
+static atomic_t bench_failures;
+
+static void bench_entry(void *p1, void *p2, void *p3)
+{
+	struct net_pkt *pkt;
+
+	for (int i = 0; i < BENCH_PACKETS; i++) {
+		pkt = net_pkt_alloc_with_buffer(eth_if, 64, AF_UNSPEC, 0, K_MSEC(100));
+		if (pkt == NULL) {
+			atomic_inc(&bench_failures);
+			continue;
+		}
+
+		net_pkt_unref(pkt);
+	}
+}
+
+ZTEST(net_pkt_test_suite, test_net_pkt_alloc_rate)
+{
+	unsigned int num_threads = MIN(BENCH_MAX_THREADS, arch_num_cpus());
+	uint32_t start, cycles;
+
+	atomic_set(&bench_failures, 0);
+
+	start = k_cycle_get_32();
+
+	for (unsigned int i = 0; i < num_threads; i++) {
+		k_thread_create(&bench_threads[i], bench_stacks[i],
+				K_THREAD_STACK_SIZEOF(bench_stacks[i]), bench_entry,
+				NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (unsigned int i = 0; i < num_threads; i++) {
+		k_thread_join(&bench_threads[i], K_FOREVER);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	TC_PRINT("%u threads on %u CPUs%s: %u packets/s\n", num_threads,
+		 arch_num_cpus(),
+		 IS_ENABLED(CONFIG_NET_PKT_CPU_CACHE) ? " with packet caches" : "",
+		 (uint32_t)((uint64_t)num_threads * BENCH_PACKETS * NSEC_PER_SEC /
+			    MAX(1, k_cyc_to_ns_floor64(cycles))));
+
+	zassert_equal(atomic_get(&bench_failures), 0, "Packet allocation failed");
+}
+
 ZTEST_SUITE(net_pkt_test_suite, NULL, NULL, NULL, NULL, NULL);
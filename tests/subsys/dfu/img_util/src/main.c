@@ -8,6 +8,13 @@
 #include <zephyr/ztest.h>
 #include <zephyr/storage/flash_map.h>
 #include <zephyr/dfu/flash_img.h>
+#ifdef CONFIG_IMG_PATCH
+#include <zephyr/dfu/flash_img_patch.h>
+#include <zephyr/sys/byteorder.h>
+#endif
+#if defined(CONFIG_IMG_STREAM_IMAGE_CHECK) || defined(CONFIG_IMG_PATCH)
+#include <mbedtls/sha256.h>
+#endif
 
 #define SLOT0_PARTITION		slot0_partition
 #define SLOT1_PARTITION		slot1_partition
@@ -165,4 +172,233 @@ ZTEST(img_util, test_check_flash)
 	flash_area_close(ctx.flash_area);
 }
 
+#ifdef CONFIG_IMG_STREAM_IMAGE_CHECK
+#define WRITTEN_IMAGE_SIZE (64 * 1024)
+
+ZTEST(img_util, test_check_written)
+{
+	static struct flash_img_context ctx;
+	static struct flash_img_context check_ctx;
+	mbedtls_sha256_context sha;
+	uint8_t chunk[256];
+	uint8_t tst_sha[32];
+	struct flash_img_check fic = { tst_sha, WRITTEN_IMAGE_SIZE };
+	int64_t start;
+	uint32_t written_us;
+	uint32_t read_us;
+	int ret;
+
+	ret = flash_img_init_id(&ctx, SLOT1_PARTITION_ID);
+	zassert_true(ret == 0, "Flash img init");
+	ret = flash_area_flatten(ctx.flash_area, 0, ctx.flash_area->fa_size);
+	zassert_true(ret == 0, "Flash erase failure (%d)", ret);
+
+	mbedtls_sha256_init(&sha);
+	zassert_true(mbedtls_sha256_starts(&sha, false) == 0, "SHA start");
+
+	for (uint32_t off = 0U; off < WRITTEN_IMAGE_SIZE; off += sizeof(chunk)) {
+		for (uint32_t i = 0U; i < sizeof(chunk); i++) {
+			chunk[i] = (uint8_t)((off + i) * 7U + (off >> 8));
+		}
+
+		zassert_true(mbedtls_sha256_update(&sha, chunk, sizeof(chunk)) == 0,
+			     "SHA update");
+		ret = flash_img_buffered_write(&ctx, chunk, sizeof(chunk),
+					       off + sizeof(chunk) == WRITTEN_IMAGE_SIZE);
+		zassert_true(ret == 0, "Flash img buffered write (%d)", ret);
+	}
+
+	zassert_true(mbedtls_sha256_finish(&sha, tst_sha) == 0, "SHA finish");
+	mbedtls_sha256_free(&sha);
+
+	ret = flash_img_check_written(NULL, &fic);
+	zassert_true(ret == -EINVAL, "Flash img check written params 1");
+	ret = flash_img_check_written(&ctx, NULL);
+	zassert_true(ret == -EINVAL, "Flash img check written params 2");
+
+	start = k_uptime_ticks();
+	ret = flash_img_check_written(&ctx, &fic);
+	written_us = (uint32_t)k_ticks_to_us_floor64(k_uptime_ticks() - start);
+	zassert_true(ret == 0, "Flash img check written (%d)", ret);
+
+	start = k_uptime_ticks();
+	ret = flash_img_check(&check_ctx, &fic, SLOT1_PARTITION_ID);
+	read_us = (uint32_t)k_ticks_to_us_floor64(k_uptime_ticks() - start);
+	zassert_true(ret == 0, "Flash img check (%d)", ret);
+
+	TC_PRINT("%u bytes checked as written in %u us, read back in %u us\n",
+		 WRITTEN_IMAGE_SIZE, written_us, read_us);
+	zassert_true(written_us < read_us, "Check as written should not read the image");
+
+	fic.clen = WRITTEN_IMAGE_SIZE - 1;
+	ret = flash_img_check_written(&ctx, &fic);
+	zassert_true(ret == -EINVAL, "Flash img check written wrong length");
+
+	fic.clen = WRITTEN_IMAGE_SIZE;
+	tst_sha[0] ^= 0xff;
+	ret = flash_img_check_written(&ctx, &fic);
+	zassert_true(ret == -EILSEQ, "Flash img check written wrong sha");
+}
+#endif
+
+#ifdef CONFIG_IMG_PATCH
+#define PATCH_SOURCE_SIZE	(16 * 1024)
+#define PATCH_CHUNK_SIZE	37
+
+static uint8_t patch_source[PATCH_SOURCE_SIZE];
+static uint8_t patch_target[2 * PATCH_SOURCE_SIZE];
+static uint8_t patch[1024];
+static size_t patch_target_len;
+static size_t patch_len;
+
+static void patch_add_copy(uint32_t off, uint32_t len)
+{
+	patch[patch_len] = 0x01;
+	sys_put_le32(off, &patch[patch_len + 1]);
+	sys_put_le32(len, &patch[patch_len + 5]);
+	patch_len += 9;
+
+	memcpy(&patch_target[patch_target_len], &patch_source[off], len);
+	patch_target_len += len;
+}
+
+static void patch_add_insert(uint32_t len)
+{
+	patch[patch_len] = 0x02;
+	sys_put_le32(len, &patch[patch_len + 1]);
+	patch_len += 5;
+
+	for (uint32_t i = 0U; i < len; i++) {
+		patch_target[patch_target_len] = (uint8_t)(0xa5 ^ i);
+		patch[patch_len++] = patch_target[patch_target_len++];
+	}
+}
+
+/* Builds a patch from slot 0 to an image of the source with changes */
+static void patch_build(void)
+{
+	struct flash_img_patch_header *hdr = (struct flash_img_patch_header *)patch;
+
+	patch_len = sizeof(*hdr);
+	patch_target_len = 0;
+
+	patch_add_copy(0, 4096);
+	patch_add_insert(100);
+	patch_add_copy(6000, 5000);
+	patch_add_insert(PATCH_CHUNK_SIZE);
+	patch_add_copy(2048, 4096);
+	patch_add_copy(12000, PATCH_SOURCE_SIZE - 12000);
+	patch_add_insert(1);
+
+	hdr->magic = sys_cpu_to_le32(FLASH_IMG_PATCH_MAGIC);
+	hdr->source_size = sys_cpu_to_le32(PATCH_SOURCE_SIZE);
+	hdr->target_size = sys_cpu_to_le32(patch_target_len);
+	hdr->reserved = 0;
+	zassert_ok(mbedtls_sha256(patch_source, PATCH_SOURCE_SIZE, hdr->source_sha, 0),
+		   "SHA source");
+	zassert_ok(mbedtls_sha256(patch_target, patch_target_len, hdr->target_sha, 0),
+		   "SHA target");
+}
+
+static int patch_apply(struct flash_img_patch_context *ctx, size_t len)
+{
+	const struct flash_area *fa;
+	size_t chunk;
+	int ret;
+
+	ret = flash_area_open(SLOT1_PARTITION_ID, &fa);
+	zassert_true(ret == 0, "Flash area open");
+	ret = flash_area_flatten(fa, 0, fa->fa_size);
+	zassert_true(ret == 0, "Flash erase failure (%d)", ret);
+	flash_area_close(fa);
+
+	ret = flash_img_patch_init(ctx, SLOT0_PARTITION_ID, SLOT1_PARTITION_ID);
+	zassert_true(ret == 0, "Flash img patch init (%d)", ret);
+
+	for (size_t off = 0; off < len; off += ret) {
+		size_t written = flash_img_patch_bytes_written(ctx);
+
+		chunk = MIN(PATCH_CHUNK_SIZE, len - off);
+		ret = flash_img_patch_write(ctx, &patch[off], chunk, off + chunk == len);
+		if (ret < 0) {
+			return ret;
+		}
+
+		/* Copies are split over calls, the data not processed is given again */
+		zassert_true(flash_img_patch_bytes_written(ctx) - written <=
+			     CONFIG_IMG_PATCH_COPY_MAX_SIZE + chunk,
+			     "Too much data copied at once");
+		zassert_true(ret > 0 || flash_img_patch_bytes_written(ctx) > written,
+			     "No progress");
+	}
+
+	return 0;
+}
+
+ZTEST(img_util, test_patch)
+{
+	static struct flash_img_patch_context ctx;
+	const struct flash_area *fa;
+	uint8_t buf[256];
+	int ret;
+
+	for (uint32_t i = 0U; i < PATCH_SOURCE_SIZE; i++) {
+		patch_source[i] = (uint8_t)(i * 13U + (i >> 9));
+	}
+
+	ret = flash_area_open(SLOT0_PARTITION_ID, &fa);
+	zassert_true(ret == 0, "Flash area open");
+	ret = flash_area_flatten(fa, 0, PATCH_SOURCE_SIZE);
+	zassert_true(ret == 0, "Flash erase failure (%d)", ret);
+	ret = flash_area_write(fa, 0, patch_source, PATCH_SOURCE_SIZE);
+	zassert_true(ret == 0, "Flash write failure (%d)", ret);
+	flash_area_close(fa);
+
+	patch_build();
+	zassert_true(flash_img_patch_is_patch(patch, patch_len), "Patch not recognized");
+	zassert_false(flash_img_patch_is_patch(patch_source, PATCH_SOURCE_SIZE),
+		      "Image recognized as patch");
+
+	ret = patch_apply(&ctx, patch_len);
+	zassert_true(ret == 0, "Flash img patch write (%d)", ret);
+	zassert_equal(flash_img_patch_bytes_written(&ctx), patch_target_len,
+		      "Bytes written");
+
+	ret = flash_area_open(SLOT1_PARTITION_ID, &fa);
+	zassert_true(ret == 0, "Flash area open");
+	for (size_t off = 0; off < patch_target_len; off += sizeof(buf)) {
+		size_t len = MIN(sizeof(buf), patch_target_len - off);
+
+		ret = flash_area_read(fa, off, buf, len);
+		zassert_true(ret == 0, "Flash read failure (%d)", ret);
+		zassert_mem_equal(buf, &patch_target[off], len, "Image mismatch at %zu", off);
+	}
+	flash_area_close(fa);
+
+	TC_PRINT("%zu bytes image written from a %zu bytes patch\n", patch_target_len,
+		 patch_len);
+
+	/* Incomplete patch */
+	ret = patch_apply(&ctx, patch_len - 1);
+	zassert_true(ret == -EINVAL, "Flash img patch incomplete (%d)", ret);
+
+	/* Copy out of the base image */
+	sys_put_le32(PATCH_SOURCE_SIZE - 100, &patch[sizeof(struct flash_img_patch_header) + 1]);
+	ret = patch_apply(&ctx, patch_len);
+	zassert_true(ret == -EINVAL, "Flash img patch copy out of image (%d)", ret);
+
+	/* Patch against another base image */
+	patch_build();
+	patch[offsetof(struct flash_img_patch_header, source_sha)] ^= 0xff;
+	ret = patch_apply(&ctx, patch_len);
+	zassert_true(ret == -EILSEQ, "Flash img patch wrong base image (%d)", ret);
+
+	/* Resulting image not matching its hash */
+	patch_build();
+	patch[offsetof(struct flash_img_patch_header, target_sha)] ^= 0xff;
+	ret = patch_apply(&ctx, patch_len);
+	zassert_true(ret == -EILSEQ, "Flash img patch wrong image (%d)", ret);
+}
+#endif
+
 ZTEST_SUITE(img_util, NULL, NULL, NULL, NULL, NULL);
@@ -28,6 +28,7 @@
 
 #define TEST_NVS_FLASH_AREA		storage_partition
 #define TEST_NVS_FLASH_AREA_OFFSET	FIXED_PARTITION_OFFSET(TEST_NVS_FLASH_AREA)
+#define TEST_NVS_FLASH_AREA_SIZE	FIXED_PARTITION_SIZE(TEST_NVS_FLASH_AREA)
 #define TEST_NVS_FLASH_AREA_ID		FIXED_PARTITION_ID(TEST_NVS_FLASH_AREA)
 #define TEST_NVS_FLASH_AREA_DEV \
 	DEVICE_DT_GET(DT_MTD_FROM_FIXED_PARTITION(DT_NODELABEL(TEST_NVS_FLASH_AREA)))
@@ -958,3 +959,336 @@ ZTEST_F(nvs, test_nvs_cache_hash_quality)
 
 #endif
 }
+
+#ifdef CONFIG_NVS_INCREMENTAL_GC
+/*
+ * Write max_writes entries, collecting garbage with nvs_gc_step() after each
+ * write if step is set, and report the worst-case nvs_write() latency as well
+ * as the number of erases done by nvs_write().
+ */
+static void gc_write_latency(struct nvs_fixture *fixture, uint16_t max_writes, bool step,
+			     uint32_t *max_us, uint32_t *max_erases)
+{
+	uint32_t *flash_erase_stat;
+	uint32_t erases, start, cycles, max_cycles = 0U;
+	const uint16_t max_id = 10;
+	uint8_t buf[32];
+	ssize_t len;
+	int err;
+
+	stats_walk(fixture->sim_stats, flash_sim_erase_calls_find, &flash_erase_stat);
+
+	*max_erases = 0U;
+
+	for (uint16_t i = 0; i < max_writes; i++) {
+		uint8_t id = (i % max_id);
+		uint8_t id_data = id + max_id * (i / max_id);
+
+		memset(buf, id_data, sizeof(buf));
+
+		erases = *flash_erase_stat;
+		start = k_cycle_get_32();
+
+		len = nvs_write(&fixture->fs, id, buf, sizeof(buf));
+
+		cycles = k_cycle_get_32() - start;
+		zassert_true(len == sizeof(buf), "nvs_write failed: %d", len);
+
+		max_cycles = MAX(max_cycles, cycles);
+		*max_erases = MAX(*max_erases, *flash_erase_stat - erases);
+
+		while (step) {
+			err = nvs_gc_step(&fixture->fs, 1);
+			zassert_true(err >= 0, "nvs_gc_step call failure: %d", err);
+			if (err == 0) {
+				break;
+			}
+		}
+	}
+
+	check_content(max_id, &fixture->fs);
+
+	*max_us = k_cyc_to_us_ceil32(max_cycles);
+}
+#endif
+
+/*
+ * Test that with garbage collection steps between writes, the whole file
+ * system keeps being collected without nvs_write() erasing any sector.
+ */
+ZTEST_F(nvs, test_nvs_gc_step)
+{
+#ifdef CONFIG_NVS_INCREMENTAL_GC
+	int err;
+	uint32_t max_us, max_erases;
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	/* Go around the file system twice */
+	gc_write_latency(fixture, 300, true, &max_us, &max_erases);
+	zassert_equal(max_erases, 0, "nvs_write erased a sector");
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	check_content(10, &fixture->fs);
+
+	/* Less than 4 sectors is not supported */
+	err = nvs_clear(&fixture->fs);
+	zassert_true(err == 0, "nvs_clear call failure: %d", err);
+
+	fixture->fs.sector_count = 3;
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	err = nvs_gc_step(&fixture->fs, 1);
+	zassert_equal(err, 0, "nvs_gc_step unexpected result: %d", err);
+#endif
+}
+
+/*
+ * Compare the worst-case nvs_write() latency when all the garbage collection
+ * is done by nvs_write() and when it is done by nvs_gc_step().
+ */
+ZTEST_F(nvs, test_nvs_gc_step_write_latency)
+{
+#ifdef CONFIG_NVS_INCREMENTAL_GC
+	int err;
+	uint32_t max_us, max_erases, max_us_step, max_erases_step;
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	gc_write_latency(fixture, 300, false, &max_us, &max_erases);
+
+	err = nvs_clear(&fixture->fs);
+	zassert_true(err == 0, "nvs_clear call failure: %d", err);
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	gc_write_latency(fixture, 300, true, &max_us_step, &max_erases_step);
+
+	TC_PRINT("Worst-case nvs_write: %u us, %u erases\n", max_us, max_erases);
+	TC_PRINT("Worst-case nvs_write with nvs_gc_step: %u us, %u erases\n", max_us_step,
+		 max_erases_step);
+
+	zassert_equal(max_erases, 1, "nvs_write did not collect garbage");
+	zassert_equal(max_erases_step, 0, "nvs_write erased a sector");
+
+#ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
+	/* The erase, which is the longest operation by far, sets the worst case */
+	zassert_true(max_us >= CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US,
+		     "nvs_write faster than an erase: %u us", max_us);
+	zassert_true(max_us_step < CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US,
+		     "nvs_write with nvs_gc_step not faster than an erase: %u us", max_us_step);
+#endif
+#endif
+}
+
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+static const struct nvs_lookup_index_entry *find_index_entry(uint16_t id, struct nvs_fs *fs)
+{
+	for (size_t i = 0; i < CONFIG_NVS_LOOKUP_INDEX_SIZE; i++) {
+		if (fs->lookup_index[i].id == id) {
+			return &fs->lookup_index[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Number of ids of uint16_t data that can be written without garbage collection */
+static uint32_t index_test_max_ids(struct nvs_fs *fs)
+{
+	const size_t id_size = sizeof(struct nvs_ate) + sizeof(uint32_t) + NVS_DATA_CRC_SIZE;
+
+	return (fs->sector_count - 2U) *
+	       ((fs->sector_size - 3U * sizeof(struct nvs_ate)) / id_size);
+}
+#endif
+
+/*
+ * Test that NVS lookup index is properly rebuilt on nvs_mount(), and kept up
+ * to date by writes and deletes.
+ */
+ZTEST_F(nvs, test_nvs_index_init)
+{
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	const struct nvs_lookup_index_entry *entry;
+	uint32_t data_addr;
+	uint8_t data = 0;
+	int err;
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	zassert_equal(fixture->fs.lookup_index_count, 0, "uninitialized index");
+	zassert_true(fixture->fs.lookup_index_complete, "incomplete index");
+
+	data_addr = fixture->fs.data_wra;
+	err = nvs_write(&fixture->fs, 1, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+
+	entry = find_index_entry(1, &fixture->fs);
+	zassert_not_null(entry, "index not updated after write");
+	zassert_equal(entry->addr, data_addr, "invalid index entry after write");
+	zassert_equal(entry->len, sizeof(data) + NVS_DATA_CRC_SIZE,
+		      "invalid index entry after write");
+
+	memset(fixture->fs.lookup_index, 0xAA, sizeof(fixture->fs.lookup_index));
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	zassert_equal(fixture->fs.lookup_index_count, 1, "uninitialized index after restart");
+	entry = find_index_entry(1, &fixture->fs);
+	zassert_not_null(entry, "index not rebuilt after restart");
+	zassert_equal(entry->addr, data_addr, "invalid index entry after restart");
+
+	err = nvs_delete(&fixture->fs, 1);
+	zassert_true(err == 0, "nvs_delete call failure: %d", err);
+
+	entry = find_index_entry(1, &fixture->fs);
+	zassert_not_null(entry, "deleted id removed from index");
+	zassert_equal(entry->len, 0, "index not updated after delete");
+
+	err = nvs_read(&fixture->fs, 1, &data, sizeof(data));
+	zassert_equal(err, -ENOENT, "nvs_read unexpected failure: %d", err);
+#endif
+}
+
+/*
+ * Test that the ids that don't fit in the NVS lookup index can still be
+ * written, read and deleted, and that the index survives garbage collection.
+ */
+ZTEST_F(nvs, test_nvs_index_overflow)
+{
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	const uint16_t max_id = NVS_LOOKUP_INDEX_MAX_COUNT + 8;
+	uint16_t id, data;
+	int err;
+
+	fixture->fs.sector_count = TEST_NVS_FLASH_AREA_SIZE / fixture->fs.sector_size;
+	zassert_true(index_test_max_ids(&fixture->fs) > max_id, "storage too small");
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	for (id = 0; id < max_id; id++) {
+		data = id;
+		err = nvs_write(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	zassert_false(fixture->fs.lookup_index_complete, "index not full");
+
+	for (id = max_id - 16; id < max_id; id++) {
+		err = nvs_delete(&fixture->fs, id);
+		zassert_true(err == 0, "nvs_delete call failure: %d", err);
+	}
+
+	/* Go around the file system to garbage collect every sector */
+	for (uint32_t i = 0; i < fixture->fs.sector_count * fixture->fs.sector_size / 8; i++) {
+		data = i;
+		err = nvs_write(&fixture->fs, 0, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+	data = 0;
+	err = nvs_write(&fixture->fs, 0, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+
+	for (int mount = 0; mount < 2; mount++) {
+		for (id = 0; id < max_id; id++) {
+			err = nvs_read(&fixture->fs, id, &data, sizeof(data));
+			if (id < max_id - 16) {
+				zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+				zassert_equal(data, id, "incorrect data read");
+			} else {
+				zassert_equal(err, -ENOENT, "nvs_read unexpected failure: %d", err);
+			}
+		}
+
+		err = nvs_mount(&fixture->fs);
+		zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	}
+#endif
+}
+
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+/* Average nvs_read() latency, in ns, of a sample of the ids 0 to max_id - 1 */
+static uint32_t index_read_latency(struct nvs_fs *fs, uint16_t max_id)
+{
+	const uint16_t reads = 100;
+	uint32_t start, cycles = 0U;
+	uint16_t id, data;
+	int err;
+
+	for (uint16_t i = 0; i < reads; i++) {
+		id = (i * 7919U) % max_id;
+
+		start = k_cycle_get_32();
+		err = nvs_read(fs, id, &data, sizeof(data));
+		cycles += k_cycle_get_32() - start;
+
+		zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+		zassert_equal(data, id, "incorrect data read");
+	}
+
+	return (uint32_t)(k_cyc_to_ns_ceil64(cycles) / reads);
+}
+#endif
+
+/*
+ * Report the nvs_read() latency with and without the NVS lookup index for
+ * increasing numbers of ids, along with the memory the index needs for them.
+ */
+ZTEST_F(nvs, test_nvs_index_read_latency)
+{
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	static const uint16_t num_ids[] = {100, 250, 500, 1000, 2000, 4000};
+	uint32_t index_ns, flash_ns;
+	uint16_t max_id, data;
+	int err;
+
+	fixture->fs.sector_count = TEST_NVS_FLASH_AREA_SIZE / fixture->fs.sector_size;
+
+	for (size_t i = 0; i < ARRAY_SIZE(num_ids); i++) {
+		max_id = num_ids[i];
+
+		if ((max_id > NVS_LOOKUP_INDEX_MAX_COUNT) ||
+		    (max_id > index_test_max_ids(&fixture->fs))) {
+			TC_PRINT("%u ids: don't fit\n", max_id);
+			continue;
+		}
+
+		err = nvs_mount(&fixture->fs);
+		zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+		for (uint16_t id = 0; id < max_id; id++) {
+			data = id;
+			err = nvs_write(&fixture->fs, id, &data, sizeof(data));
+			zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+		}
+
+		index_ns = index_read_latency(&fixture->fs, max_id);
+
+		/* Search all the ids in flash */
+		memset(fixture->fs.lookup_index, 0xff, sizeof(fixture->fs.lookup_index));
+		fixture->fs.lookup_index_complete = false;
+
+		flash_ns = index_read_latency(&fixture->fs, max_id);
+
+		TC_PRINT("%u ids: %u bytes of index, nvs_read %u ns, %u ns without index\n",
+			 max_id,
+			 (uint32_t)(DIV_ROUND_UP(max_id * 8U, 7U) *
+				    sizeof(struct nvs_lookup_index_entry)),
+			 index_ns, flash_ns);
+
+		err = nvs_clear(&fixture->fs);
+		zassert_true(err == 0, "nvs_clear call failure: %d", err);
+	}
+#endif
+}
@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/buf.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/mgmt/mcumgr/mgmt/mgmt.h>
+#include <zephyr/mgmt/mcumgr/mgmt/callbacks.h>
+#include <zephyr/mgmt/mcumgr/smp/smp.h>
+#include <zephyr/mgmt/mcumgr/smp/smp_client.h>
+#include <zephyr/mgmt/mcumgr/transport/smp.h>
+#include <zephyr/mgmt/mcumgr/grp/img_mgmt/img_mgmt.h>
+#include <zephyr/mgmt/mcumgr/grp/img_mgmt/img_mgmt_client.h>
+#include <zephyr/mgmt/mcumgr/grp/img_mgmt/img_mgmt_callbacks.h>
+#include <bootutil/image.h>
+#include <smp_internal.h>
+
+#define TEST_IMAGE_SIZE		(16 * 1024)
+#define TEST_SLOT_ID		FIXED_PARTITION_ID(slot1_partition)
+#define LOOPBACK_LATENCY_MS	10
+#define LOOPBACK_PKTS		CONFIG_MCUMGR_TRANSPORT_NETBUF_COUNT
+#define CHUNKS_MAX		128
+
+static uint8_t test_image[TEST_IMAGE_SIZE] __aligned(4);
+static uint8_t read_buf[256];
+
+static struct smp_client_object smp_client;
+static struct img_mgmt_client img_client;
+
+/*
+ * Loopback transport, used by both the client and the server, delivering each packet
+ * LOOPBACK_LATENCY_MS after it has been sent. When reordering is enabled, every other
+ * packet is delayed further so that it is received after the one sent next.
+ */
+static struct smp_transport loopback_transport;
+static struct smp_client_transport_entry loopback_client_transport;
+
+static struct loopback_pkt {
+	struct net_buf *nb;
+	int64_t due;
+} loopback_pkts[LOOPBACK_PKTS];
+
+static struct k_spinlock loopback_lock;
+static uint32_t loopback_count;
+static bool loopback_reorder;
+
+static void loopback_deliver(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(loopback_work, loopback_deliver);
+
+static void loopback_deliver(struct k_work *work)
+{
+	struct net_buf *nb;
+	k_spinlock_key_t key;
+	int64_t remaining;
+	int next;
+
+	ARG_UNUSED(work);
+
+	while (true) {
+		key = k_spin_lock(&loopback_lock);
+		next = -1;
+
+		for (int i = 0; i < LOOPBACK_PKTS; i++) {
+			if (loopback_pkts[i].nb != NULL &&
+			    (next < 0 || loopback_pkts[i].due < loopback_pkts[next].due)) {
+				next = i;
+			}
+		}
+
+		if (next < 0) {
+			k_spin_unlock(&loopback_lock, key);
+			return;
+		}
+
+		remaining = loopback_pkts[next].due - k_uptime_get();
+
+		if (remaining > 0) {
+			k_spin_unlock(&loopback_lock, key);
+			(void)k_work_reschedule(&loopback_work, K_MSEC(remaining));
+			return;
+		}
+
+		nb = loopback_pkts[next].nb;
+		loopback_pkts[next].nb = NULL;
+		k_spin_unlock(&loopback_lock, key);
+
+		smp_rx_req(&loopback_transport, nb);
+	}
+}
+
+static int loopback_output(struct net_buf *nb)
+{
+	struct net_buf *copy;
+	k_spinlock_key_t key;
+	int64_t due;
+	int i;
+
+	/* The client keeps its request buffer, in case it has to be sent again */
+	copy = smp_packet_alloc();
+	zassert_not_null(copy, "out of SMP buffers");
+	net_buf_add_mem(copy, nb->data, nb->len);
+	smp_packet_free(nb);
+
+	due = k_uptime_get() + LOOPBACK_LATENCY_MS;
+
+	key = k_spin_lock(&loopback_lock);
+
+	if (loopback_reorder && (loopback_count % 2) == 0) {
+		due += LOOPBACK_LATENCY_MS;
+	}
+
+	loopback_count++;
+
+	for (i = 0; i < LOOPBACK_PKTS; i++) {
+		if (loopback_pkts[i].nb == NULL) {
+			loopback_pkts[i].nb = copy;
+			loopback_pkts[i].due = due;
+			break;
+		}
+	}
+
+	k_spin_unlock(&loopback_lock, key);
+
+	zassert_true(i < LOOPBACK_PKTS, "too many packets in flight");
+	(void)k_work_schedule(&loopback_work, K_MSEC(LOOPBACK_LATENCY_MS));
+
+	return 0;
+}
+
+/*
+ * Offsets of the chunks passed to the upload check hook, and number of write complete
+ * notifications, for the last upload.
+ */
+static size_t checked_offs[CHUNKS_MAX];
+static uint32_t checked_count;
+static uint32_t checked_ahead_count;
+static uint32_t write_complete_count;
+static uint32_t pending_count;
+
+static enum mgmt_cb_return upload_hook(uint32_t event, enum mgmt_cb_return prev_status,
+				       int32_t *rc, uint16_t *group, bool *abort_more,
+				       void *data, size_t data_size)
+{
+	struct img_mgmt_upload_check *check;
+	uint32_t i;
+
+	ARG_UNUSED(prev_status);
+	ARG_UNUSED(rc);
+	ARG_UNUSED(group);
+	ARG_UNUSED(abort_more);
+
+	switch (event) {
+	case MGMT_EVT_OP_IMG_MGMT_DFU_CHUNK:
+		zassert_equal(data_size, sizeof(*check), "unexpected check size");
+		check = data;
+
+		if (check->action->ahead) {
+			checked_ahead_count++;
+		}
+
+		/* Chunks sent again are checked again */
+		for (i = 0; i < checked_count; i++) {
+			if (checked_offs[i] == check->req->off) {
+				break;
+			}
+		}
+
+		if (i == checked_count && checked_count < CHUNKS_MAX) {
+			checked_offs[checked_count++] = check->req->off;
+		}
+		break;
+
+	case MGMT_EVT_OP_IMG_MGMT_DFU_CHUNK_WRITE_COMPLETE:
+		write_complete_count++;
+		break;
+
+	case MGMT_EVT_OP_IMG_MGMT_DFU_PENDING:
+		pending_count++;
+		break;
+
+	default:
+		break;
+	}
+
+	return MGMT_CB_OK;
+}
+
+static struct mgmt_callback upload_callback = {
+	.callback = upload_hook,
+	.event_id = MGMT_EVT_OP_IMG_MGMT_ALL,
+};
+
+static uint16_t loopback_get_mtu(const struct net_buf *nb)
+{
+	ARG_UNUSED(nb);
+
+	return CONFIG_MCUMGR_TRANSPORT_NETBUF_SIZE;
+}
+
+static void slot_erase(size_t size)
+{
+	const struct flash_area *fa;
+
+	zassert_ok(flash_area_open(TEST_SLOT_ID, &fa), "can't open slot");
+	zassert_ok(flash_area_flatten(fa, 0, size), "can't erase slot");
+	flash_area_close(fa);
+}
+
+static void slot_verify(void)
+{
+	const struct flash_area *fa;
+
+	zassert_ok(flash_area_open(TEST_SLOT_ID, &fa), "can't open slot");
+
+	for (size_t off = 0; off < TEST_IMAGE_SIZE; off += sizeof(read_buf)) {
+		zassert_ok(flash_area_read(fa, off, read_buf, sizeof(read_buf)),
+			   "can't read slot");
+		zassert_mem_equal(read_buf, &test_image[off], sizeof(read_buf),
+				  "image mismatch at offset %zu", off);
+	}
+
+	flash_area_close(fa);
+}
+
+static int64_t upload(unsigned int window)
+{
+	struct mcumgr_image_upload res;
+	int64_t elapsed;
+	int rc;
+
+	/* Erase the image area beforehand, so that the server does not do it */
+	slot_erase(TEST_IMAGE_SIZE);
+
+	checked_count = 0;
+	checked_ahead_count = 0;
+	write_complete_count = 0;
+	pending_count = 0;
+
+	rc = img_mgmt_client_upload_init(&img_client, TEST_IMAGE_SIZE, 0, NULL);
+	zassert_equal(rc, MGMT_ERR_EOK, "upload init failed: %d", rc);
+	rc = img_mgmt_client_upload_window_set(&img_client, window);
+	zassert_equal(rc, 0, "can't set window %u: %d", window, rc);
+
+	elapsed = k_uptime_get();
+	rc = img_mgmt_client_upload(&img_client, test_image, TEST_IMAGE_SIZE, &res);
+	elapsed = k_uptime_delta(&elapsed);
+
+	zassert_equal(rc, MGMT_ERR_EOK, "upload failed: %d", rc);
+	zassert_equal(res.status, MGMT_ERR_EOK, "upload status: %d", res.status);
+	zassert_equal(res.image_upload_offset, TEST_IMAGE_SIZE, "upload offset: %zu",
+		      res.image_upload_offset);
+
+	slot_verify();
+
+	/* Each chunk is checked when received, and notified once written */
+	zassert_true(checked_count < CHUNKS_MAX, "too many chunks");
+	zassert_equal(pending_count, 1, "upload not notified as pending");
+	zassert_equal(write_complete_count + pending_count, checked_count,
+		      "%u chunks checked, %u notified as written", checked_count,
+		      write_complete_count + pending_count);
+
+	return elapsed;
+}
+
+/*
+ * Uploads the same image with an increasing number of requests in flight, and reports
+ * the throughput reached for each of them.
+ */
+ZTEST(img_mgmt_upload_window, test_upload_throughput)
+{
+	static const unsigned int windows[] = { 1, 2, 4, 8 };
+	int64_t elapsed[ARRAY_SIZE(windows)];
+
+	for (int i = 0; i < ARRAY_SIZE(windows); i++) {
+		elapsed[i] = upload(windows[i]);
+
+		TC_PRINT("window %u: %u bytes in %u ms, %u B/s\n", windows[i],
+			 TEST_IMAGE_SIZE, (uint32_t)elapsed[i],
+			 (uint32_t)((TEST_IMAGE_SIZE * 1000LL) / MAX(elapsed[i], 1)));
+	}
+
+	zassert_true(elapsed[ARRAY_SIZE(windows) - 1] < elapsed[0],
+		     "pipelined upload is not faster than stop-and-wait");
+}
+
+/*
+ * Uploads an image with requests received out of order, which have to be held by the
+ * server until the data before them is received.
+ */
+ZTEST(img_mgmt_upload_window, test_upload_reordered)
+{
+	loopback_reorder = true;
+	(void)upload(4);
+	loopback_reorder = false;
+
+	zassert_true(checked_ahead_count > 0, "no chunk held in the window");
+}
+
+static void *setup_upload_window(void)
+{
+	struct image_header *hdr = (struct image_header *)test_image;
+	int rc;
+
+	for (size_t i = 0; i < sizeof(test_image); i++) {
+		test_image[i] = (uint8_t)(i ^ (i >> 8));
+	}
+
+	memset(hdr, 0, sizeof(*hdr));
+	hdr->ih_magic = IMAGE_MAGIC;
+	hdr->ih_hdr_size = sizeof(*hdr);
+	hdr->ih_img_size = TEST_IMAGE_SIZE - sizeof(*hdr);
+
+	loopback_transport.functions.output = loopback_output;
+	loopback_transport.functions.get_mtu = loopback_get_mtu;
+	rc = smp_transport_init(&loopback_transport);
+	zassert_equal(rc, 0, "can't init loopback transport: %d", rc);
+
+	loopback_client_transport.smpt = &loopback_transport;
+	loopback_client_transport.smpt_type = SMP_USER_DEFINED_TRANSPORT;
+	smp_client_transport_register(&loopback_client_transport);
+
+	rc = smp_client_object_init(&smp_client, SMP_USER_DEFINED_TRANSPORT);
+	zassert_equal(rc, 0, "can't init SMP client: %d", rc);
+	img_mgmt_client_init(&img_client, &smp_client, 0, NULL);
+
+	mgmt_callback_register(&upload_callback);
+
+	/* Start from an empty slot, the uploads then only erase what they write */
+	slot_erase(FIXED_PARTITION_SIZE(slot1_partition));
+
+	return NULL;
+}
+
+static void cleanup_upload_window(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	loopback_reorder = false;
+}
+
+ZTEST_SUITE(img_mgmt_upload_window, NULL, setup_upload_window, NULL, cleanup_upload_window,
+	    NULL);
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+
+#include "settings_test.h"
+#include "settings/settings_fcb.h"
+
+#define INDEX_TEST_KEYS   48
+#define INDEX_TEST_ROUNDS 120
+
+static uint32_t index_val[INDEX_TEST_KEYS];
+static bool index_valid[INDEX_TEST_KEYS];
+static uint32_t index_loaded[INDEX_TEST_KEYS];
+static bool index_found[INDEX_TEST_KEYS];
+
+static int c5_handle_set(const char *name, size_t len, settings_read_cb read_cb,
+			 void *cb_arg)
+{
+	unsigned long key = strtoul(name, NULL, 10);
+	int rc;
+
+	zassert_true(key < INDEX_TEST_KEYS, "unexpected key %s", name);
+
+	if (len == 0) {
+		return 0;
+	}
+
+	rc = read_cb(cb_arg, &index_loaded[key], sizeof(index_loaded[key]));
+	zassert_equal(rc, sizeof(index_loaded[key]), "can't read key %s", name);
+	index_found[key] = true;
+
+	return 0;
+}
+
+static struct settings_handler c5_test_handler = {
+	.name = "5",
+	.h_set = c5_handle_set,
+};
+
+static void index_save(int key, bool delete)
+{
+	char name[SETTINGS_MAX_NAME_LEN];
+	int rc;
+
+	snprintf(name, sizeof(name), "5/%d", key);
+
+	if (delete) {
+		rc = settings_delete(name);
+		index_valid[key] = false;
+	} else {
+		index_val[key]++;
+		rc = settings_save_one(name, &index_val[key], sizeof(index_val[key]));
+		index_valid[key] = true;
+	}
+
+	zassert_equal(rc, 0, "can't save %s", name);
+}
+
+static void index_load(void)
+{
+	int rc;
+
+	memset(index_found, 0, sizeof(index_found));
+
+	rc = settings_load_subtree("5");
+	zassert_equal(rc, 0, "can't load settings");
+
+	for (int i = 0; i < INDEX_TEST_KEYS; i++) {
+		zassert_equal(index_found[i], index_valid[i], "key 5/%d %s", i,
+			      index_valid[i] ? "not loaded" : "loaded after delete");
+		if (index_valid[i]) {
+			zassert_equal(index_loaded[i], index_val[i], "key 5/%d wrong value",
+				      i);
+		}
+	}
+}
+
+/*
+ * Keeps a set of settings updated and deleted across several rotations of
+ * the FCB, checking that the most recent value of each one is loaded.
+ */
+ZTEST(settings_config_fcb, test_config_fcb_index)
+{
+	struct settings_fcb cf;
+	uint32_t seed = 1;
+	int rc;
+
+	config_wipe_srcs();
+	config_wipe_fcb(fcb_sectors, ARRAY_SIZE(fcb_sectors));
+
+	cf.cf_fcb.f_magic = CONFIG_SETTINGS_FCB_MAGIC;
+	cf.cf_fcb.f_sectors = fcb_sectors;
+	cf.cf_fcb.f_sector_cnt = ARRAY_SIZE(fcb_sectors);
+
+	rc = settings_fcb_src(&cf);
+	zassert_true(rc == 0, "can't register FCB as configuration source");
+	settings_mount_fcb_backend(&cf);
+
+	rc = settings_fcb_dst(&cf);
+	zassert_true(rc == 0,
+		     "can't register FCB as configuration destination");
+
+	rc = settings_register(&c5_test_handler);
+	zassert_true(rc == 0, "settings_register fail");
+
+	memset(index_val, 0, sizeof(index_val));
+	memset(index_valid, 0, sizeof(index_valid));
+
+	for (int i = 0; i < INDEX_TEST_KEYS * INDEX_TEST_ROUNDS; i++) {
+		seed = (seed * 1103515245U) + 12345U;
+		index_save((seed >> 8) % INDEX_TEST_KEYS, ((seed >> 20) % 8) == 0);
+	}
+
+	index_load();
+
+	/* Register again, as after a reset */
+	config_wipe_srcs();
+	rc = settings_fcb_src(&cf);
+	zassert_true(rc == 0, "can't register FCB as configuration source");
+	rc = settings_fcb_dst(&cf);
+	zassert_true(rc == 0,
+		     "can't register FCB as configuration destination");
+
+	index_load();
+
+	settings_unregister(&c5_test_handler);
+}
@@ -658,6 +658,286 @@ ZTEST(lib_stream_flash, test_stream_flash_progress_clear)
 #endif
 }
 
+#ifdef CONFIG_STREAM_FLASH_ASYNC
+#define ASYNC_BUF_CNT 2
+#define ASYNC_CHUNK_LEN 128
+
+static uint8_t async_buf[BUF_LEN * ASYNC_BUF_CNT];
+static size_t progress_cnt;
+static size_t progress_bytes;
+static int progress_rc;
+
+static void progress_callback(struct stream_flash_ctx *ctx, size_t bytes_written, int rc)
+{
+	progress_cnt++;
+	progress_bytes = bytes_written;
+	progress_rc = rc;
+}
+
+static void init_target_async(const struct device *dev)
+{
+	int rc;
+
+	init_target();
+
+	progress_cnt = 0;
+	progress_bytes = 0;
+	progress_rc = 0;
+
+	rc = stream_flash_init_async(&ctx, dev, async_buf, BUF_LEN, ASYNC_BUF_CNT, FLASH_BASE,
+				     0, NULL, progress_callback);
+	zassert_equal(rc, 0, "expected success");
+}
+
+ZTEST(lib_stream_flash, test_stream_flash_async_init)
+{
+	int rc;
+
+	rc = stream_flash_init_async(&ctx, fdev, async_buf, BUF_LEN, 1, FLASH_BASE, 0,
+				     NULL, NULL);
+	zassert_true(rc < 0, "expected failure with a single buffer");
+
+	rc = stream_flash_init_async(&ctx, fdev, async_buf, BUF_LEN,
+				     CONFIG_STREAM_FLASH_ASYNC_BUF_COUNT + 1, FLASH_BASE, 0,
+				     NULL, NULL);
+	zassert_true(rc < 0, "expected failure with too many buffers");
+
+	rc = stream_flash_init_async(&ctx, fdev, async_buf, 0x10000, ASYNC_BUF_CNT,
+				     FLASH_BASE, 0, NULL, NULL);
+	zassert_true(rc < 0, "expected failure with buffers larger than page");
+}
+
+ZTEST(lib_stream_flash, test_stream_flash_async_buffered_write)
+{
+	int rc;
+	size_t len = (page_size * (MAX_NUM_PAGES - 1)) + 128;
+
+	init_target_async(fdev);
+
+	for (size_t off = 0; off < len; off += ASYNC_CHUNK_LEN + 1) {
+		rc = stream_flash_buffered_write(&ctx, write_buf + off,
+						 MIN(ASYNC_CHUNK_LEN + 1, len - off), false);
+		zassert_equal(rc, 0, "expected success");
+	}
+
+	rc = stream_flash_buffered_write(&ctx, NULL, 0, true);
+	zassert_equal(rc, 0, "expected success");
+
+	zassert_equal(stream_flash_bytes_written(&ctx), len, "all bytes should be written");
+	zassert_equal(progress_cnt, DIV_ROUND_UP(len, BUF_LEN), "one progress per buffer");
+	zassert_equal(progress_bytes, len, "progress should report all bytes");
+	zassert_equal(progress_rc, 0, "progress should report success");
+
+	VERIFY_WRITTEN(0, len);
+
+	/* A flush without pending data is complete at once */
+	rc = stream_flash_buffered_write(&ctx, NULL, 0, true);
+	zassert_equal(rc, 0, "expected success");
+}
+
+ZTEST(lib_stream_flash, test_stream_flash_async_write_error)
+{
+	int rc;
+	struct device fake_dev = *fdev;
+	struct flash_driver_api fake_api = *(struct flash_driver_api *)fdev->api;
+
+	fake_api.write = bad_write;
+	fake_dev.api = &fake_api;
+
+	init_target_async(&fake_dev);
+
+	/* The failure is reported by this call or a later one */
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN, false);
+	zassert_true(rc == 0 || rc == -EINVAL, "unexpected error %d", rc);
+
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN, true);
+	zassert_equal(rc, -EINVAL, "expected failure from flash_write");
+	zassert_equal(k_work_busy_get(&ctx.async.work), 0,
+		      "work queue should be done with the stream");
+	zassert_equal(progress_cnt, 1, "following buffers should be dropped");
+	zassert_equal(progress_rc, -EINVAL, "progress should report failure");
+	zassert_equal(stream_flash_bytes_written(&ctx), 0, "no bytes should be written");
+
+	rc = stream_flash_buffered_write(&ctx, write_buf, 1, false);
+	zassert_equal(rc, -EINVAL, "expected failure to be kept");
+}
+
+ZTEST(lib_stream_flash, test_stream_flash_async_reinit)
+{
+	int rc;
+
+	init_target_async(fdev);
+
+	/* Leave buffers queued for write */
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN * ASYNC_BUF_CNT, false);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_init_async(&ctx, fdev, async_buf, BUF_LEN, ASYNC_BUF_CNT, FLASH_BASE,
+				     0, NULL, NULL);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(k_work_busy_get(&ctx.async.work), 0,
+		      "work queue should be done with the previous stream");
+	zassert_equal(stream_flash_bytes_written(&ctx), 0, "expected a new stream");
+
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN, true);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(stream_flash_bytes_written(&ctx), BUF_LEN, "all bytes should be written");
+
+	VERIFY_WRITTEN(0, BUF_LEN);
+}
+
+/* Write the stream as it would be received by a DFU transport, waiting for
+ * each chunk, and return the time it took.
+ */
+static uint32_t dfu_write_us(size_t len, k_timeout_t chunk_time)
+{
+	int64_t start = k_uptime_ticks();
+	int rc;
+
+	for (size_t off = 0; off < len; off += BUF_LEN) {
+		k_sleep(chunk_time);
+
+		rc = stream_flash_buffered_write(&ctx, write_buf + off, BUF_LEN, false);
+		zassert_equal(rc, 0, "expected success");
+	}
+
+	rc = stream_flash_buffered_write(&ctx, NULL, 0, true);
+	zassert_equal(rc, 0, "expected success");
+
+	VERIFY_WRITTEN(0, len);
+
+	return (uint32_t)k_ticks_to_us_floor64(k_uptime_ticks() - start);
+}
+
+#ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
+ZTEST(lib_stream_flash, test_stream_flash_async_throughput)
+{
+	size_t len = page_size * MAX_NUM_PAGES;
+	/* Receiving a chunk takes as long as writing it */
+	k_timeout_t chunk_time = K_USEC(CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US);
+	uint32_t sync_us;
+	uint32_t async_us;
+
+	init_target();
+	sync_us = dfu_write_us(len, chunk_time);
+
+	init_target_async(fdev);
+	async_us = dfu_write_us(len, chunk_time);
+
+	TC_PRINT("%zu bytes in %u byte chunks: sync %u us (%u kB/s), async %u us (%u kB/s)\n",
+		 len, BUF_LEN, sync_us, (uint32_t)((len * 1000U) / sync_us), async_us,
+		 (uint32_t)((len * 1000U) / async_us));
+
+	zassert_true(async_us < sync_us, "async writes should be faster");
+}
+#else
+ZTEST(lib_stream_flash, test_stream_flash_async_throughput)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING */
+#endif /* CONFIG_STREAM_FLASH_ASYNC */
+
+#ifdef CONFIG_STREAM_FLASH_HASH
+static void verify_hash(size_t len)
+{
+	uint8_t expected[STREAM_FLASH_HASH_LEN];
+	uint8_t hash[STREAM_FLASH_HASH_LEN];
+	int rc;
+
+	rc = mbedtls_sha256(write_buf, len, expected, false);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_hash_get(&ctx, hash);
+	zassert_equal(rc, 0, "expected success");
+	zassert_mem_equal(hash, expected, sizeof(hash), "hash of %zu bytes should match", len);
+}
+
+ZTEST(lib_stream_flash, test_stream_flash_hash)
+{
+	int rc;
+	size_t len = page_size + 100;
+
+	init_target();
+
+	rc = stream_flash_hash_get(NULL, generic_buf);
+	zassert_equal(rc, -EFAULT, "should fail as ctx is NULL");
+	rc = stream_flash_hash_get(&ctx, NULL);
+	zassert_equal(rc, -EFAULT, "should fail as hash is NULL");
+
+	verify_hash(0);
+
+	for (size_t off = 0; off < len; off += 100) {
+		rc = stream_flash_buffered_write(&ctx, write_buf + off, MIN(100, len - off),
+						 false);
+		zassert_equal(rc, 0, "expected success");
+	}
+
+	/* Buffered data is not hashed until it is written */
+	verify_hash(stream_flash_bytes_written(&ctx));
+
+	rc = stream_flash_buffered_write(&ctx, NULL, 0, true);
+	zassert_equal(rc, 0, "expected success");
+
+	verify_hash(len);
+}
+
+ZTEST(lib_stream_flash, test_stream_flash_hash_reinit)
+{
+	int rc;
+
+	init_target();
+
+	/* The hash of the previous stream is released each time, not leaked */
+	for (int i = 0; i < 100; i++) {
+		rc = stream_flash_init(&ctx, fdev, generic_buf, BUF_LEN, FLASH_BASE, 0, NULL);
+		zassert_equal(rc, 0, "expected success");
+	}
+
+	verify_hash(0);
+
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN + 100, true);
+	zassert_equal(rc, 0, "expected success");
+
+	verify_hash(BUF_LEN + 100);
+}
+
+ZTEST(lib_stream_flash, test_stream_flash_hash_progress_resume)
+{
+	int rc;
+	size_t bytes_written;
+	size_t len = page_size * 2 + 100;
+
+	clear_all_progress();
+	init_target();
+
+	bytes_written = write_and_save_progress(BUF_LEN + 100, progress_key);
+
+	/* Resume as after a reset, without erasing what has been written */
+	rc = stream_flash_init(&ctx, fdev, generic_buf, BUF_LEN, FLASH_BASE, 0, NULL);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(load_progress(progress_key), bytes_written,
+		      "expected bytes_written to be loaded");
+	verify_hash(bytes_written);
+
+	rc = stream_flash_buffered_write(&ctx, write_buf + bytes_written, len - bytes_written,
+					 true);
+	zassert_equal(rc, 0, "expected success");
+
+	verify_hash(len);
+
+	/* Only the number of bytes written is stored, the data is hashed again */
+	rc = settings_save_one(progress_key, &len, sizeof(len));
+	zassert_equal(rc, 0, "expected success");
+
+	init_target();
+	zassert_equal(load_progress(progress_key), len, "expected bytes_written to be loaded");
+	verify_hash(len);
+
+	clear_all_progress();
+}
+#endif /* CONFIG_STREAM_FLASH_HASH */
+
 void lib_stream_flash_before(void *data)
 {
 	zassume_true(device_is_ready(fdev), "Device is not ready");